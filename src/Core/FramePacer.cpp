@@ -0,0 +1,198 @@
+#include "FramePacer.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <ostream>
+#include <thread>
+
+FrameTimeHistogram::FrameTimeHistogram(float bucketWidthMs, size_t bucketCount)
+    : m_bucketWidthMs(bucketWidthMs), m_buckets(bucketCount + 1, 0), m_count(0), m_sum(0.0), m_max(0.f)
+{
+}
+
+void FrameTimeHistogram::add(float valueMs)
+{
+    size_t index = static_cast<size_t>(std::max(0.f, valueMs) / m_bucketWidthMs);
+    index = std::min(index, m_buckets.size() - 1);
+    ++m_buckets[index];
+    ++m_count;
+    m_sum += valueMs;
+    m_max = std::max(m_max, valueMs);
+}
+
+void FrameTimeHistogram::reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0.0;
+    m_max = 0.f;
+}
+
+float FrameTimeHistogram::getMean() const
+{
+    return m_count > 0 ? static_cast<float>(m_sum / m_count) : 0.f;
+}
+
+float FrameTimeHistogram::getPercentile(float percentile) const
+{
+    if (m_count == 0)
+        return 0.f;
+
+    size_t target = static_cast<size_t>(std::ceil(percentile / 100.f * m_count));
+    size_t accumulated = 0;
+    for (size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        accumulated += m_buckets[i];
+        if (accumulated >= target)
+        {
+            // 溢出桶只能给出已知最大值
+            if (i + 1 == m_buckets.size())
+                return m_max;
+            return (i + 1) * m_bucketWidthMs; // 桶上界
+        }
+    }
+    return m_max;
+}
+
+FramePacer::FramePacer(sf::RenderWindow &window, float targetFps, FramePacingMode mode)
+    : m_windowRef(window),
+      m_mode(mode),
+      m_targetPeriod(Clock::duration::zero()),
+      m_hasLastPresent(false),
+      m_frameTimeHistogram(FRAME_TIME_HISTOGRAM_BUCKET_MS, FRAME_TIME_HISTOGRAM_BUCKETS),
+      m_jitterHistogram(JITTER_HISTOGRAM_BUCKET_MS, JITTER_HISTOGRAM_BUCKETS)
+{
+    setTargetFps(targetFps);
+    applyMode();
+}
+
+void FramePacer::setMode(FramePacingMode mode)
+{
+    if (m_mode != mode)
+    {
+        m_mode = mode;
+        applyMode();
+        resetStats();
+    }
+}
+
+void FramePacer::cycleMode()
+{
+    switch (m_mode)
+    {
+    case FramePacingMode::VSYNC:
+        setMode(FramePacingMode::PRECISE);
+        break;
+    case FramePacingMode::PRECISE:
+        setMode(FramePacingMode::UNCAPPED);
+        break;
+    case FramePacingMode::UNCAPPED:
+        setMode(FramePacingMode::VSYNC);
+        break;
+    }
+}
+
+void FramePacer::setTargetFps(float targetFps)
+{
+    if (targetFps <= 0.f)
+        targetFps = TARGET_FPS;
+    m_targetPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+    resetTimeline();
+}
+
+void FramePacer::applyMode()
+{
+    // SFML 自带的 setFramerateLimit 依赖粗粒度 sf::sleep, 这里统一关掉, 由本类负责
+    m_windowRef.setFramerateLimit(0);
+    m_windowRef.setVerticalSyncEnabled(m_mode == FramePacingMode::VSYNC);
+    resetTimeline();
+    std::cout << "FramePacer: Mode set to " << getModeName(m_mode) << std::endl;
+}
+
+void FramePacer::waitForNextFrame()
+{
+    if (m_mode != FramePacingMode::PRECISE)
+        return;
+
+    Clock::time_point now = Clock::now();
+    if (m_nextDeadline.time_since_epoch().count() == 0 || now - m_nextDeadline > m_targetPeriod)
+    {
+        // 第一帧或已经落后超过一帧: 以当前时刻重新对齐, 不追帧
+        m_nextDeadline = now + m_targetPeriod;
+    }
+
+    const Clock::duration spinThreshold = std::chrono::microseconds(FRAME_PACING_SPIN_THRESHOLD_US);
+    // 粗略休眠阶段: 每次最多睡 1ms, 留出自旋余量
+    while (m_nextDeadline - Clock::now() > spinThreshold)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // 精确自旋阶段
+    while (Clock::now() < m_nextDeadline)
+    {
+        std::this_thread::yield();
+    }
+    m_nextDeadline += m_targetPeriod;
+}
+
+void FramePacer::onFramePresented()
+{
+    Clock::time_point now = Clock::now();
+    if (m_hasLastPresent)
+    {
+        float intervalMs = std::chrono::duration<float, std::milli>(now - m_lastPresent).count();
+        float targetMs = std::chrono::duration<float, std::milli>(m_targetPeriod).count();
+        m_frameTimeHistogram.add(intervalMs);
+        if (m_mode != FramePacingMode::UNCAPPED)
+        {
+            m_jitterHistogram.add(std::fabs(intervalMs - targetMs));
+        }
+    }
+    m_lastPresent = now;
+    m_hasLastPresent = true;
+}
+
+void FramePacer::resetTimeline()
+{
+    m_nextDeadline = Clock::time_point();
+    m_hasLastPresent = false;
+}
+
+void FramePacer::resetStats()
+{
+    m_frameTimeHistogram.reset();
+    m_jitterHistogram.reset();
+}
+
+void FramePacer::writeStatsText(std::ostream &out) const
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(2);
+    out << std::fixed;
+    out << "Pacing: " << getModeName(m_mode)
+        << " | frame avg " << m_frameTimeHistogram.getMean() << "ms"
+        << " p99 " << m_frameTimeHistogram.getPercentile(99.f) << "ms"
+        << " max " << m_frameTimeHistogram.getMax() << "ms";
+    if (m_mode != FramePacingMode::UNCAPPED)
+    {
+        out << " | jitter avg " << m_jitterHistogram.getMean() << "ms"
+            << " p99 " << m_jitterHistogram.getPercentile(99.f) << "ms";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+const char *FramePacer::getModeName(FramePacingMode mode)
+{
+    switch (mode)
+    {
+    case FramePacingMode::VSYNC:
+        return "VSYNC";
+    case FramePacingMode::PRECISE:
+        return "PRECISE";
+    case FramePacingMode::UNCAPPED:
+        return "UNCAPPED";
+    }
+    return "UNKNOWN";
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 帧节奏模式
+enum class FramePacingMode
+{
+    VSYNC,    // 交给驱动垂直同步
+    PRECISE,  // 先粗略休眠, 最后一小段自旋等待到目标时刻
+    UNCAPPED  // 不限帧
+};
+
+// 固定桶宽的毫秒直方图, 用于统计帧间隔和抖动
+class FrameTimeHistogram
+{
+public:
+    FrameTimeHistogram(float bucketWidthMs, size_t bucketCount);
+
+    void add(float valueMs);
+    void reset();
+
+    size_t getCount() const { return m_count; }
+    float getMean() const;
+    float getMax() const { return m_max; }
+    float getPercentile(float percentile) const;
+    const std::vector<unsigned int> &getBuckets() const { return m_buckets; } // 最后一个桶为溢出桶
+    float getBucketWidth() const { return m_bucketWidthMs; }
+
+private:
+    float m_bucketWidthMs;
+    std::vector<unsigned int> m_buckets;
+    size_t m_count;
+    double m_sum;
+    float m_max;
+};
+
+class FramePacer
+{
+public:
+    FramePacer(sf::RenderWindow &window, float targetFps, FramePacingMode mode);
+
+    void setMode(FramePacingMode mode);
+    FramePacingMode getMode() const { return m_mode; }
+    void cycleMode();
+    void setTargetFps(float targetFps);
+
+    // 在 display() 之前调用: PRECISE 模式下等待到本帧的目标时刻
+    void waitForNextFrame();
+    // 在 display() 之后调用: 记录实际呈现间隔
+    void onFramePresented();
+    // 中断过 (如空闲模式) 后重新开始计时, 不把中断时长计入统计
+    void resetTimeline();
+    void resetStats();
+
+    const FrameTimeHistogram &getFrameTimeHistogram() const { return m_frameTimeHistogram; }
+    const FrameTimeHistogram &getJitterHistogram() const { return m_jitterHistogram; }
+    // 写进调用方的流, 不生成临时字符串; 浮点格式用完即恢复
+    void writeStatsText(std::ostream &out) const;
+    static const char *getModeName(FramePacingMode mode);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void applyMode();
+
+    sf::RenderWindow &m_windowRef;
+    FramePacingMode m_mode;
+    Clock::duration m_targetPeriod;
+    Clock::time_point m_nextDeadline;
+    Clock::time_point m_lastPresent;
+    bool m_hasLastPresent;
+
+    FrameTimeHistogram m_frameTimeHistogram;
+    FrameTimeHistogram m_jitterHistogram;
+};
@@ -1,20 +1,72 @@
 #include "Game.h"
 #include "States/MenuState.h"
+#include "States/SpectatorState.h"
+#include "States/GamePlayState.h"
 #include "../Utils/Constants.h"
+#include "../Utils/AllocationCounter.h"
+#include <algorithm>
 #include <iostream>
 
-Game::Game()
+Game::Game(const BoardConfig &boardConfig, const LockstepConfig &lockstepConfig, const SpectatorConfig &spectatorConfig,
+           unsigned short metricsPort, const SimulationConfig &simulationConfig)
     : m_window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT),
                WINDOW_TITLE,
                sf::Style::Default),
       m_resourceManager(),
+      m_globalResources(m_resourceManager, "Game"),
       m_soundManager(),
-      m_stateManager(this)
+      m_stateManager(this),
+      m_framePacer(m_window, TARGET_FPS, FramePacingMode::PRECISE),
+      m_boardConfig(boardConfig),
+      m_lockstepConfig(lockstepConfig),
+      m_spectatorConfig(spectatorConfig),
+      m_simulationConfig(simulationConfig),
+      m_loopBusyTime(sf::Time::Zero),
+      m_loopFramesRendered(0),
+      m_loopUpdates(0),
+      m_loopAllocations(0),
+      m_loopMaxFrameAllocations(0),
+      m_frameTimeMetric(nullptr),
+      m_frameAllocationsMetric(nullptr),
+      m_framesMetric(nullptr),
+      m_allocationsMetric(nullptr),
+      m_allocatedBytesMetric(nullptr),
+      m_lastAllocationCount(AllocationCounter::getTotalAllocations()),
+      m_lastAllocatedBytes(AllocationCounter::getTotalBytes()),
+      m_lastFrameAllocations(0),
+      m_exitCode(0)
 {
-    m_window.setFramerateLimit(static_cast<unsigned int>(TARGET_FPS));
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        m_lastTagAllocations[tag] = AllocationCounter::getAllocations(static_cast<AllocationTag>(tag));
+    }
+    m_frameTagAllocations.fill(0);
+    m_loopTagAllocations.fill(0);
     std::cout << "Game object operated!" << std::endl;
+    registerMetrics();
+    if (metricsPort != 0)
+    {
+        m_metricsServer = std::make_unique<MetricsServer>(m_metrics, metricsPort);
+        if (!m_metricsServer->start())
+        {
+            m_metricsServer.reset();
+        }
+    }
     loadGlobalResources();
-    m_stateManager.pushState(std::make_unique<MenuState>(&m_stateManager));
+    if (m_spectatorConfig.isViewing())
+    {
+        // 观众模式: 不进菜单, 直接显示广播画面
+        m_stateManager.pushState(std::make_unique<SpectatorState>(&m_stateManager));
+    }
+    else if (m_simulationConfig.skipsMenu())
+    {
+        // 浸泡测试 / 确定性校验: 不进菜单, 直接开局
+        m_stateManager.pushState(std::make_unique<GamePlayState>(&m_stateManager));
+    }
+    else
+    {
+        m_stateManager.pushState(std::make_unique<MenuState>(&m_stateManager));
+    }
     if (m_stateManager.isEmpty())
     {
         std::cerr << "严重错误:没有初始状态被推入 StateManager!" << std::endl;
@@ -27,58 +79,39 @@ void Game::loadGlobalResources()
 {
     std::cout << "Game:loading whole resource..." << std::endl;
 
-    if (!m_resourceManager.hasFont(FONT_ID_PRIMARY))
+    // 两个字体键指向同一个文件时, 资源管理器按内容去重, 只解析一次
+    if (!m_globalResources.acquireFont(FONT_ID_PRIMARY, FONT_PATH_ARIAL))
     {
-        if (!m_resourceManager.loadFont(FONT_ID_PRIMARY, FONT_PATH_ARIAL))
-        {
-            if (!m_resourceManager.loadFont(FONT_ID_PRIMARY, FONT_PATH_ARIAL))
-            {
-                std::cerr << "Game:严重 - 全局主要字体加载失败。" << std::endl;
-            }
-        }
+        std::cerr << "Game:严重 - 全局主要字体加载失败。" << std::endl;
     }
-    if (!m_resourceManager.hasFont(FONT_ID_SECONDARY))
+    if (!m_globalResources.acquireFont(FONT_ID_SECONDARY, FONT_PATH_ARIAL))
     {
-        if (!m_resourceManager.loadFont(FONT_ID_SECONDARY, FONT_PATH_ARIAL))
-        {
-            std::cerr << "Game:全局次要字体加载失败。某些UI可能会使用主要字体作为备用。" << std::endl;
-        }
+        std::cerr << "Game:全局次要字体加载失败。某些UI可能会使用主要字体作为备用。" << std::endl;
     }
 
-    // 预加载种子包
+    // 预加载种子包 (图标与关卡内的植物纹理是同一文件, 共享一张纹理)
     std::cout << "Game: Pre-loading seed packet icons and shovel..." << std::endl;
-    if (!m_resourceManager.hasTexture(SUNFLOWER_ICON_TEXTURE_KEY))
-    {
-        if (!m_resourceManager.loadTexture(SUNFLOWER_ICON_TEXTURE_KEY, "../../assets/images/sunflower.png"))
-            std::cerr << "Game: Failed to load " << SUNFLOWER_ICON_TEXTURE_KEY << std::endl;
-    }
-    if (!m_resourceManager.hasTexture(PEASHOOTER_ICON_TEXTURE_KEY))
+    const struct
     {
-        if (!m_resourceManager.loadTexture(PEASHOOTER_ICON_TEXTURE_KEY, "../../assets/images/peashooter.png"))
-            std::cerr << "Game: Failed to load " << PEASHOOTER_ICON_TEXTURE_KEY << std::endl;
-    }
-    if (!m_resourceManager.hasTexture(WALLNUT_ICON_TEXTURE_KEY))
-    {
-        if (!m_resourceManager.loadTexture(WALLNUT_ICON_TEXTURE_KEY, "../../assets/images/wallnut.png"))
-            std::cerr << "Game: Failed to load " << WALLNUT_ICON_TEXTURE_KEY << std::endl;
-    }
-    if (!m_resourceManager.hasTexture(ICE_PEASHOOTER_ICON_TEXTURE_KEY))
+        ResourceId id;
+        const char *path;
+    } globalTextures[] = {
+        {SUNFLOWER_ICON_TEXTURE_KEY, "../../assets/images/sunflower.png"},
+        {PEASHOOTER_ICON_TEXTURE_KEY, "../../assets/images/peashooter.png"},
+        {WALLNUT_ICON_TEXTURE_KEY, "../../assets/images/wallnut.png"},
+        {ICE_PEASHOOTER_ICON_TEXTURE_KEY, "../../assets/images/ice_peashooter.png"},
+        {SHOVEL_TEXTURE_KEY, "../../assets/images/shovel.png"},
+        // 光标暂时与图标同一张图
+        {SHOVEL_CURSOR_TEXTURE_KEY, "../../assets/images/shovel.png"},
+    };
+    for (const auto &texture : globalTextures)
     {
-        if (!m_resourceManager.loadTexture(ICE_PEASHOOTER_ICON_TEXTURE_KEY, "../../assets/images/ice_peashooter.png"))
-            std::cerr << "Game: Failed to load " << ICE_PEASHOOTER_ICON_TEXTURE_KEY << std::endl;
-    }
-    if (!m_resourceManager.hasTexture(SHOVEL_TEXTURE_KEY))
-    {
-        if (!m_resourceManager.loadTexture(SHOVEL_TEXTURE_KEY, "../../assets/images/shovel.png"))
-            std::cerr << "Game: Failed to load " << SHOVEL_TEXTURE_KEY << std::endl;
-    }
-    if (!m_resourceManager.hasTexture(SHOVEL_CURSOR_TEXTURE_KEY))
-    {
-        // Assuming same image for cursor for now, adjust path if different
-        if (!m_resourceManager.loadTexture(SHOVEL_CURSOR_TEXTURE_KEY, "../../assets/images/shovel.png"))
-            std::cerr << "Game: Failed to load " << SHOVEL_CURSOR_TEXTURE_KEY << std::endl;
+        if (!m_globalResources.acquireTexture(texture.id, texture.path))
+            std::cerr << "Game: Failed to load " << texture.id << std::endl;
     }
 
+    prewarmFontGlyphs();
+
     // 背景音乐
     if (!m_soundManager.loadMusic(BGM_GAMEPLAY, "../../assets/audio/gameplay_music.mp3"))
     {
@@ -87,25 +120,86 @@ void Game::loadGlobalResources()
     std::cout << "Game:全局资源加载尝试完毕。" << std::endl;
 }
 
+void Game::prewarmFontGlyphs()
+{
+    sf::Clock prewarmClock;
+    std::size_t glyphCount = 0;
+    const sf::Font *warmedFont = nullptr;
+    for (ResourceId fontId : {FONT_ID_PRIMARY, FONT_ID_SECONDARY})
+    {
+        // 主/次字体内容相同时是同一个 sf::Font, 共享字形页, 只预热一次
+        const sf::Font *font = &m_resourceManager.getFont(fontId);
+        if (font == warmedFont)
+            continue;
+        warmedFont = font;
+        for (const GlyphStyle &style : UI_GLYPH_STYLES)
+        {
+            glyphCount += m_resourceManager.prewarmGlyphs(fontId, style.characterSize, style.outlineThickness);
+        }
+    }
+    std::cout << "Game: Prewarmed " << glyphCount << " glyphs in "
+              << prewarmClock.getElapsedTime().asMilliseconds() << " ms." << std::endl;
+}
+
 void Game::run()
 {
     sf::Clock clock;
     sf::Time timeSinceLastUpdate = sf::Time::Zero;
+    bool wasIdle = false;
+    bool idleNeedsRedraw = true;
+    m_loopStatsClock.restart();
 
     while (m_window.isOpen())
     {
-        sf::Time elapsedTime = clock.restart();
-        timeSinceLastUpdate += elapsedTime;
+        // 登记后台解码完成的音效 (空闲模式下也要跑, 没有待解码的音效时直接返回)
+        m_soundManager.update();
 
-        while (timeSinceLastUpdate > TIME_PER_FRAME)
+        if (!m_stateManager.needsContinuousUpdate())
+        {
+            // 静态界面: 不跑固定步长循环, 阻塞等待输入, 只在有事件或界面失效时重绘
+            if (!wasIdle)
+            {
+                wasIdle = true;
+                idleNeedsRedraw = true;
+            }
+            if (idleNeedsRedraw || m_stateManager.consumeRedrawRequest())
+            {
+                render(false);
+            }
+            idleNeedsRedraw = waitForEvents(IDLE_WAIT_TIMEOUT);
+        }
+        else
         {
-            timeSinceLastUpdate -= TIME_PER_FRAME;
+            if (wasIdle)
+            {
+                // 从空闲模式回来, 丢弃等待期间累积的时间, 避免补帧
+                wasIdle = false;
+                clock.restart();
+                timeSinceLastUpdate = sf::Time::Zero;
+                m_framePacer.resetTimeline();
+            }
 
-            processEvents();
-            update(TIME_PER_FRAME);
+            sf::Time elapsedTime = clock.restart();
+            timeSinceLastUpdate += elapsedTime;
+
+            sf::Clock busyClock;
+            while (timeSinceLastUpdate > TIME_PER_FRAME)
+            {
+                timeSinceLastUpdate -= TIME_PER_FRAME;
+
+                processEvents();
+                update(TIME_PER_FRAME);
+            }
+
+            m_loopBusyTime += busyClock.getElapsedTime();
+
+            render();
         }
 
-        render();
+        if (m_loopStatsClock.getElapsedTime() >= LOOP_STATS_INTERVAL)
+        {
+            reportLoopStats(wasIdle);
+        }
 
         if (m_stateManager.isEmpty())
         {
@@ -119,26 +213,147 @@ void Game::processEvents()
     sf::Event event;
     while (m_window.pollEvent(event))
     {
-        if (event.type == sf::Event::Closed)
+        handleWindowEvent(event);
+    }
+}
+
+void Game::handleWindowEvent(const sf::Event &event)
+{
+    if (event.type == sf::Event::Closed)
+    {
+        m_window.close();
+    }
+    m_stateManager.handleEvent(event);
+}
+
+// 等待窗口事件, 最多等待 timeout; 返回是否处理了事件
+// SFML 2.6 的 waitEvent 没有超时参数, 这里用轮询 + 短暂休眠实现
+bool Game::waitForEvents(sf::Time timeout)
+{
+    sf::Clock waitClock;
+    bool handledAny = false;
+    while (m_window.isOpen())
+    {
+        sf::Clock busyClock;
+        sf::Event event;
+        while (m_window.pollEvent(event))
         {
-            m_window.close();
+            handleWindowEvent(event);
+            handledAny = true;
+        }
+        m_loopBusyTime += busyClock.getElapsedTime();
+
+        if (handledAny || waitClock.getElapsedTime() >= timeout)
+        {
+            break;
         }
-        m_stateManager.handleEvent(event);
+        sf::sleep(IDLE_POLL_SLICE);
     }
+    return handledAny;
 }
 
 void Game::update(sf::Time deltaTime)
 {
     m_stateManager.update(deltaTime.asSeconds());
+    ++m_loopUpdates;
 }
 
-void Game::render()
+void Game::render(bool paced)
 {
+    // 帧节奏等待和 display() 不计入忙碌时间
+    sf::Clock busyClock;
     m_window.clear(sf::Color(50, 50, 50));
 
     m_stateManager.render(m_window);
+    m_loopBusyTime += busyClock.getElapsedTime();
 
+    if (paced)
+    {
+        m_framePacer.waitForNextFrame();
+    }
     m_window.display();
+    if (paced)
+    {
+        m_framePacer.onFramePresented();
+    }
+    ++m_loopFramesRendered;
+    recordFrameMetrics();
+}
+
+void Game::registerMetrics()
+{
+    m_frameTimeMetric = &m_metrics.histogram("pvz_frame_time_seconds", "Wall time between presented frames.",
+                                             {0.004, 0.008, 0.0125, 0.0167, 0.02, 0.025, 0.033, 0.05, 0.1, 0.25});
+    m_frameAllocationsMetric = &m_metrics.histogram("pvz_allocations_per_frame", "Heap allocations made during one frame.",
+                                                    {0, 1, 5, 10, 25, 50, 100, 250, 500, 1000});
+    m_framesMetric = &m_metrics.counter("pvz_frames_total", "Frames presented.");
+    m_allocationsMetric = &m_metrics.counter("pvz_allocations_total", "Heap allocations since start.");
+    m_allocatedBytesMetric = &m_metrics.counter("pvz_allocated_bytes_total", "Heap bytes requested since start.");
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        m_liveBytesMetrics[tag] = &m_metrics.gauge("pvz_heap_live_bytes", "Live heap bytes by allocation tag.",
+                                                   std::string("tag=\"") + AllocationCounter::getTagName(static_cast<AllocationTag>(tag)) + "\"");
+    }
+}
+
+void Game::recordFrameMetrics()
+{
+    m_frameTimeMetric->observe(m_frameMetricsClock.restart().asSeconds());
+    m_framesMetric->increment();
+
+    std::uint64_t allocations = AllocationCounter::getTotalAllocations();
+    std::uint64_t bytes = AllocationCounter::getTotalBytes();
+    m_lastFrameAllocations = allocations - m_lastAllocationCount;
+    m_frameAllocationsMetric->observe(static_cast<double>(m_lastFrameAllocations));
+    m_allocationsMetric->increment(m_lastFrameAllocations);
+    m_allocatedBytesMetric->increment(bytes - m_lastAllocatedBytes);
+    m_lastAllocationCount = allocations;
+    m_lastAllocatedBytes = bytes;
+    m_loopAllocations += m_lastFrameAllocations;
+    m_loopMaxFrameAllocations = std::max(m_loopMaxFrameAllocations, m_lastFrameAllocations);
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        std::uint64_t tagAllocations = AllocationCounter::getAllocations(static_cast<AllocationTag>(tag));
+        m_frameTagAllocations[tag] = tagAllocations - m_lastTagAllocations[tag];
+        m_loopTagAllocations[tag] += m_frameTagAllocations[tag];
+        m_lastTagAllocations[tag] = tagAllocations;
+        m_liveBytesMetrics[tag]->set(static_cast<double>(AllocationCounter::getLiveBytes(static_cast<AllocationTag>(tag))));
+    }
+}
+
+void Game::reportLoopStats(bool idle)
+{
+    float wallSeconds = m_loopStatsClock.restart().asSeconds();
+    float busyPercent = wallSeconds > 0.f ? m_loopBusyTime.asSeconds() / wallSeconds * 100.f : 0.f;
+    std::cout << "Game: main loop busy " << busyPercent << "% | "
+              << m_loopFramesRendered << " frames, " << m_loopUpdates << " updates in "
+              << wallSeconds << "s" << (idle ? " (idle mode)" : "");
+    if (m_loopFramesRendered > 0)
+    {
+        std::cout << " | allocations/frame avg " << static_cast<float>(m_loopAllocations) / m_loopFramesRendered
+                  << " max " << m_loopMaxFrameAllocations;
+    }
+    std::cout << std::endl;
+
+    // 内存: 各标签 存活 KB (峰值 KB) 和周期内平均每帧分配次数
+    std::cout << "Game: memory";
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        AllocationTag allocationTag = static_cast<AllocationTag>(tag);
+        std::cout << " | " << AllocationCounter::getTagName(allocationTag) << " "
+                  << AllocationCounter::getLiveBytes(allocationTag) / 1024 << "KB (peak "
+                  << AllocationCounter::getPeakBytes(allocationTag) / 1024 << "KB)";
+        if (m_loopFramesRendered > 0)
+            std::cout << " " << static_cast<float>(m_loopTagAllocations[tag]) / m_loopFramesRendered << "/frame";
+    }
+    std::cout << " | textures " << m_resourceManager.getTextureMemoryBytes() / 1024 << "KB" << std::endl;
+
+    m_loopBusyTime = sf::Time::Zero;
+    m_loopFramesRendered = 0;
+    m_loopUpdates = 0;
+    m_loopAllocations = 0;
+    m_loopMaxFrameAllocations = 0;
+    m_loopTagAllocations.fill(0);
 }
 
 ResourceManager &Game::getResourceManager()
@@ -158,4 +373,67 @@ sf::RenderWindow &Game::getWindow()
 SoundManager &Game::getSoundManager()
 {
     return m_soundManager;
-}
\ No newline at end of file
+}
+
+FramePacer &Game::getFramePacer()
+{
+    return m_framePacer;
+}
+
+const BoardConfig &Game::getBoardConfig() const
+{
+    return m_boardConfig;
+}
+const LockstepConfig &Game::getLockstepConfig() const
+{
+    return m_lockstepConfig;
+}
+
+const SpectatorConfig &Game::getSpectatorConfig() const
+{
+    return m_spectatorConfig;
+}
+
+const SimulationConfig &Game::getSimulationConfig() const
+{
+    return m_simulationConfig;
+}
+
+MetricsRegistry &Game::getMetrics()
+{
+    return m_metrics;
+}
+
+std::uint64_t Game::getLastFrameAllocations() const
+{
+    return m_lastFrameAllocations;
+}
+
+void Game::writeMemoryStatsText(std::ostream &out) const
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(1);
+    out << std::fixed << "Heap " << AllocationCounter::getTotalLiveBytes() / (1024.f * 1024.f) << "MB";
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        AllocationTag allocationTag = static_cast<AllocationTag>(tag);
+        out << " | " << AllocationCounter::getTagName(allocationTag) << " "
+            << AllocationCounter::getLiveBytes(allocationTag) / 1024 << "/"
+            << AllocationCounter::getPeakBytes(allocationTag) / 1024 << "KB";
+        if (m_frameTagAllocations[tag] > 0)
+            out << " +" << m_frameTagAllocations[tag];
+    }
+    out << " | textures " << m_resourceManager.getTextureMemoryBytes() / (1024.f * 1024.f) << "MB";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Game::setExitCode(int exitCode)
+{
+    m_exitCode = exitCode;
+}
+
+int Game::getExitCode() const
+{
+    return m_exitCode;
+}
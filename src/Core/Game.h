@@ -3,12 +3,29 @@
 #include <SFML/Graphics.hpp>
 #include "StateManager.h"
 #include "ResourceManager.h"
+#include "ResourceScope.h"
+#include "FramePacer.h"
+#include "SimulationConfig.h"
 #include "../Utils/SoundManager.h"
+#include "../Utils/MetricsRegistry.h"
+#include "../Utils/AllocationCounter.h"
+#include "../Systems/Grid.h"
+#include "../Network/LockstepConfig.h"
+#include "../Network/SpectatorConfig.h"
+#include "../Network/MetricsServer.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <ostream>
 
 class Game
 {
 public:
-    Game();
+    explicit Game(const BoardConfig &boardConfig = BoardConfig::standard(),
+                  const LockstepConfig &lockstepConfig = LockstepConfig(),
+                  const SpectatorConfig &spectatorConfig = SpectatorConfig(),
+                  unsigned short metricsPort = 0,
+                  const SimulationConfig &simulationConfig = SimulationConfig());
     ~Game() = default;
     void run();
 
@@ -16,15 +33,76 @@ public:
     StateManager &getStateManager();
     sf::RenderWindow &getWindow();
     SoundManager &getSoundManager();
+    FramePacer &getFramePacer();
+    const BoardConfig &getBoardConfig() const;
+    const LockstepConfig &getLockstepConfig() const;
+    const SpectatorConfig &getSpectatorConfig() const;
+    const SimulationConfig &getSimulationConfig() const;
+    MetricsRegistry &getMetrics();
+    // 上一帧 (两次 display 之间) 全进程的堆分配次数, 调试信息显示用
+    std::uint64_t getLastFrameAllocations() const;
+    // 调试信息: 各子系统的存活/峰值堆内存和上一帧分配次数, 以及纹理显存估算
+    void writeMemoryStatsText(std::ostream &out) const;
+    // run() 返回后 main 的退出码 (内存基线检查不通过时非 0)
+    void setExitCode(int exitCode);
+    int getExitCode() const;
 
 private:
     void processEvents();
+    void handleWindowEvent(const sf::Event &event);
+    bool waitForEvents(sf::Time timeout);
     void update(sf::Time deltaTime);
-    void render();
+    void render(bool paced = true);
     void loadGlobalResources();
+    void prewarmFontGlyphs();
+    void reportLoopStats(bool idle);
+    void registerMetrics();
+    void recordFrameMetrics();
 
     sf::RenderWindow m_window;
+    // 运行指标注册表: 各状态持有其中指标的指针, 必须先于状态管理器构造、后于其析构
+    MetricsRegistry m_metrics;
     ResourceManager m_resourceManager;
-    StateManager m_stateManager;
+    // 整个程序期间常驻的资源 (字体、种子包图标、铲子), 各状态自己的资源由状态的 ResourceScope 持有
+    ResourceScope m_globalResources;
+    // 音频 (解码线程、混音器) 必须先于状态管理器构造、后于其析构: 状态 exit 时还会停音乐
     SoundManager m_soundManager;
+    StateManager m_stateManager;
+    FramePacer m_framePacer;
+    // 新关卡使用的棋盘尺寸
+    BoardConfig m_boardConfig;
+    // 双人合作联机参数, 单人时 role 为 NONE
+    LockstepConfig m_lockstepConfig;
+    // 观战广播/观众模式参数
+    SpectatorConfig m_spectatorConfig;
+    // 确定性校验 (固定种子、校验和日志)
+    SimulationConfig m_simulationConfig;
+
+    // 主循环负载统计: 忙碌时间占墙钟时间的比例
+    sf::Clock m_loopStatsClock;
+    sf::Time m_loopBusyTime;
+    unsigned int m_loopFramesRendered;
+    unsigned int m_loopUpdates;
+    // 统计周期内的每帧堆分配次数 (平均/最大), 稳态目标为 0
+    std::uint64_t m_loopAllocations;
+    std::uint64_t m_loopMaxFrameAllocations;
+
+    // 运行指标导出服务 (注册表见上方 m_metrics)
+    std::unique_ptr<MetricsServer> m_metricsServer;
+    MetricHistogram *m_frameTimeMetric;
+    MetricHistogram *m_frameAllocationsMetric;
+    MetricCounter *m_framesMetric;
+    MetricCounter *m_allocationsMetric;
+    MetricCounter *m_allocatedBytesMetric;
+    sf::Clock m_frameMetricsClock;
+    std::uint64_t m_lastAllocationCount;
+    std::uint64_t m_lastAllocatedBytes;
+    std::uint64_t m_lastFrameAllocations;
+    // 按分配标签: 上次采样时的累计次数 / 上一帧的次数 / 统计周期内的总次数
+    using TagCounts = std::array<std::uint64_t, AllocationCounter::TAG_COUNT>;
+    TagCounts m_lastTagAllocations;
+    TagCounts m_frameTagAllocations;
+    TagCounts m_loopTagAllocations;
+    MetricGauge *m_liveBytesMetrics[AllocationCounter::TAG_COUNT];
+    int m_exitCode;
 };
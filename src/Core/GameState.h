@@ -1,5 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <span>
+#include "../Utils/SoundAsset.h"
 
 class StateManager;
 class GameState
@@ -14,6 +16,22 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void render(sf::RenderWindow &window) = 0;
 
+    // 有新状态压在上面时调用 pause, 上面的状态弹出、重新回到栈顶时调用 resume
+    // 自带后台线程的状态 (关卡模拟) 借此暂停推进
+    virtual void pause() {}
+    virtual void resume() {}
+
+    // 覆盖层状态 (如暂停菜单) 只画半透明内容, 其下方的状态需要保持可见;
+    // 下方状态在被覆盖期间冻结, StateManager 会把它截成一张静态图
+    virtual bool isOverlay() const { return false; }
+
+    // 静态界面 (菜单、暂停、结算) 返回 false, Game::run 会进入事件驱动的空闲模式,
+    // 只在有输入或界面失效时重绘
+    virtual bool needsContinuousUpdate() const { return true; }
+
+    // 本状态会播放的音效; 状态压栈时交给 SoundManager 在后台解码, 播放时不再等待加载
+    virtual std::span<const SoundAsset> getSoundManifest() const { return {}; }
+
 protected:
     StateManager *m_stateManager; // 指向状态管理器
 };
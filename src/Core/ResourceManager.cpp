@@ -1,8 +1,18 @@
 #include "ResourceManager.h"
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string_view>
 #include "../Utils/Constants.h"
+#include "../Utils/AllocationCounter.h"
 
-ResourceManager::ResourceManager()
+namespace
+{
+    // 默认字体的内部键, 常驻不释放
+    constexpr ResourceId DEFAULT_FONT_ID{"default_font"};
+}
+
+ResourceManager::ResourceManager() : m_defaultFont(&m_emptyFont)
 {
     createDefaultResources();
 }
@@ -17,67 +27,187 @@ void ResourceManager::createDefaultResources()
         std::cerr << "Failed to create default texture." << std::endl;
     }
 
-    if (!m_defaultFont.loadFromFile(FONT_PATH_ARIAL))
+    if (acquireFont(DEFAULT_FONT_ID, FONT_PATH_ARIAL))
+    {
+        m_defaultFont = &getFont(DEFAULT_FONT_ID);
+    }
+    else
     {
         std::cerr << "ResourceManager: Failed to load default font. Text may not render." << std::endl;
     }
 }
 
-bool ResourceManager::loadTexture(const std::string &id, const std::string &filename)
+bool ResourceManager::readFile(const std::string &filename, std::vector<char> &data)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
+
+bool ResourceManager::loadFromData(sf::Texture &texture, std::vector<char> &data)
+{
+    bool loaded = texture.loadFromMemory(data.data(), data.size());
+    // 像素已上传, 文件内容不再需要
+    std::vector<char>().swap(data);
+    return loaded;
+}
+
+bool ResourceManager::loadFromData(sf::Font &font, std::vector<char> &data)
+{
+    return font.loadFromMemory(data.data(), data.size());
+}
+
+template <typename Resource>
+bool ResourceManager::acquire(Cache<Resource> &cache, ResourceId id, const std::string &filename, const char *kind)
 {
-    auto texture = std::make_unique<sf::Texture>();
-    if (!texture->loadFromFile(filename))
+    AllocationScope allocationScope(AllocationTag::RESOURCES);
+    if (typename Cache<Resource>::Alias *alias = cache.aliases.find(id))
     {
-        std::cerr << "ResourceManager: Failed to load texture '" << filename << "' for ID '" << id << "'." << std::endl;
+        ++alias->refCount;
+        return true;
+    }
+
+    ResourceId existing;
+    if (cache.aliases.collides(id, &existing))
+    {
+        std::cerr << "ResourceManager: " << kind << " ID '" << id << "' collides with '" << existing << "', not loading '" << filename << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<char> data;
+    if (!readFile(filename, data))
+    {
+        std::cerr << "ResourceManager: Failed to load " << kind << " '" << filename << "' for ID '" << id << "'." << std::endl;
         return false;
     }
-    m_textures[id] = std::move(texture);
-    std::cout << "ResourceManager: Loaded texture '" << filename << "' as ID '" << id << "'." << std::endl;
+
+    std::uint64_t contentHash = ResourceId::hashBytes(std::string_view(data.data(), data.size()));
+    auto found = cache.contents.find(contentHash);
+    typename Cache<Resource>::Entry *entry = nullptr;
+    if (found != cache.contents.end())
+    {
+        entry = found->second.get();
+        std::cout << "ResourceManager: '" << filename << "' as ID '" << id << "' shares an already loaded " << kind << "." << std::endl;
+    }
+    else
+    {
+        auto created = std::make_unique<typename Cache<Resource>::Entry>();
+        created->resource = std::make_unique<Resource>();
+        created->data = std::move(data);
+        created->contentHash = contentHash;
+        if (!loadFromData(*created->resource, created->data))
+        {
+            std::cerr << "ResourceManager: Failed to decode " << kind << " '" << filename << "' for ID '" << id << "'." << std::endl;
+            return false;
+        }
+        entry = created.get();
+        cache.contents.emplace(contentHash, std::move(created));
+        std::cout << "ResourceManager: Loaded " << kind << " '" << filename << "' as ID '" << id << "'." << std::endl;
+    }
+
+    ++entry->aliasCount;
+    cache.aliases.insertOrAssign(id, typename Cache<Resource>::Alias{entry, 1});
     return true;
 }
 
-const sf::Texture &ResourceManager::getTexture(const std::string &id) const
+template <typename Resource>
+void ResourceManager::release(Cache<Resource> &cache, ResourceId id, const char *kind)
 {
-    auto it = m_textures.find(id);
-    if (it != m_textures.end())
+    typename Cache<Resource>::Alias *alias = cache.aliases.find(id);
+    if (!alias)
     {
-        return *(it->second);
+        std::cerr << "ResourceManager: Releasing unknown " << kind << " ID '" << id << "'." << std::endl;
+        return;
     }
+    if (--alias->refCount > 0)
+        return;
 
-    return m_defaultTexture;
+    typename Cache<Resource>::Entry *entry = alias->entry;
+    cache.aliases.erase(id);
+    if (--entry->aliasCount > 0)
+        return;
+
+    cache.contents.erase(entry->contentHash);
+    std::cout << "ResourceManager: Unloaded " << kind << " '" << id << "'." << std::endl;
+}
+
+bool ResourceManager::acquireTexture(ResourceId id, const std::string &filename)
+{
+    return acquire(m_textures, id, filename, "texture");
 }
 
-bool ResourceManager::hasTexture(const std::string &id) const
+void ResourceManager::releaseTexture(ResourceId id)
 {
-    return m_textures.count(id);
+    release(m_textures, id, "texture");
 }
 
-// Font loading
-bool ResourceManager::loadFont(const std::string &id, const std::string &filename)
+const sf::Texture &ResourceManager::getTexture(ResourceId id) const
 {
-    auto font = std::make_unique<sf::Font>();
-    if (!font->loadFromFile(filename))
+    if (const auto *alias = m_textures.aliases.find(id))
     {
-        std::cerr << "ResourceManager: Failed to load font '" << filename << "' for ID '" << id << "'." << std::endl;
-        return false;
+        return *alias->entry->resource;
     }
-    m_fonts[id] = std::move(font);
-    std::cout << "ResourceManager: Loaded font '" << filename << "' as ID '" << id << "'." << std::endl;
-    return true;
+
+    return m_defaultTexture;
+}
+
+bool ResourceManager::hasTexture(ResourceId id) const
+{
+    return m_textures.aliases.contains(id);
+}
+
+bool ResourceManager::acquireFont(ResourceId id, const std::string &filename)
+{
+    return acquire(m_fonts, id, filename, "font");
 }
 
-const sf::Font &ResourceManager::getFont(const std::string &id) const
+void ResourceManager::releaseFont(ResourceId id)
 {
-    auto it = m_fonts.find(id);
-    if (it != m_fonts.end())
+    release(m_fonts, id, "font");
+}
+
+const sf::Font &ResourceManager::getFont(ResourceId id) const
+{
+    if (const auto *alias = m_fonts.aliases.find(id))
     {
-        return *(it->second);
+        return *alias->entry->resource;
     }
 
-    return m_defaultFont;
+    return *m_defaultFont;
+}
+
+bool ResourceManager::hasFont(ResourceId id) const
+{
+    return m_fonts.aliases.contains(id);
+}
+
+std::size_t ResourceManager::prewarmGlyphs(ResourceId id, unsigned int characterSize, float outlineThickness) const
+{
+    const sf::Font &font = getFont(id);
+    std::size_t count = 0;
+    // UI 文本目前全部是 ASCII
+    for (sf::Uint32 codePoint = 0x20; codePoint <= 0x7E; ++codePoint)
+    {
+        font.getGlyph(codePoint, characterSize, false, outlineThickness);
+        ++count;
+    }
+    return count;
 }
 
-bool ResourceManager::hasFont(const std::string &id) const
+std::size_t ResourceManager::getTextureMemoryBytes() const
 {
-    return m_fonts.count(id);
+    // 显存占用按 RGBA8 估算, 不含驱动的对齐和 mipmap
+    auto textureBytes = [](const sf::Texture &texture)
+    {
+        sf::Vector2u size = texture.getSize();
+        return static_cast<std::size_t>(size.x) * size.y * 4;
+    };
+    std::size_t total = textureBytes(m_defaultTexture);
+    for (const auto &content : m_textures.contents)
+    {
+        total += textureBytes(*content.second->resource);
+    }
+    return total;
 }
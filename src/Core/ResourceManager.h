@@ -2,10 +2,17 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../Utils/FlatHashMap.h"
+#include "../Utils/ResourceId.h"
 
+// 纹理/字体按引用计数管理, 通常经由 ResourceScope 获取和归还
+// 同一份文件内容 (按内容哈希) 只加载一次, 不同的键作为别名共享它
 class ResourceManager
 {
 public:
@@ -14,22 +21,64 @@ public:
     ~ResourceManager() = default;
 
     // --- 纹理管理 ---
-    bool loadTexture(const std::string &id, const std::string &filename);
-    const sf::Texture &getTexture(const std::string &id) const;
-    bool hasTexture(const std::string &id) const;
+    // 增加一次引用, 键第一次被引用时从文件加载; 内容相同的文件共用一张纹理
+    bool acquireTexture(ResourceId id, const std::string &filename);
+    // 减少一次引用, 归零时移除该键; 共享同一内容的键全部移除后才释放纹理
+    void releaseTexture(ResourceId id);
+    const sf::Texture &getTexture(ResourceId id) const;
+    bool hasTexture(ResourceId id) const;
+    // 已加载纹理 (按内容去重后) 的显存估算, 按 getSize() 计算
+    std::size_t getTextureMemoryBytes() const;
 
     // --- 字体管理 ---
-    bool loadFont(const std::string &id, const std::string &filename);
-    const sf::Font &getFont(const std::string &id) const;
-    bool hasFont(const std::string &id) const;
+    bool acquireFont(ResourceId id, const std::string &filename);
+    void releaseFont(ResourceId id);
+    const sf::Font &getFont(ResourceId id) const;
+    bool hasFont(ResourceId id) const;
+    // 在加载阶段按给定字号/描边光栅化全部可打印 ASCII 字形, 返回处理的字形数
+    // 字形页由字体自身缓存, 同一字体的多个别名只需预热一次
+    std::size_t prewarmGlyphs(ResourceId id, unsigned int characterSize, float outlineThickness) const;
 
 private:
     void createDefaultResources();
 
+    // 按文件内容去重的缓存: 别名表只在查找时用, 内容表只在加载/释放时用
+    template <typename Resource>
+    struct Cache
+    {
+        struct Entry
+        {
+            std::unique_ptr<Resource> resource;
+            std::vector<char> data; // 字体从内存加载, 缓冲区要与字体同寿命; 纹理加载后不保留
+            std::uint64_t contentHash = 0;
+            int aliasCount = 0;
+        };
+        struct Alias
+        {
+            Entry *entry = nullptr;
+            int refCount = 0;
+        };
+
+        FlatHashMap<Alias> aliases;
+        std::unordered_map<std::uint64_t, std::unique_ptr<Entry>> contents;
+    };
+
+    template <typename Resource>
+    bool acquire(Cache<Resource> &cache, ResourceId id, const std::string &filename, const char *kind);
+    template <typename Resource>
+    void release(Cache<Resource> &cache, ResourceId id, const char *kind);
+
+    static bool readFile(const std::string &filename, std::vector<char> &data);
+    static bool loadFromData(sf::Texture &texture, std::vector<char> &data);
+    static bool loadFromData(sf::Font &font, std::vector<char> &data);
+
     // --- 资源存储容器 ---
-    std::map<std::string, std::unique_ptr<sf::Texture>> m_textures;
-    std::map<std::string, std::unique_ptr<sf::Font>> m_fonts;
+    // 条目存 unique_ptr: 精灵/文本持有资源地址, 表变动时不能移动资源本身
+    Cache<sf::Texture> m_textures;
+    Cache<sf::Font> m_fonts;
 
     sf::Texture m_defaultTexture;
-    sf::Font m_defaultFont;
+    // 默认字体也登记在字体缓存里 (常驻), 同一文件的其他键与它共用
+    const sf::Font *m_defaultFont;
+    sf::Font m_emptyFont;
 };
@@ -0,0 +1,53 @@
+#include "ResourceScope.h"
+#include "ResourceManager.h"
+#include <algorithm>
+#include <iostream>
+
+ResourceScope::ResourceScope(ResourceManager &resManager, std::string name)
+    : m_resourceManagerRef(resManager), m_name(std::move(name))
+{
+}
+
+ResourceScope::~ResourceScope()
+{
+    release();
+}
+
+bool ResourceScope::acquireTexture(ResourceId id, const std::string &filename)
+{
+    if (std::find(m_textures.begin(), m_textures.end(), id) != m_textures.end())
+        return true;
+    if (!m_resourceManagerRef.acquireTexture(id, filename))
+        return false;
+    m_textures.push_back(id);
+    return true;
+}
+
+bool ResourceScope::acquireFont(ResourceId id, const std::string &filename)
+{
+    if (std::find(m_fonts.begin(), m_fonts.end(), id) != m_fonts.end())
+        return true;
+    if (!m_resourceManagerRef.acquireFont(id, filename))
+        return false;
+    m_fonts.push_back(id);
+    return true;
+}
+
+void ResourceScope::release()
+{
+    if (m_textures.empty() && m_fonts.empty())
+        return;
+
+    std::cout << "ResourceScope '" << m_name << "': releasing " << m_textures.size() << " textures, "
+              << m_fonts.size() << " fonts." << std::endl;
+    for (ResourceId id : m_textures)
+    {
+        m_resourceManagerRef.releaseTexture(id);
+    }
+    for (ResourceId id : m_fonts)
+    {
+        m_resourceManagerRef.releaseFont(id);
+    }
+    m_textures.clear();
+    m_fonts.clear();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../Utils/ResourceId.h"
+
+class ResourceManager;
+
+// 某个游戏状态 (或 Game 本身的全局资源) 持有的一组资源引用
+// release 或析构时逐一归还; 引用数归零的资源由 ResourceManager 卸载
+class ResourceScope
+{
+public:
+    ResourceScope(ResourceManager &resManager, std::string name);
+    ~ResourceScope();
+    ResourceScope(const ResourceScope &) = delete;
+    ResourceScope &operator=(const ResourceScope &) = delete;
+
+    // 同一作用域对同一个键只持有一次引用, 重复获取直接返回成功
+    bool acquireTexture(ResourceId id, const std::string &filename);
+    bool acquireFont(ResourceId id, const std::string &filename);
+    void release();
+
+private:
+    ResourceManager &m_resourceManagerRef;
+    std::string m_name;
+    std::vector<ResourceId> m_textures;
+    std::vector<ResourceId> m_fonts;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// 确定性校验参数: --sim-seed N 固定模拟随机种子, --tick-hash-log PATH 定期写出状态校验和,
+// --sim-exit-tick N 模拟到第 N tick 后退出 (跳过菜单直接开局)。同一种子、不同编译优化级别的两次运行,
+// 校验和日志应逐行相同, 见 scripts/check_determinism.sh
+// --sim-command-script PATH 按 tick 回放脚本里的玩家操作 (种植/铲除/收阳光/加阳光), 让校验覆盖有输入的路径;
+// 每行 "<tick> plant <类型编号> <行> <列>" / "<tick> shovel <行> <列>" / "<tick> collect <世界x> <世界y>" / "<tick> sun <数量>", # 开头为注释
+// --soak-waves N 浸泡测试: 跳过菜单直接开局, 每局结束后原地重开, 累计打完 N 波后比较各子系统的存活内存与开局基线
+struct SimulationConfig
+{
+    bool hasFixedSeed = false;
+    std::uint64_t seed = 0;
+    std::string tickHashLogPath;
+    std::uint32_t exitTick = 0;
+    std::string commandScriptPath;
+    std::uint32_t soakWaves = 0;
+
+    bool isHashLogging() const { return !tickHashLogPath.empty(); }
+    bool isSoakTesting() const { return soakWaves != 0; }
+    bool hasCommandScript() const { return !commandScriptPath.empty(); }
+    // 无人值守的运行 (浸泡测试 / 确定性校验) 不进菜单
+    bool skipsMenu() const { return isSoakTesting() || exitTick != 0; }
+};
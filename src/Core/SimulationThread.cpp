@@ -0,0 +1,118 @@
+#include "SimulationThread.h"
+#include "../Utils/Constants.h"
+#include "../Utils/AllocationCounter.h"
+#include <chrono>
+#include <iostream>
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+namespace
+{
+    // 给线程命名, 方便在 perf / Instruments / 调试器的线程时间线里区分模拟线程和主 (渲染) 线程
+    void setCurrentThreadName(const char *name)
+    {
+#if defined(__linux__)
+        pthread_setname_np(pthread_self(), name);
+#elif defined(__APPLE__)
+        pthread_setname_np(name);
+#else
+        (void)name;
+#endif
+    }
+}
+
+SimulationThread::SimulationThread(sf::Time stepInterval)
+    : m_stepInterval(stepInterval),
+      m_running(false),
+      m_stepCount(0),
+      m_droppedSteps(0),
+      m_paused(false)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start(std::function<void()> step)
+{
+    if (m_running)
+        return;
+    m_step = std::move(step);
+    m_paused = false;
+    m_running = true;
+    m_thread = std::thread(&SimulationThread::run, this);
+    std::cout << "SimulationThread: Started, step " << m_stepInterval.asMicroseconds() << " us." << std::endl;
+}
+
+void SimulationThread::stop()
+{
+    if (!m_running)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_pauseMutex);
+        m_running = false;
+    }
+    m_pauseCondition.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+    std::cout << "SimulationThread: Stopped after " << getStepCount() << " steps (" << getDroppedSteps() << " dropped)." << std::endl;
+}
+
+void SimulationThread::setPaused(bool paused)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pauseMutex);
+        m_paused = paused;
+    }
+    m_pauseCondition.notify_all();
+}
+
+void SimulationThread::run()
+{
+    using Clock = std::chrono::steady_clock;
+    setCurrentThreadName("pvz-sim");
+    // 模拟线程上的分配默认计入游戏状态, 各实体管理器在 stepSimulation 里细分
+    AllocationScope allocationScope(AllocationTag::STATES);
+    const Clock::duration interval = std::chrono::microseconds(m_stepInterval.asMicroseconds());
+    Clock::time_point nextStep = Clock::now();
+
+    while (m_running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_pauseMutex);
+            if (m_paused)
+            {
+                m_pauseCondition.wait(lock, [this]
+                                      { return !m_paused || !m_running; });
+                nextStep = Clock::now();
+                continue;
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        if (now < nextStep)
+        {
+            std::this_thread::sleep_until(nextStep);
+            continue;
+        }
+
+        int steps = 0;
+        while (now >= nextStep && steps < SIMULATION_MAX_CATCH_UP_STEPS && m_running)
+        {
+            m_step();
+            m_stepCount.fetch_add(1, std::memory_order_relaxed);
+            nextStep += interval;
+            ++steps;
+            now = Clock::now();
+        }
+        if (now >= nextStep)
+        {
+            // 落后太多 (卡顿或调试断点), 放弃追赶, 从现在重新计时
+            m_droppedSteps.fetch_add(static_cast<std::uint64_t>((now - nextStep) / interval) + 1, std::memory_order_relaxed);
+            nextStep = now + interval;
+        }
+    }
+}
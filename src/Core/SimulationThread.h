@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// 以固定频率在独立线程上调用模拟步进函数, 与渲染帧率互不影响
+// 落后时最多连续补 SIMULATION_MAX_CATCH_UP_STEPS 步, 更多的直接丢弃 (避免越追越慢)
+class SimulationThread
+{
+public:
+    explicit SimulationThread(sf::Time stepInterval);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void start(std::function<void()> step);
+    // 等当前这一步执行完再返回, 之后可以在调用线程上安全访问模拟状态
+    void stop();
+    // 暂停时线程阻塞等待, 恢复后从当前时刻重新计时, 不补暂停期间的步数
+    void setPaused(bool paused);
+
+    bool isRunning() const { return m_running; }
+    std::uint64_t getStepCount() const { return m_stepCount.load(std::memory_order_relaxed); }
+    std::uint64_t getDroppedSteps() const { return m_droppedSteps.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    sf::Time m_stepInterval;
+    std::function<void()> m_step;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<std::uint64_t> m_stepCount;
+    std::atomic<std::uint64_t> m_droppedSteps;
+
+    std::mutex m_pauseMutex;
+    std::condition_variable m_pauseCondition;
+    bool m_paused;
+};
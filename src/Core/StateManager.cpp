@@ -1,10 +1,12 @@
 #include "StateManager.h"
 #include "GameState.h"
 #include "Game.h"
+#include "../Utils/AllocationCounter.h"
 #include <iostream>
 #include <stdexcept>
 
-StateManager::StateManager(Game *game) : m_game(game)
+StateManager::StateManager(Game *game)
+    : m_frozenState(nullptr), m_frozenFrameValid(false), m_redrawRequested(true), m_game(game)
 {
     if (!m_game)
     {
@@ -20,13 +22,21 @@ StateManager::~StateManager()
 
 void StateManager::pushState(std::unique_ptr<GameState> state)
 {
+    AllocationScope allocationScope(AllocationTag::STATES);
     if (state)
     {
 
         GameState *newStatePtr = state.get();
+        invalidateFrozenFrame();
+        m_redrawRequested = true;
+        if (!m_states.empty())
+        {
+            m_states.back()->pause();
+        }
         m_states.push_back(std::move(state));
         if (newStatePtr)
         {
+            m_game->getSoundManager().preloadSounds(newStatePtr->getSoundManifest());
             newStatePtr->enter();
         }
         std::cout << "Pushed new state. Stack size: " << m_states.size() << std::endl;
@@ -35,10 +45,17 @@ void StateManager::pushState(std::unique_ptr<GameState> state)
 
 void StateManager::popState()
 {
+    AllocationScope allocationScope(AllocationTag::STATES);
     if (!m_states.empty())
     {
+        invalidateFrozenFrame();
+        m_redrawRequested = true;
         m_states.back()->exit();
         m_states.pop_back();
+        if (!m_states.empty())
+        {
+            m_states.back()->resume();
+        }
         std::cout << "Popped state. Stack size: " << m_states.size() << std::endl;
     }
 }
@@ -63,6 +80,8 @@ void StateManager::clearStates()
 
 void StateManager::update(float deltaTime)
 {
+    // 状态内部再按子系统细分 (实体管理器、HUD 等), 其余计入状态本身
+    AllocationScope allocationScope(AllocationTag::STATES);
     if (!m_states.empty())
     {
         m_states.back()->update(deltaTime);
@@ -71,18 +90,83 @@ void StateManager::update(float deltaTime)
 
 void StateManager::render(sf::RenderWindow &window)
 {
-    // 从下往上渲染所有状态
-    for (const auto &state_ptr : m_states)
+    if (m_states.empty())
     {
-        if (state_ptr)
-        {
-            state_ptr->render(window);
-        }
+        return;
+    }
+    AllocationScope allocationScope(AllocationTag::STATES);
+
+    // 找到最上层的非覆盖层状态, 更下面的状态被它完全遮住, 无需绘制
+    size_t baseIndex = m_states.size() - 1;
+    while (baseIndex > 0 && m_states[baseIndex]->isOverlay())
+    {
+        --baseIndex;
+    }
+    GameState *baseState = m_states[baseIndex].get();
+
+    if (baseIndex + 1 == m_states.size())
+    {
+        // 没有覆盖层, 正常绘制
+        invalidateFrozenFrame();
+        baseState->render(window);
+        return;
+    }
+
+    // 被覆盖的状态不会更新: 只完整绘制一次并截图, 之后贴图即可
+    if (m_frozenFrameValid && m_frozenState == baseState &&
+        m_frozenFrameTexture.getSize() == window.getSize())
+    {
+        drawFrozenFrame(window);
+    }
+    else
+    {
+        baseState->render(window);
+        captureFrozenFrame(window, baseState);
+    }
+
+    for (size_t i = baseIndex + 1; i < m_states.size(); ++i)
+    {
+        m_states[i]->render(window);
     }
 }
 
+void StateManager::captureFrozenFrame(sf::RenderWindow &window, const GameState *state)
+{
+    sf::Vector2u windowSize = window.getSize();
+    if (m_frozenFrameTexture.getSize() != windowSize &&
+        !m_frozenFrameTexture.create(windowSize.x, windowSize.y))
+    {
+        std::cerr << "StateManager: Failed to create frozen frame texture." << std::endl;
+        invalidateFrozenFrame();
+        return;
+    }
+    // 从当前后台缓冲区拷贝 (display 之前)
+    m_frozenFrameTexture.update(window);
+    m_frozenFrameSprite.setTexture(m_frozenFrameTexture, true);
+    m_frozenState = state;
+    m_frozenFrameValid = true;
+    std::cout << "StateManager: Captured frozen frame for overlay." << std::endl;
+}
+
+void StateManager::drawFrozenFrame(sf::RenderWindow &window) const
+{
+    // 截图是窗口像素坐标, 用像素视图贴回去
+    sf::View previousView = window.getView();
+    sf::Vector2u windowSize = window.getSize();
+    window.setView(sf::View(sf::FloatRect(0.f, 0.f, static_cast<float>(windowSize.x), static_cast<float>(windowSize.y))));
+    window.draw(m_frozenFrameSprite);
+    window.setView(previousView);
+}
+
+void StateManager::invalidateFrozenFrame()
+{
+    m_frozenFrameValid = false;
+    m_frozenState = nullptr;
+}
+
 void StateManager::handleEvent(const sf::Event &event)
 {
+    AllocationScope allocationScope(AllocationTag::STATES);
     if (!m_states.empty())
     {
         m_states.back()->handleEvent(event);
@@ -103,6 +187,28 @@ bool StateManager::isEmpty() const
     return m_states.empty();
 }
 
+bool StateManager::needsContinuousUpdate() const
+{
+    // 只有栈顶状态会被更新
+    if (!m_states.empty())
+    {
+        return m_states.back()->needsContinuousUpdate();
+    }
+    return false;
+}
+
+void StateManager::requestRedraw()
+{
+    m_redrawRequested = true;
+}
+
+bool StateManager::consumeRedrawRequest()
+{
+    bool requested = m_redrawRequested;
+    m_redrawRequested = false;
+    return requested;
+}
+
 Game *StateManager::getGame() const
 {
     return m_game;
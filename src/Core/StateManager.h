@@ -3,6 +3,8 @@
 #include <vector>
 #include <memory>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Window/Event.hpp>
 
 class GameState;
@@ -26,9 +28,26 @@ public:
     GameState *getCurrentState() const;
     bool isEmpty() const;
 
+    // 空闲模式支持
+    bool needsContinuousUpdate() const;
+    void requestRedraw();
+    bool consumeRedrawRequest();
+
     Game *getGame() const;
 
 private:
+    void captureFrozenFrame(sf::RenderWindow &window, const GameState *state);
+    void drawFrozenFrame(sf::RenderWindow &window) const;
+    void invalidateFrozenFrame();
+
     std::vector<std::unique_ptr<GameState>> m_states;
+
+    // 被覆盖层盖住的状态的冻结画面
+    sf::Texture m_frozenFrameTexture;
+    sf::Sprite m_frozenFrameSprite;
+    const GameState *m_frozenState;
+    bool m_frozenFrameValid;
+
+    bool m_redrawRequested;
     Game *m_game;
 };
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "EntityId.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 原型: 组件集合在编译期固定, 实体按行存放在定长块里, 块内每种组件一列连续数组
+// 删除用末行补位 (swap-and-pop), 行号始终紧凑; 块只增不减, 反复生成/销毁不再分配
+// 块从构造时给定的内存资源上分配 (关卡用关卡内存区), releaseChunks() 把块整体归还;
+// 块指针表会随实体数增长反复扩容, 放在普通堆上 (线性内存区不回收旧的表, 每次扩容都会漏掉一份)
+template <typename... Components>
+class Archetype
+{
+public:
+    static constexpr std::size_t CHUNK_CAPACITY = ECS_CHUNK_CAPACITY;
+
+    Archetype() : Archetype(std::pmr::get_default_resource()) {}
+    explicit Archetype(std::pmr::memory_resource *resource) : m_chunkResource(resource) {}
+    Archetype(Archetype &&other) noexcept
+        : m_chunkResource(other.m_chunkResource), m_chunks(std::move(other.m_chunks)), m_size(other.m_size)
+    {
+        other.m_chunks.clear();
+        other.m_size = 0;
+    }
+    Archetype(const Archetype &) = delete;
+    Archetype &operator=(const Archetype &) = delete;
+    Archetype &operator=(Archetype &&) = delete;
+    ~Archetype() { releaseChunks(); }
+
+    template <typename C>
+    static constexpr bool has = (std::is_same_v<C, Components> || ...);
+    template <typename... Qs>
+    static constexpr bool hasAll = (has<Qs> && ...);
+
+    std::uint32_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // 追加一行, 各组件为默认值, 返回行号
+    std::uint32_t pushBack(EntityId id)
+    {
+        if (m_size == m_chunks.size() * CHUNK_CAPACITY)
+        {
+            m_chunks.push_back(allocator().template new_object<Chunk>());
+        }
+        std::uint32_t row = m_size++;
+        Chunk &chunk = chunkOf(row);
+        std::size_t slot = row % CHUNK_CAPACITY;
+        chunk.ids[slot] = id;
+        ((std::get<std::array<Components, CHUNK_CAPACITY>>(chunk.columns)[slot] = Components{}), ...);
+        return row;
+    }
+
+    // 删除一行, 末行搬来补位; 返回被搬动的实体 (删除的就是末行时返回无效句柄)
+    EntityId swapRemove(std::uint32_t row)
+    {
+        std::uint32_t last = m_size - 1;
+        EntityId moved;
+        if (row != last)
+        {
+            moved = getId(last);
+            chunkOf(row).ids[row % CHUNK_CAPACITY] = moved;
+            ((get<Components>(row) = std::move(get<Components>(last))), ...);
+        }
+        // 末行重置, 释放组件持有的资源引用
+        ((get<Components>(last) = Components{}), ...);
+        --m_size;
+        return moved;
+    }
+
+    void clear()
+    {
+        while (m_size > 0)
+        {
+            swapRemove(m_size - 1);
+        }
+    }
+
+    // 删除全部行并归还所有块, 块指针表也释放; 之后内存资源可以整体回收
+    void releaseChunks()
+    {
+        clear();
+        std::pmr::polymorphic_allocator<Chunk> alloc = allocator();
+        for (Chunk *chunk : m_chunks)
+        {
+            alloc.delete_object(chunk);
+        }
+        std::vector<Chunk *>().swap(m_chunks);
+    }
+
+    EntityId getId(std::uint32_t row) const { return chunkOf(row).ids[row % CHUNK_CAPACITY]; }
+
+    template <typename C>
+    C &get(std::uint32_t row)
+    {
+        return std::get<std::array<C, CHUNK_CAPACITY>>(chunkOf(row).columns)[row % CHUNK_CAPACITY];
+    }
+    template <typename C>
+    const C &get(std::uint32_t row) const
+    {
+        return std::get<std::array<C, CHUNK_CAPACITY>>(chunkOf(row).columns)[row % CHUNK_CAPACITY];
+    }
+
+    // 按块遍历: fn(EntityId, Qs&...), 每块内各列连续访问
+    template <typename... Qs, typename Fn>
+    void each(Fn &&fn)
+    {
+        for (std::size_t c = 0; c < m_chunks.size(); ++c)
+        {
+            Chunk &chunk = *m_chunks[c];
+            std::size_t count = rowsInChunk(c);
+            for (std::size_t slot = 0; slot < count; ++slot)
+            {
+                fn(chunk.ids[slot], std::get<std::array<Qs, CHUNK_CAPACITY>>(chunk.columns)[slot]...);
+            }
+        }
+    }
+    template <typename... Qs, typename Fn>
+    void each(Fn &&fn) const
+    {
+        for (std::size_t c = 0; c < m_chunks.size(); ++c)
+        {
+            const Chunk &chunk = *m_chunks[c];
+            std::size_t count = rowsInChunk(c);
+            for (std::size_t slot = 0; slot < count; ++slot)
+            {
+                fn(chunk.ids[slot], std::get<std::array<Qs, CHUNK_CAPACITY>>(chunk.columns)[slot]...);
+            }
+        }
+    }
+
+private:
+    struct Chunk
+    {
+        std::tuple<std::array<Components, CHUNK_CAPACITY>...> columns;
+        std::array<EntityId, CHUNK_CAPACITY> ids;
+    };
+
+    std::pmr::polymorphic_allocator<Chunk> allocator() const { return std::pmr::polymorphic_allocator<Chunk>(m_chunkResource); }
+    Chunk &chunkOf(std::uint32_t row) { return *m_chunks[row / CHUNK_CAPACITY]; }
+    const Chunk &chunkOf(std::uint32_t row) const { return *m_chunks[row / CHUNK_CAPACITY]; }
+    std::size_t rowsInChunk(std::size_t chunkIndex) const
+    {
+        std::size_t begin = chunkIndex * CHUNK_CAPACITY;
+        return m_size <= begin ? 0 : std::min(CHUNK_CAPACITY, m_size - begin);
+    }
+
+    std::pmr::memory_resource *m_chunkResource;
+    // 块地址固定 (单独分配), 扩容时已有块不搬动
+    std::vector<Chunk *> m_chunks;
+    std::uint32_t m_size = 0;
+};
@@ -0,0 +1,56 @@
+#include "Components.h"
+
+void Visual::setTexture(const sf::Texture &texture)
+{
+    sprite.setTexture(texture, true);
+}
+
+void Visual::bindAnimation(ResourceId textureKey, EntityId owner)
+{
+    const sf::Texture *texture = sprite.getTexture();
+    if (!texture)
+        return;
+    // 句柄的下标和代数混合后作为相位种子 (乘法散列), 相邻实体的相位也能错开
+    std::uint32_t phaseSeed = (owner.index ^ (owner.generation << 16)) * 2654435761u;
+    animator.setAnimationSet(&AnimationLibrary::getSet(textureKey, *texture), sprite, phaseSeed);
+}
+
+void Visual::play(AnimationState state, bool restart)
+{
+    animator.play(state, sprite, restart);
+}
+
+void Visual::centerOrigin()
+{
+    sf::FloatRect bounds = sprite.getLocalBounds();
+    sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+}
+
+void Visual::bottomCenterOrigin()
+{
+    sf::FloatRect bounds = sprite.getLocalBounds();
+    sprite.setOrigin(bounds.width / 2.f, bounds.height);
+}
+
+FixedRect Visual::getBounds(const FixedVector2 &position) const
+{
+    // 原点和帧尺寸都是整数或半像素, 转成定点是精确的
+    sf::FloatRect local = sprite.getLocalBounds();
+    FixedVector2 origin = FixedVector2::fromVector(sprite.getOrigin());
+    return FixedRect{position.x - origin.x, position.y - origin.y,
+                     Fixed::fromFloat(local.width), Fixed::fromFloat(local.height)};
+}
+
+sf::FloatRect Visual::getGlobalBounds(const FixedVector2 &position) const
+{
+    sf::FloatRect bounds = sprite.getGlobalBounds();
+    sf::Vector2f renderPosition = position.toVector2f();
+    bounds.left += renderPosition.x;
+    bounds.top += renderPosition.y;
+    return bounds;
+}
+
+RenderSprite Visual::toRenderSprite(const FixedVector2 &position, RenderLayer layer) const
+{
+    return RenderSprite{sprite, position.toVector2f(), getGlobalBounds(position), layer};
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "EntityId.h"
+#include "EntityTypes.h"
+#include "../Entities/Animator.h"
+#include "../Systems/RenderSprite.h"
+#include "../Utils/Fixed.h"
+#include "../Utils/ResourceId.h"
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+
+// 组件只存数据, 行为都在 Systems 里; 同一原型的同种组件在块内连续存放
+
+// 定点模拟坐标, 是实体位置的唯一依据
+struct Transform
+{
+    FixedVector2 position;
+};
+
+// 精灵与动画; 精灵本身停在 (0,0), 绘制时才平移到 Transform 的位置
+struct Visual
+{
+    sf::Sprite sprite;
+    Animator animator;
+
+    void setTexture(const sf::Texture &texture);
+    // 绑定该原型共享的动画数据, 需在计算原点之前调用 (帧矩形决定包围盒);
+    // 循环动画的相位由实体句柄算出, 同一局重放时帧号一致
+    void bindAnimation(ResourceId textureKey, EntityId owner);
+    void play(AnimationState state, bool restart = false);
+    void centerOrigin();
+    // 脚底居中 (僵尸)
+    void bottomCenterOrigin();
+
+    // 模拟包围盒 (碰撞/拾取): 定点位置减去原点, 宽高取当前帧矩形 (整数像素), 不含缩放和旋转
+    FixedRect getBounds(const FixedVector2 &position) const;
+    // 绘制用的浮点包围盒 (视口裁剪)
+    sf::FloatRect getGlobalBounds(const FixedVector2 &position) const;
+    RenderSprite toRenderSprite(const FixedVector2 &position, RenderLayer layer) const;
+};
+
+struct Health
+{
+    int current = 0;
+};
+
+// --- 植物 ---
+struct PlantInfo
+{
+    PlantType type = PlantType::SUNFLOWER;
+    sf::Vector2i gridPos;
+};
+
+// 间隔、子弹类型等静态数值按 PlantInfo::type 查 PLANT_DESCRIPTORS
+struct SunProducer
+{
+    Fixed timer;
+};
+
+struct Shooter
+{
+    Fixed timer;
+};
+
+// --- 僵尸 ---
+// 原始速度、伤害、攻击间隔按类型查 ZOMBIE_DESCRIPTORS
+struct ZombieInfo
+{
+    ZombieType type = ZombieType::BASIC;
+};
+
+struct ZombieBrain
+{
+    ZombieState state = ZombieState::WALKING;
+    Fixed stateTimer;
+    Fixed currentSpeed;
+    EntityId target; // 正在啃的植物, 植物被铲除/吃掉后句柄自动失效
+};
+
+struct Slow
+{
+    bool active = false;
+    Fixed remaining;
+};
+
+// --- 子弹 ---
+struct ProjectileInfo
+{
+    ProjectileType type = ProjectileType::PEA;
+    int damage = 0;
+    bool hasHit = false;
+};
+
+struct Velocity
+{
+    FixedVector2 direction;
+    Fixed speed;
+};
+
+struct Lifespan
+{
+    Fixed remaining; // 小于等于 0 表示不限寿命
+};
+
+// 命中时施加减速 (寒冰豌豆)
+struct SlowOnHit
+{
+    Fixed duration;
+    Fixed factor;
+};
+
+// --- 阳光 ---
+struct SunState
+{
+    SunSpawnType spawnType = SunSpawnType::FROM_SKY;
+    int value = 0;
+    Fixed lifespan;
+    Fixed expireTime = Fixed(-1); // 尚未安排到期时为 -1
+    std::uint32_t spawnOrder = 0; // 越大越在上层 (绘制和点击拾取一致)
+
+    // 天空阳光
+    bool falling = false;
+    Fixed skyTargetY;
+
+    // 植物阳光
+    FixedVector2 velocity;
+    FixedVector2 plantTarget;
+    bool reachedTarget = false;
+
+    bool isMoving() const { return spawnType == SunSpawnType::FROM_SKY ? falling : !reachedTarget; }
+};
+
+// 阳光在拾取空间哈希里覆盖的格子范围
+struct SunPickCells
+{
+    int minX = 0, minY = 0, maxX = -1, maxY = -1;
+    bool operator==(const SunPickCells &other) const = default;
+};
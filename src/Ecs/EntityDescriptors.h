@@ -0,0 +1,111 @@
+#pragma once
+
+#include "EntityTypes.h"
+#include "../Utils/Constants.h"
+#include "../Utils/Fixed.h"
+#include <array>
+#include <cstddef>
+
+// 每种植物/僵尸的静态数值表, 按类型枚举值下标; 所有同类实体共享一行, 组件里只放会变化的状态
+// 新增类型: 在 EntityTypes.h 的 COUNT 之前追加枚举值, 再在这里追加一行 (行数不符时编译失败)
+
+// 植物的行为类别, 决定它使用哪个原型 (见 GameWorld.h 的 PlantArchetypeFor)
+enum class PlantBehavior
+{
+    PRODUCE_SUN,
+    SHOOT,
+    BLOCK
+};
+
+struct PlantDescriptor
+{
+    PlantType type;
+    PlantBehavior behavior;
+    ResourceId textureKey;
+    ResourceId iconTextureKey;
+    int health;
+    int cost;
+    float cooldownTime;      // 种子包冷却 (UI 计时, 不进模拟)
+    Fixed actionInterval;    // 产阳光/射击间隔, BLOCK 不使用
+    bool staggerStart;       // 初始计时按格子错开, 避免同类植物同时行动
+    ProjectileType projectile;
+    Fixed muzzleHeightFactor; // 发射点高于植物中心的比例 (相对植物高度)
+    bool holdUntilTarget;     // 冷却结束后一直等到有目标才开火, 开火后从 0 重新计时
+};
+
+constexpr std::size_t PLANT_TYPE_COUNT = static_cast<std::size_t>(PlantType::COUNT);
+
+constexpr auto PLANT_DESCRIPTORS = std::to_array<PlantDescriptor>({
+    {PlantType::SUNFLOWER, PlantBehavior::PRODUCE_SUN, SUNFLOWER_TEXTURE_KEY, SUNFLOWER_ICON_TEXTURE_KEY,
+     SUNFLOWER_HEALTH, SUNFLOWER_COST, SUNFLOWER_COOLDOWN_TIME, Fixed::fromFloat(SUNFLOWER_SUN_PRODUCTION_INTERVAL),
+     true, ProjectileType::PEA, Fixed(), false},
+    {PlantType::PEASHOOTER, PlantBehavior::SHOOT, PEASHOOTER_TEXTURE_KEY, PEASHOOTER_ICON_TEXTURE_KEY,
+     PEASHOOTER_HEALTH, PEASHOOTER_COST, PEASHOOTER_COOLDOWN_TIME, Fixed::fromFloat(PEASHOOTER_SHOOT_INTERVAL),
+     true, ProjectileType::PEA, Fixed::fromFloat(0.35f), false},
+    {PlantType::WALLNUT, PlantBehavior::BLOCK, WALLNUT_TEXTURE_KEY, WALLNUT_ICON_TEXTURE_KEY,
+     WALLNUT_HEALTH, WALLNUT_COST, WALLNUT_COOLDOWN_TIME, Fixed(),
+     false, ProjectileType::PEA, Fixed(), false},
+    {PlantType::ICEPEASHOOTER, PlantBehavior::SHOOT, ICE_PEASHOOTER_TEXTURE_KEY, ICE_PEASHOOTER_ICON_TEXTURE_KEY,
+     ICE_PEASHOOTER_HEALTH, ICE_PEASHOOTER_COST, ICE_PEASHOOTER_COOLDOWN_TIME, Fixed::fromFloat(ICE_PEASHOOTER_SHOOT_INTERVAL),
+     false, ProjectileType::ICE_PEA, Fixed::fromFloat(0.10f), true},
+});
+
+struct ZombieDescriptor
+{
+    ZombieType type;
+    ResourceId textureKey;
+    int health;
+    Fixed speed;
+    int damagePerAttack;
+    Fixed attackInterval;
+};
+
+constexpr std::size_t ZOMBIE_TYPE_COUNT = static_cast<std::size_t>(ZombieType::COUNT);
+
+constexpr auto ZOMBIE_DESCRIPTORS = std::to_array<ZombieDescriptor>({
+    {ZombieType::BASIC, BASIC_ZOMBIE_TEXTURE_KEY, BASIC_ZOMBIE_HEALTH, Fixed::fromFloat(BASIC_ZOMBIE_SPEED),
+     BASIC_ZOMBIE_DAMAGE_PER_ATTACK, Fixed::fromFloat(BASIC_ZOMBIE_ATTACK_INTERVAL)},
+    {ZombieType::BIG, BIG_ZOMBIE_TEXTURE_KEY, BIG_ZOMBIE_HEALTH, Fixed::fromFloat(BIG_ZOMBIE_SPEED),
+     BIG_ZOMBIE_DAMAGE_PER_ATTACK, Fixed::fromFloat(BIG_ZOMBIE_ATTACK_INTERVAL)},
+    {ZombieType::BOSS, BOSS_ZOMBIE_TEXTURE_KEY, BOSS_ZOMBIE_HEALTH, Fixed::fromFloat(BOSS_ZOMBIE_SPEED),
+     BOSS_ZOMBIE_DAMAGE_PER_ATTACK, Fixed::fromFloat(BOSS_ZOMBIE_ATTACK_INTERVAL)},
+    {ZombieType::QUICK, QUICK_ZOMBIE_TEXTURE_KEY, QUICK_ZOMBIE_HEALTH, Fixed::fromFloat(QUICK_ZOMBIE_SPEED),
+     QUICK_ZOMBIE_DAMAGE_PER_ATTACK, Fixed::fromFloat(QUICK_ZOMBIE_ATTACK_INTERVAL)},
+});
+
+// 表的行序必须与枚举值一致, 编译期检查
+template <typename Table>
+constexpr bool isIndexedByType(const Table &table)
+{
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+        if (static_cast<std::size_t>(table[i].type) != i)
+            return false;
+    }
+    return true;
+}
+static_assert(PLANT_DESCRIPTORS.size() == PLANT_TYPE_COUNT, "PLANT_DESCRIPTORS needs one row per PlantType");
+static_assert(ZOMBIE_DESCRIPTORS.size() == ZOMBIE_TYPE_COUNT, "ZOMBIE_DESCRIPTORS needs one row per ZombieType");
+static_assert(isIndexedByType(PLANT_DESCRIPTORS), "PLANT_DESCRIPTORS must be ordered by PlantType");
+static_assert(isIndexedByType(ZOMBIE_DESCRIPTORS), "ZOMBIE_DESCRIPTORS must be ordered by ZombieType");
+
+constexpr bool isValidPlantType(PlantType type)
+{
+    return static_cast<std::size_t>(type) < PLANT_TYPE_COUNT;
+}
+
+constexpr bool isValidZombieType(ZombieType type)
+{
+    return static_cast<std::size_t>(type) < ZOMBIE_TYPE_COUNT;
+}
+
+// 调用方需先保证类型有效 (来自存档/网络的值用 isValid* 检查)
+constexpr const PlantDescriptor &getPlantDescriptor(PlantType type)
+{
+    return PLANT_DESCRIPTORS[static_cast<std::size_t>(type)];
+}
+
+constexpr const ZombieDescriptor &getZombieDescriptor(ZombieType type)
+{
+    return ZOMBIE_DESCRIPTORS[static_cast<std::size_t>(type)];
+}
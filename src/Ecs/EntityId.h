@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// 实体句柄: 下标 + 代数; 实体销毁后下标可被复用, 代数递增, 旧句柄随之失效 (不会指向新实体)
+struct EntityId
+{
+    static constexpr std::uint32_t INVALID_INDEX = 0xffffffffu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    constexpr bool isValid() const { return index != INVALID_INDEX; }
+    // 打包成 64 位键 (观战实体编号映射等)
+    constexpr std::uint64_t pack() const { return (static_cast<std::uint64_t>(generation) << 32) | index; }
+
+    constexpr bool operator==(const EntityId &other) const = default;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+// 实体类型枚举; 数值会写入存档、锁步指令和观战协议, 新类型只能追加在 COUNT 之前
+
+enum class PlantType
+{
+    SUNFLOWER,
+    PEASHOOTER,
+    WALLNUT,
+    ICEPEASHOOTER,
+    COUNT // 类型数量, 不是有效类型
+};
+
+// 僵尸类型
+enum class ZombieType
+{
+    BASIC,
+    BIG,
+    BOSS,
+    QUICK,
+    COUNT // 类型数量, 不是有效类型
+};
+
+enum class ZombieState
+{
+    WALKING,
+    ATTACKING,
+    DYING,
+    DEAD
+};
+
+enum class ProjectileType
+{
+    PEA,
+    ICE_PEA
+};
+
+enum class SunSpawnType
+{
+    FROM_SKY,
+    FROM_PLANT
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Registry.h"
+#include "Components.h"
+#include "EntityDescriptors.h"
+
+// 关卡内所有实体的原型; 同一原型的实体组件完全相同, 行为差异由组件数据表达
+using SunflowerArchetype = Archetype<Transform, Visual, Health, PlantInfo, SunProducer>;
+using ShooterPlantArchetype = Archetype<Transform, Visual, Health, PlantInfo, Shooter>;
+using WallNutArchetype = Archetype<Transform, Visual, Health, PlantInfo>;
+using ZombieArchetype = Archetype<Transform, Visual, Health, ZombieInfo, ZombieBrain, Slow>;
+using PeaArchetype = Archetype<Transform, Visual, ProjectileInfo, Velocity, Lifespan>;
+using IcePeaArchetype = Archetype<Transform, Visual, ProjectileInfo, Velocity, Lifespan, SlowOnHit>;
+using SunArchetype = Archetype<Transform, Visual, SunState, SunPickCells>;
+
+// 植物行为类别 -> 原型, 工厂在编译期据此决定要初始化哪些组件
+template <PlantBehavior B>
+struct PlantArchetypeFor;
+template <>
+struct PlantArchetypeFor<PlantBehavior::PRODUCE_SUN>
+{
+    using Type = SunflowerArchetype;
+};
+template <>
+struct PlantArchetypeFor<PlantBehavior::SHOOT>
+{
+    using Type = ShooterPlantArchetype;
+};
+template <>
+struct PlantArchetypeFor<PlantBehavior::BLOCK>
+{
+    using Type = WallNutArchetype;
+};
+
+template <PlantType T>
+using PlantArchetypeOf = typename PlantArchetypeFor<getPlantDescriptor(T).behavior>::Type;
+
+using GameWorld = Registry<SunflowerArchetype,
+                           ShooterPlantArchetype,
+                           WallNutArchetype,
+                           ZombieArchetype,
+                           PeaArchetype,
+                           IcePeaArchetype,
+                           SunArchetype>;
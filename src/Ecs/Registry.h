@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Archetype.h"
+#include <cstdint>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 实体注册表: 原型列表在编译期给出, 查询按组件类型在编译期筛选出匹配的原型, 没有虚函数分派
+// 句柄 -> (原型, 行号) 的映射随 swap-and-pop 更新; 空闲下标后进先出复用
+template <typename... Archetypes>
+class Registry
+{
+public:
+    Registry() = default;
+    // 各原型的块都从 chunkResource 分配; 句柄映射表仍在普通堆上, 释放块后代数不丢失
+    explicit Registry(std::pmr::memory_resource *chunkResource) : m_archetypes(Archetypes(chunkResource)...) {}
+    template <typename A>
+    static constexpr std::size_t archetypeIndex()
+    {
+        static_assert((std::is_same_v<A, Archetypes> || ...), "Archetype is not registered");
+        std::size_t index = 0;
+        ((std::is_same_v<A, Archetypes> ? false : (++index, true)) && ...);
+        return index;
+    }
+
+    template <typename A>
+    EntityId create()
+    {
+        EntityId id;
+        if (!m_freeIndices.empty())
+        {
+            id.index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else
+        {
+            id.index = static_cast<std::uint32_t>(m_locations.size());
+            m_locations.emplace_back();
+        }
+        Location &location = m_locations[id.index];
+        id.generation = location.generation;
+        location.archetype = static_cast<std::uint8_t>(archetypeIndex<A>());
+        location.row = archetype<A>().pushBack(id);
+        location.alive = true;
+        return id;
+    }
+
+    void destroy(EntityId id)
+    {
+        if (!isAlive(id))
+            return;
+        Location &location = m_locations[id.index];
+        std::uint32_t row = location.row;
+        visit(location.archetype, [this, row](auto &arch)
+              {
+                  EntityId moved = arch.swapRemove(row);
+                  if (moved.isValid())
+                      m_locations[moved.index].row = row; });
+        location.alive = false;
+        ++location.generation;
+        m_freeIndices.push_back(id.index);
+    }
+
+    bool isAlive(EntityId id) const
+    {
+        return id.index < m_locations.size() && m_locations[id.index].alive &&
+               m_locations[id.index].generation == id.generation;
+    }
+
+    template <typename A>
+    bool is(EntityId id) const
+    {
+        return isAlive(id) && m_locations[id.index].archetype == archetypeIndex<A>();
+    }
+
+    // 实体没有该组件或已销毁时返回 nullptr
+    template <typename C>
+    C *tryGet(EntityId id)
+    {
+        if (!isAlive(id))
+            return nullptr;
+        C *component = nullptr;
+        std::uint32_t row = m_locations[id.index].row;
+        visit(m_locations[id.index].archetype, [&component, row](auto &arch)
+              {
+                  if constexpr (std::remove_reference_t<decltype(arch)>::template has<C>)
+                      component = &arch.template get<C>(row); });
+        return component;
+    }
+    template <typename C>
+    const C *tryGet(EntityId id) const
+    {
+        return const_cast<Registry *>(this)->template tryGet<C>(id);
+    }
+
+    template <typename C>
+    C &get(EntityId id) { return *tryGet<C>(id); }
+    template <typename C>
+    const C &get(EntityId id) const { return *tryGet<C>(id); }
+
+    // 直接按行遍历/读写组件用; 增删实体必须经过注册表, 否则句柄映射会失效
+    template <typename A>
+    A &archetype() { return std::get<A>(m_archetypes); }
+    template <typename A>
+    const A &archetype() const { return std::get<A>(m_archetypes); }
+
+    // 遍历所有含 Qs 组件的原型 (按原型声明顺序, 原型内按行号): fn(EntityId, Qs&...)
+    template <typename... Qs, typename Fn>
+    void each(Fn &&fn)
+    {
+        (eachIn<Archetypes, Qs...>(fn), ...);
+    }
+    template <typename... Qs, typename Fn>
+    void each(Fn &&fn) const
+    {
+        (eachIn<Archetypes, Qs...>(fn), ...);
+    }
+
+    // 含 Qs 组件的实体数
+    template <typename... Qs>
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        ((total += Archetypes::template hasAll<Qs...> ? std::get<Archetypes>(m_archetypes).size() : 0), ...);
+        return total;
+    }
+
+    // 销毁给定原型的全部实体
+    template <typename... As>
+    void destroyAll()
+    {
+        (destroyAllIn<As>(), ...);
+    }
+
+    // 销毁全部实体; 代数照常递增, 清空前拿到的句柄不会误指向之后的新实体
+    void clear()
+    {
+        (std::get<Archetypes>(m_archetypes).clear(), ...);
+        m_freeIndices.clear();
+        for (std::uint32_t index = static_cast<std::uint32_t>(m_locations.size()); index-- > 0;)
+        {
+            Location &location = m_locations[index];
+            if (location.alive)
+            {
+                location.alive = false;
+                ++location.generation;
+            }
+            m_freeIndices.push_back(index);
+        }
+    }
+
+    // clear() 并把各原型的块归还给内存资源, 之后可以整体回收该资源
+    void releaseStorage()
+    {
+        clear();
+        (std::get<Archetypes>(m_archetypes).releaseChunks(), ...);
+    }
+
+private:
+    struct Location
+    {
+        std::uint32_t generation = 0;
+        std::uint32_t row = 0;
+        std::uint8_t archetype = 0;
+        bool alive = false;
+    };
+
+    template <typename A>
+    void destroyAllIn()
+    {
+        A &arch = archetype<A>();
+        // 从末行删起, 不需要搬动其余行
+        while (!arch.empty())
+        {
+            destroy(arch.getId(arch.size() - 1));
+        }
+    }
+
+    template <typename A, typename... Qs, typename Fn>
+    void eachIn(Fn &fn)
+    {
+        if constexpr (A::template hasAll<Qs...>)
+            std::get<A>(m_archetypes).template each<Qs...>(fn);
+    }
+    template <typename A, typename... Qs, typename Fn>
+    void eachIn(Fn &fn) const
+    {
+        if constexpr (A::template hasAll<Qs...>)
+            std::get<A>(m_archetypes).template each<Qs...>(fn);
+    }
+
+    // 运行时原型编号 -> 编译期原型类型
+    template <typename Fn>
+    void visit(std::uint8_t index, Fn &&fn)
+    {
+        visitImpl(index, fn, std::index_sequence_for<Archetypes...>());
+    }
+    template <typename Fn, std::size_t... Is>
+    void visitImpl(std::uint8_t index, Fn &fn, std::index_sequence<Is...>)
+    {
+        ((index == Is ? (fn(std::get<Is>(m_archetypes)), true) : false) || ...);
+    }
+
+    std::tuple<Archetypes...> m_archetypes;
+    std::vector<Location> m_locations;
+    std::vector<std::uint32_t> m_freeIndices;
+};
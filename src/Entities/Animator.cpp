@@ -0,0 +1,93 @@
+#include "Animator.h"
+#include "../Utils/Constants.h"
+
+Animator::Animator()
+    : m_set(nullptr),
+      m_state(AnimationState::IDLE),
+      m_startTick(0),
+      m_phaseSeed(0),
+      m_frame(-1)
+{
+}
+
+void Animator::setAnimationSet(const AnimationSet *set, sf::Sprite &sprite, std::uint32_t phaseSeed)
+{
+    m_set = set;
+    m_phaseSeed = phaseSeed;
+    m_frame = -1;
+    play(m_state, sprite, true);
+}
+
+void Animator::play(AnimationState state, sf::Sprite &sprite, bool restart)
+{
+    if (!m_set)
+        return;
+    if (state == m_state && !restart && m_frame >= 0)
+        return;
+
+    m_state = state;
+    m_startTick = AnimationLibrary::getClockTick();
+    m_frame = -1;
+    update(sprite);
+}
+
+std::uint64_t Animator::getElapsedFrames(const AnimationClip &clip) const
+{
+    // 无符号相减, 时钟回绕时仍得到正确的间隔
+    std::uint32_t elapsedTicks = AnimationLibrary::getClockTick() - m_startTick;
+    // 帧率为整数, tick 数乘帧率在 double 中精确, 再做整数除法: 不受浮点优化选项影响 (帧矩形决定碰撞包围盒)
+    std::uint64_t frameTicks = static_cast<std::uint64_t>(static_cast<double>(elapsedTicks) * clip.fps);
+    return frameTicks / static_cast<std::uint64_t>(TARGET_FPS);
+}
+
+int Animator::computeFrame(const AnimationClip &clip) const
+{
+    int frameCount = static_cast<int>(clip.frames.size());
+    if (frameCount <= 1 || clip.fps <= 0.f)
+        return 0;
+
+    std::uint64_t elapsedFrames = getElapsedFrames(clip);
+    if (clip.loop)
+    {
+        std::uint64_t phase = (m_phaseSeed >> 16) % static_cast<std::uint32_t>(frameCount);
+        return static_cast<int>((elapsedFrames + phase) % static_cast<std::uint64_t>(frameCount));
+    }
+    return elapsedFrames < static_cast<std::uint64_t>(frameCount) ? static_cast<int>(elapsedFrames) : frameCount - 1;
+}
+
+bool Animator::isFinished() const
+{
+    if (!m_set)
+        return true;
+    const AnimationClip &clip = m_set->getClip(m_state);
+    if (clip.loop)
+        return false;
+    if (clip.fps <= 0.f)
+        return true;
+    return getElapsedFrames(clip) >= clip.frames.size();
+}
+
+void Animator::update(sf::Sprite &sprite)
+{
+    if (!m_set)
+        return;
+
+    // 一次性动画 (如射击) 播完回到 IDLE, 死亡动画停在最后一帧
+    if (m_state != AnimationState::IDLE && m_state != AnimationState::DIE && isFinished())
+    {
+        m_state = AnimationState::IDLE;
+        m_startTick = AnimationLibrary::getClockTick();
+        m_frame = -1;
+    }
+
+    const AnimationClip &clip = m_set->getClip(m_state);
+    if (clip.frames.empty())
+        return;
+
+    int frame = computeFrame(clip);
+    if (frame != m_frame)
+    {
+        m_frame = frame;
+        sprite.setTextureRect(clip.frames[frame]);
+    }
+}
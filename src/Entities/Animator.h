@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../Systems/AnimationLibrary.h"
+#include <SFML/Graphics/Sprite.hpp>
+#include <cstdint>
+
+// 实体的动画播放状态: 只记录当前动画、开始 tick 和相位偏移,
+// 帧号由共享时钟算出, 帧变化时才更新精灵的纹理矩形 (只改 UV)
+class Animator
+{
+public:
+    Animator();
+
+    // phaseSeed 由调用方按实体句柄给出, 不用全局随机数, 保证可重放
+    void setAnimationSet(const AnimationSet *set, sf::Sprite &sprite, std::uint32_t phaseSeed);
+    void play(AnimationState state, sf::Sprite &sprite, bool restart = false);
+    void update(sf::Sprite &sprite);
+
+    bool hasAnimation() const { return m_set != nullptr; }
+    AnimationState getState() const { return m_state; }
+    bool isFinished() const;
+
+private:
+    int computeFrame(const AnimationClip &clip) const;
+    // 当前动画已播放的帧数 (未对帧数取模)
+    std::uint64_t getElapsedFrames(const AnimationClip &clip) const;
+
+    const AnimationSet *m_set;
+    AnimationState m_state;
+    std::uint32_t m_startTick;
+    std::uint32_t m_phaseSeed; // 对帧数取模得到循环动画的起始帧, 让同类实体错开
+    int m_frame;
+};
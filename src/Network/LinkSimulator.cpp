@@ -0,0 +1,53 @@
+#include "LinkSimulator.h"
+#include <algorithm>
+#include <chrono>
+
+LinkSimulator::LinkSimulator(float lossPercent, float latencyMs, float jitterMs)
+    : m_lossPercent(std::max(0.f, lossPercent)),
+      m_latencyMs(std::max(0.f, latencyMs)),
+      m_jitterMs(std::max(0.f, jitterMs)),
+      m_rng(static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())),
+      m_droppedCount(0)
+{
+}
+
+void LinkSimulator::send(sf::UdpSocket &socket, const sf::Packet &packet, const sf::IpAddress &address, unsigned short port)
+{
+    if (!isActive())
+    {
+        socket.send(packet.getData(), packet.getDataSize(), address, port);
+        return;
+    }
+
+    if (m_rng.nextFloat(0.f, 100.f) < m_lossPercent)
+    {
+        m_droppedCount++;
+        return;
+    }
+
+    PendingDatagram datagram;
+    float delayMs = m_latencyMs + m_rng.nextFloat(0.f, m_jitterMs);
+    datagram.releaseTime = m_clock.getElapsedTime() + sf::milliseconds(static_cast<sf::Int32>(delayMs));
+    const char *bytes = static_cast<const char *>(packet.getData());
+    datagram.data.assign(bytes, bytes + packet.getDataSize());
+    datagram.address = address;
+    datagram.port = port;
+    m_pending.push_back(std::move(datagram));
+}
+
+void LinkSimulator::flush(sf::UdpSocket &socket)
+{
+    if (m_pending.empty())
+        return;
+
+    // 抖动可能让后入队的包先到期, 与真实网络一样允许乱序
+    sf::Time now = m_clock.getElapsedTime();
+    auto firstDue = std::stable_partition(m_pending.begin(), m_pending.end(),
+                                          [now](const PendingDatagram &datagram)
+                                          { return datagram.releaseTime > now; });
+    for (auto it = firstDue; it != m_pending.end(); ++it)
+    {
+        socket.send(it->data.data(), it->data.size(), it->address, it->port);
+    }
+    m_pending.erase(firstDue, m_pending.end());
+}
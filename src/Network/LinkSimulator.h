@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../Utils/GameRandom.h"
+#include <SFML/Network.hpp>
+#include <vector>
+
+// 出站链路模拟: 按配置随机丢包, 再加固定延迟和抖动后才真正发出
+// 丢包率和延迟都为 0 时直接发送
+class LinkSimulator
+{
+public:
+    LinkSimulator(float lossPercent, float latencyMs, float jitterMs);
+
+    void send(sf::UdpSocket &socket, const sf::Packet &packet, const sf::IpAddress &address, unsigned short port);
+    // 发出已到期的包, 每次更新调用
+    void flush(sf::UdpSocket &socket);
+
+    bool isActive() const { return m_lossPercent > 0.f || m_latencyMs > 0.f || m_jitterMs > 0.f; }
+    unsigned getDroppedCount() const { return m_droppedCount; }
+
+private:
+    struct PendingDatagram
+    {
+        sf::Time releaseTime;
+        std::vector<char> data;
+        sf::IpAddress address;
+        unsigned short port;
+    };
+
+    float m_lossPercent;
+    float m_latencyMs;
+    float m_jitterMs;
+    sf::Clock m_clock;
+    GameRandom m_rng;
+    std::vector<PendingDatagram> m_pending;
+    unsigned m_droppedCount;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../Utils/Constants.h"
+#include <SFML/Network/IpAddress.hpp>
+
+enum class LockstepRole
+{
+    NONE, // 单人
+    HOST, // 玩家 1, 等待连接并下发关卡初始快照
+    CLIENT // 玩家 2, 连接主机
+};
+
+// 双人合作锁步联机的启动参数 (命令行 --host / --join 指定)
+struct LockstepConfig
+{
+    LockstepRole role = LockstepRole::NONE;
+    unsigned short localPort = 0;
+    sf::IpAddress remoteAddress = sf::IpAddress::None;
+    unsigned short remotePort = 0;
+    int inputDelayTicks = COOP_DEFAULT_INPUT_DELAY_TICKS;
+
+    // 出站链路模拟, 本机回环测试丢包/延迟用
+    float simulatedLossPercent = 0.f;
+    float simulatedLatencyMs = 0.f;
+    float simulatedJitterMs = 0.f;
+
+    bool isEnabled() const { return role != LockstepRole::NONE; }
+    int getLocalPlayer() const { return role == LockstepRole::CLIENT ? 1 : 0; }
+};
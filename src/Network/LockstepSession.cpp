@@ -0,0 +1,465 @@
+#include "LockstepSession.h"
+#include <algorithm>
+#include <iostream>
+#include <ostream>
+
+namespace
+{
+    const std::size_t MAX_LOCAL_CHECKSUMS = 64;
+
+    void writeCommand(sf::Packet &packet, const PlayerCommand &command)
+    {
+        packet << static_cast<sf::Uint8>(command.type)
+               << static_cast<sf::Uint8>(command.plantType)
+               << static_cast<sf::Int32>(command.amount)
+               << static_cast<sf::Int16>(command.gridPos.x)
+               << static_cast<sf::Int16>(command.gridPos.y)
+               << command.worldPos.x << command.worldPos.y;
+    }
+
+    bool readCommand(sf::Packet &packet, PlayerCommand &command)
+    {
+        sf::Uint8 type = 0;
+        sf::Uint8 plantType = 0;
+        sf::Int32 amount = 0;
+        sf::Int16 gridX = 0;
+        sf::Int16 gridY = 0;
+        float worldX = 0.f;
+        float worldY = 0.f;
+        if (!(packet >> type >> plantType >> amount >> gridX >> gridY >> worldX >> worldY))
+            return false;
+        command.type = static_cast<PlayerCommandType>(type);
+        command.plantType = static_cast<PlantType>(plantType);
+        command.amount = amount;
+        command.gridPos = sf::Vector2i(gridX, gridY);
+        command.worldPos = sf::Vector2f(worldX, worldY);
+        return true;
+    }
+}
+
+LockstepSession::LockstepSession(const LockstepConfig &config)
+    : m_config(config),
+      m_link(config.simulatedLossPercent, config.simulatedLatencyMs, config.simulatedJitterMs),
+      m_peerAddress(config.remoteAddress),
+      m_peerPort(config.remotePort),
+      m_started(false),
+      m_disconnected(false),
+      m_startSnapshotPending(false),
+      m_startChunksMissing(0),
+      m_localClosedTick(0),
+      m_remoteAckedTick(0),
+      m_remoteContiguousTick(0),
+      m_nextSimTick(0),
+      m_remoteChecksum(0, 0),
+      m_desyncTick(0),
+      m_verifiedTick(0),
+      m_bytesSentWindow(0),
+      m_bytesReceivedWindow(0),
+      m_sendRate(0.f),
+      m_receiveRate(0.f),
+      m_stallTicks(0)
+{
+    // 延迟至少 1 tick; 开头 delay 个 tick 双方都没有输入, 视为已到齐的空帧
+    m_config.inputDelayTicks = std::max(1, m_config.inputDelayTicks);
+    m_localClosedTick = m_config.inputDelayTicks - 1;
+    m_remoteAckedTick = m_localClosedTick;
+    m_remoteContiguousTick = m_localClosedTick;
+}
+
+bool LockstepSession::open()
+{
+    unsigned short port = (m_config.role == LockstepRole::HOST) ? static_cast<unsigned short>(m_config.localPort)
+                                                                  : static_cast<unsigned short>(sf::Socket::AnyPort);
+    if (m_socket.bind(port) != sf::Socket::Done)
+    {
+        std::cerr << "LockstepSession: Failed to bind UDP port " << port << "." << std::endl;
+        return false;
+    }
+    m_socket.setBlocking(false);
+    std::cout << "LockstepSession: " << (m_config.role == LockstepRole::HOST ? "Hosting" : "Joining")
+              << " on UDP port " << m_socket.getLocalPort() << ", input delay " << m_config.inputDelayTicks << " ticks";
+    if (m_link.isActive())
+    {
+        std::cout << " (simulated loss " << m_config.simulatedLossPercent << "%, latency "
+                  << m_config.simulatedLatencyMs << "+" << m_config.simulatedJitterMs << " ms)";
+    }
+    std::cout << "." << std::endl;
+    return true;
+}
+
+void LockstepSession::setStartSnapshot(const std::vector<std::uint8_t> &snapshot)
+{
+    m_startSnapshot = snapshot;
+}
+
+bool LockstepSession::takeStartSnapshot(std::vector<std::uint8_t> &outSnapshot)
+{
+    if (!m_startSnapshotPending)
+        return false;
+    m_startSnapshotPending = false;
+    outSnapshot.swap(m_startSnapshot);
+    m_startSnapshot.clear();
+    return true;
+}
+
+void LockstepSession::poll()
+{
+    sf::Packet packet;
+    sf::IpAddress sender;
+    unsigned short senderPort = 0;
+    while (m_socket.receive(packet, sender, senderPort) == sf::Socket::Done)
+    {
+        m_bytesReceivedWindow += packet.getDataSize();
+        sf::Uint8 type = 0;
+        sf::Uint32 magic = 0;
+        if (!(packet >> type >> magic) || magic != COOP_PROTOCOL_MAGIC)
+            continue;
+        // 主机认定第一个握手的地址为对方, 之后忽略其他来源
+        if (m_started && (sender != m_peerAddress || senderPort != m_peerPort))
+            continue;
+
+        m_lastReceiveClock.restart();
+        switch (static_cast<PacketType>(type))
+        {
+        case PacketType::HELLO:
+            handleHello(packet, sender, senderPort);
+            break;
+        case PacketType::START:
+            handleStart(packet);
+            break;
+        case PacketType::INPUT:
+            handleInput(packet);
+            break;
+        }
+    }
+
+    if (m_started && !m_disconnected && m_lastReceiveClock.getElapsedTime().asSeconds() > COOP_TIMEOUT_SECONDS)
+    {
+        m_disconnected = true;
+        std::cerr << "LockstepSession: No packets from peer for " << COOP_TIMEOUT_SECONDS << "s, connection lost." << std::endl;
+    }
+}
+
+void LockstepSession::flush()
+{
+    if (m_config.role == LockstepRole::CLIENT && !m_started)
+    {
+        if (m_helloClock.getElapsedTime().asSeconds() >= COOP_HELLO_RESEND_SECONDS)
+        {
+            m_helloClock.restart();
+            sendHello();
+        }
+    }
+    else if (m_started && !m_disconnected)
+    {
+        if (!isTickReady(m_nextSimTick))
+            m_stallTicks++;
+        sendInput();
+    }
+    m_link.flush(m_socket);
+    updateBandwidth();
+}
+
+void LockstepSession::queueLocalCommand(PlayerCommand command)
+{
+    command.tick = m_localClosedTick + 1;
+    command.player = static_cast<std::uint8_t>(getLocalPlayer());
+    m_pendingLocalCommands.push_back(command);
+}
+
+bool LockstepSession::isTickReady(std::uint32_t tick) const
+{
+    return m_started && !m_disconnected && tick <= m_localClosedTick && tick <= m_remoteContiguousTick;
+}
+
+void LockstepSession::takeCommandsForTick(std::uint32_t tick, std::vector<PlayerCommand> &outCommands)
+{
+    outCommands.clear();
+    auto localIt = m_localFrames.find(tick);
+    auto remoteIt = m_remoteFrames.find(tick);
+    const std::vector<PlayerCommand> *first = (localIt != m_localFrames.end()) ? &localIt->second : nullptr;
+    const std::vector<PlayerCommand> *second = (remoteIt != m_remoteFrames.end()) ? &remoteIt->second : nullptr;
+    if (getLocalPlayer() != 0)
+        std::swap(first, second);
+    if (first)
+        outCommands.insert(outCommands.end(), first->begin(), first->end());
+    if (second)
+        outCommands.insert(outCommands.end(), second->begin(), second->end());
+
+    if (remoteIt != m_remoteFrames.end())
+        m_remoteFrames.erase(remoteIt);
+}
+
+void LockstepSession::onTickSimulated(std::uint32_t simTick)
+{
+    m_nextSimTick = simTick;
+    std::uint32_t closeUpTo = simTick + static_cast<std::uint32_t>(m_config.inputDelayTicks) - 1;
+    while (m_localClosedTick < closeUpTo)
+    {
+        ++m_localClosedTick;
+        if (!m_pendingLocalCommands.empty())
+        {
+            for (PlayerCommand &command : m_pendingLocalCommands)
+                command.tick = m_localClosedTick;
+            m_localFrames[m_localClosedTick].swap(m_pendingLocalCommands);
+            m_pendingLocalCommands.clear();
+        }
+    }
+    // 对方已确认且本地已执行的帧不再需要
+    while (!m_localFrames.empty() && m_localFrames.begin()->first <= m_remoteAckedTick &&
+           m_localFrames.begin()->first < m_nextSimTick)
+    {
+        m_localFrames.erase(m_localFrames.begin());
+    }
+}
+
+void LockstepSession::recordChecksum(std::uint32_t tick, std::uint32_t checksum)
+{
+    m_localChecksums.emplace_back(tick, checksum);
+    if (m_localChecksums.size() > MAX_LOCAL_CHECKSUMS)
+        m_localChecksums.pop_front();
+    compareChecksum(m_remoteChecksum.first, m_remoteChecksum.second);
+}
+
+std::uint32_t LockstepSession::computeChecksum(const std::vector<std::uint8_t> &data)
+{
+    // FNV-1a
+    std::uint32_t hash = 2166136261u;
+    for (std::uint8_t byte : data)
+    {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void LockstepSession::writeStatsText(std::ostream &out) const
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(1);
+    out << std::fixed;
+    out << "Co-op P" << (getLocalPlayer() + 1) << ": ";
+    if (m_disconnected)
+        out << "DISCONNECTED";
+    else if (!m_started)
+        out << "waiting for peer";
+    else
+        out << "delay " << m_config.inputDelayTicks << " | remote tick " << m_remoteContiguousTick
+            << " | stalls " << m_stallTicks;
+    out << " | up " << m_sendRate / 1024.f << " KB/s down " << m_receiveRate / 1024.f << " KB/s";
+    if (m_link.isActive())
+        out << " | sim dropped " << m_link.getDroppedCount();
+    if (m_desyncTick != 0)
+        out << " | DESYNC @" << m_desyncTick;
+    else if (m_verifiedTick != 0)
+        out << " | in sync @" << m_verifiedTick;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void LockstepSession::sendHello()
+{
+    sf::Packet packet;
+    packet << static_cast<sf::Uint8>(PacketType::HELLO) << COOP_PROTOCOL_MAGIC << COOP_PROTOCOL_VERSION;
+    sendPacket(packet);
+}
+
+void LockstepSession::sendStart()
+{
+    // 快照按 COOP_START_CHUNK_BYTES 分块, 每块单独一个包; 丢块时客户端继续握手, 主机整体重发
+    std::size_t totalSize = m_startSnapshot.size();
+    std::size_t chunkCount = std::max<std::size_t>(1, (totalSize + COOP_START_CHUNK_BYTES - 1) / COOP_START_CHUNK_BYTES);
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        std::size_t offset = chunk * COOP_START_CHUNK_BYTES;
+        std::size_t length = std::min<std::size_t>(COOP_START_CHUNK_BYTES, totalSize - offset);
+        sf::Packet packet;
+        packet << static_cast<sf::Uint8>(PacketType::START) << COOP_PROTOCOL_MAGIC
+               << static_cast<sf::Uint8>(m_config.inputDelayTicks)
+               << static_cast<sf::Uint32>(totalSize)
+               << static_cast<sf::Uint16>(chunk)
+               << static_cast<sf::Uint16>(chunkCount);
+        packet.append(m_startSnapshot.data() + offset, length);
+        sendPacket(packet);
+    }
+}
+
+void LockstepSession::sendInput()
+{
+    // 重发对方还没确认的全部帧, 空帧只占 1 字节
+    std::uint32_t firstTick = m_remoteAckedTick + 1;
+    std::uint32_t lastTick = std::min(m_localClosedTick, m_remoteAckedTick + COOP_MAX_TICKS_PER_PACKET);
+
+    sf::Packet packet;
+    packet << static_cast<sf::Uint8>(PacketType::INPUT) << COOP_PROTOCOL_MAGIC
+           << static_cast<sf::Uint32>(m_remoteContiguousTick)
+           << static_cast<sf::Uint32>(firstTick)
+           << static_cast<sf::Uint16>(lastTick >= firstTick ? lastTick - firstTick + 1 : 0);
+    for (std::uint32_t tick = firstTick; tick <= lastTick; ++tick)
+    {
+        auto it = m_localFrames.find(tick);
+        if (it == m_localFrames.end())
+        {
+            packet << static_cast<sf::Uint8>(0);
+            continue;
+        }
+        packet << static_cast<sf::Uint8>(it->second.size());
+        for (const PlayerCommand &command : it->second)
+            writeCommand(packet, command);
+    }
+
+    std::pair<std::uint32_t, std::uint32_t> latest = m_localChecksums.empty() ? std::make_pair(0u, 0u) : m_localChecksums.back();
+    packet << static_cast<sf::Uint32>(latest.first) << static_cast<sf::Uint32>(latest.second);
+    sendPacket(packet);
+}
+
+void LockstepSession::sendPacket(sf::Packet &packet)
+{
+    if (m_peerAddress == sf::IpAddress::None || m_peerPort == 0)
+        return;
+    m_bytesSentWindow += packet.getDataSize();
+    m_link.send(m_socket, packet, m_peerAddress, m_peerPort);
+}
+
+void LockstepSession::handleHello(sf::Packet &packet, const sf::IpAddress &sender, unsigned short senderPort)
+{
+    sf::Uint16 version = 0;
+    if (m_config.role != LockstepRole::HOST || !(packet >> version))
+        return;
+    if (version != COOP_PROTOCOL_VERSION)
+    {
+        std::cerr << "LockstepSession: Rejected peer " << sender.toString() << " with protocol version " << version << "." << std::endl;
+        return;
+    }
+    if (!m_started)
+    {
+        m_peerAddress = sender;
+        m_peerPort = senderPort;
+        m_started = true;
+        std::cout << "LockstepSession: Player 2 joined from " << sender.toString() << ":" << senderPort << "." << std::endl;
+    }
+    // 客户端还在握手说明 START 丢了, 重发
+    sendStart();
+}
+
+void LockstepSession::handleStart(sf::Packet &packet)
+{
+    sf::Uint8 delay = 0;
+    sf::Uint32 size = 0;
+    sf::Uint16 chunk = 0;
+    sf::Uint16 chunkCount = 0;
+    if (m_config.role != LockstepRole::CLIENT || m_started || !(packet >> delay >> size >> chunk >> chunkCount))
+        return;
+    std::size_t expectedChunks = std::max<std::size_t>(1, (size + COOP_START_CHUNK_BYTES - 1) / COOP_START_CHUNK_BYTES);
+    if (chunkCount != expectedChunks || chunk >= chunkCount)
+        return;
+    std::size_t chunkOffset = static_cast<std::size_t>(chunk) * COOP_START_CHUNK_BYTES;
+    std::size_t chunkLength = std::min<std::size_t>(COOP_START_CHUNK_BYTES, size - chunkOffset);
+    std::size_t offset = packet.getReadPosition();
+    if (offset + chunkLength != packet.getDataSize())
+        return;
+
+    // 第一个块 (或主机换了快照) 时按总大小重新开始拼装
+    if (m_startSnapshot.size() != size || m_startChunksReceived.size() != chunkCount)
+    {
+        m_startSnapshot.assign(size, 0);
+        m_startChunksReceived.assign(chunkCount, false);
+        m_startChunksMissing = chunkCount;
+    }
+    if (m_startChunksReceived[chunk])
+        return;
+    const std::uint8_t *bytes = static_cast<const std::uint8_t *>(packet.getData()) + offset;
+    std::copy(bytes, bytes + chunkLength, m_startSnapshot.begin() + static_cast<std::ptrdiff_t>(chunkOffset));
+    m_startChunksReceived[chunk] = true;
+    if (--m_startChunksMissing != 0)
+        return;
+
+    m_startChunksReceived.clear();
+    m_startSnapshotPending = true;
+
+    // 采用主机的输入延迟, 双方的空白起始帧必须一致
+    m_config.inputDelayTicks = std::max(1, static_cast<int>(delay));
+    m_localClosedTick = m_config.inputDelayTicks - 1;
+    m_remoteAckedTick = m_localClosedTick;
+    m_remoteContiguousTick = m_localClosedTick;
+    m_started = true;
+    std::cout << "LockstepSession: Joined host, start snapshot " << size << " bytes, input delay " << m_config.inputDelayTicks << " ticks." << std::endl;
+}
+
+void LockstepSession::handleInput(sf::Packet &packet)
+{
+    sf::Uint32 ackTick = 0;
+    sf::Uint32 firstTick = 0;
+    sf::Uint16 count = 0;
+    if (!m_started || !(packet >> ackTick >> firstTick >> count))
+        return;
+
+    m_remoteAckedTick = std::max(m_remoteAckedTick, static_cast<std::uint32_t>(ackTick));
+    for (sf::Uint16 i = 0; i < count; ++i)
+    {
+        std::uint32_t tick = firstTick + i;
+        sf::Uint8 commandCount = 0;
+        if (!(packet >> commandCount))
+            return;
+        std::vector<PlayerCommand> commands(commandCount);
+        for (PlayerCommand &command : commands)
+        {
+            if (!readCommand(packet, command))
+                return;
+            command.tick = tick;
+            command.player = static_cast<std::uint8_t>(1 - getLocalPlayer());
+        }
+        // 重复收到的帧 (冗余重发) 直接丢弃
+        if (tick > m_remoteContiguousTick && m_remoteFrames.find(tick) == m_remoteFrames.end())
+        {
+            m_remoteFrames[tick] = std::move(commands);
+        }
+    }
+    // 空帧不占 map 项, 包内的帧是连续的, 与已收到的部分衔接上就整体推进
+    if (count > 0 && firstTick <= m_remoteContiguousTick + 1)
+    {
+        m_remoteContiguousTick = std::max(m_remoteContiguousTick, static_cast<std::uint32_t>(firstTick + count - 1));
+    }
+
+    sf::Uint32 checksumTick = 0;
+    sf::Uint32 checksum = 0;
+    if (packet >> checksumTick >> checksum && checksumTick != 0)
+    {
+        m_remoteChecksum = std::make_pair(checksumTick, checksum);
+        compareChecksum(checksumTick, checksum);
+    }
+}
+
+void LockstepSession::compareChecksum(std::uint32_t tick, std::uint32_t checksum)
+{
+    if (tick == 0 || m_desyncTick != 0)
+        return;
+    for (const auto &entry : m_localChecksums)
+    {
+        if (entry.first != tick)
+            continue;
+        if (entry.second != checksum)
+        {
+            m_desyncTick = tick;
+            std::cerr << "LockstepSession: DESYNC detected at tick " << tick << " (local " << std::hex << entry.second
+                      << ", remote " << checksum << std::dec << ")." << std::endl;
+        }
+        else
+        {
+            m_verifiedTick = std::max(m_verifiedTick, tick);
+        }
+        return;
+    }
+}
+
+void LockstepSession::updateBandwidth()
+{
+    float elapsed = m_bandwidthClock.getElapsedTime().asSeconds();
+    if (elapsed < 1.f)
+        return;
+    m_sendRate = m_bytesSentWindow / elapsed;
+    m_receiveRate = m_bytesReceivedWindow / elapsed;
+    m_bytesSentWindow = 0;
+    m_bytesReceivedWindow = 0;
+    m_bandwidthClock.restart();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "LockstepConfig.h"
+#include "LinkSimulator.h"
+#include "../Systems/PlayerCommand.h"
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 双人合作的确定性锁步会话 (UDP)
+// 只同步玩家操作: 本地操作延后 inputDelay 个 tick 生效, 每个 tick 等双方输入到齐才推进模拟
+// 每个包重发对方尚未确认的全部输入帧以抵抗丢包, 定期交换状态校验和检测不同步
+class LockstepSession
+{
+public:
+    explicit LockstepSession(const LockstepConfig &config);
+
+    // 绑定端口, 失败时返回 false
+    bool open();
+
+    // 主机: 关卡初始快照, 握手成功后发给客户端作为双方共同的起点
+    void setStartSnapshot(const std::vector<std::uint8_t> &snapshot);
+    // 客户端: 收到主机的起始快照后取出一次
+    bool takeStartSnapshot(std::vector<std::uint8_t> &outSnapshot);
+
+    // 收取并处理所有已到达的包
+    void poll();
+    // 发送握手/输入包, 每次更新调用 (模拟停顿时也要继续发, 对方靠它补齐丢失的输入)
+    void flush();
+
+    bool isStarted() const { return m_started; }
+    bool isDisconnected() const { return m_disconnected; }
+    bool hasDesync() const { return m_desyncTick != 0; }
+    int getLocalPlayer() const { return m_config.getLocalPlayer(); }
+    LockstepRole getRole() const { return m_config.role; }
+
+    // 本地操作: 填入生效 tick 和玩家编号后排队, 下一次关闭输入帧时发出
+    void queueLocalCommand(PlayerCommand command);
+    // tick 的双方输入是否都已到齐
+    bool isTickReady(std::uint32_t tick) const;
+    // 取出 tick 的全部操作 (玩家 0 在前, 保证两端执行顺序一致)
+    void takeCommandsForTick(std::uint32_t tick, std::vector<PlayerCommand> &outCommands);
+    // 模拟推进到 simTick 后调用, 关闭本地下一个输入帧
+    void onTickSimulated(std::uint32_t simTick);
+
+    void recordChecksum(std::uint32_t tick, std::uint32_t checksum);
+    static std::uint32_t computeChecksum(const std::vector<std::uint8_t> &data);
+
+    // 写进调用方的流, 不生成临时字符串; 浮点格式用完即恢复
+    void writeStatsText(std::ostream &out) const;
+
+private:
+    enum class PacketType : sf::Uint8
+    {
+        HELLO,
+        START,
+        INPUT
+    };
+
+    void sendHello();
+    void sendStart();
+    void sendInput();
+    void sendPacket(sf::Packet &packet);
+    void handleHello(sf::Packet &packet, const sf::IpAddress &sender, unsigned short senderPort);
+    void handleStart(sf::Packet &packet);
+    void handleInput(sf::Packet &packet);
+    void compareChecksum(std::uint32_t tick, std::uint32_t checksum);
+    void updateBandwidth();
+
+    LockstepConfig m_config;
+    sf::UdpSocket m_socket;
+    LinkSimulator m_link;
+    sf::IpAddress m_peerAddress;
+    unsigned short m_peerPort;
+
+    bool m_started;
+    bool m_disconnected;
+    std::vector<std::uint8_t> m_startSnapshot;
+    bool m_startSnapshotPending;
+    // 客户端: 起始快照分块到达, 记录已收到的块
+    std::vector<bool> m_startChunksReceived;
+    std::size_t m_startChunksMissing;
+    sf::Clock m_helloClock;
+    sf::Clock m_lastReceiveClock;
+
+    // 本地输入: 已关闭的帧保留到对方确认且本地已执行
+    std::map<std::uint32_t, std::vector<PlayerCommand>> m_localFrames;
+    std::vector<PlayerCommand> m_pendingLocalCommands;
+    std::uint32_t m_localClosedTick;
+    std::uint32_t m_remoteAckedTick; // 对方已连续收到的本地帧
+
+    // 远端输入
+    std::map<std::uint32_t, std::vector<PlayerCommand>> m_remoteFrames;
+    std::uint32_t m_remoteContiguousTick;
+    std::uint32_t m_nextSimTick;
+
+    // 校验和: 本地最近若干个, 以及对方最新的一个
+    std::deque<std::pair<std::uint32_t, std::uint32_t>> m_localChecksums;
+    std::pair<std::uint32_t, std::uint32_t> m_remoteChecksum;
+    std::uint32_t m_desyncTick;
+    std::uint32_t m_verifiedTick;
+
+    // 带宽统计 (每秒刷新一次)
+    sf::Clock m_bandwidthClock;
+    std::size_t m_bytesSentWindow;
+    std::size_t m_bytesReceivedWindow;
+    float m_sendRate;
+    float m_receiveRate;
+    unsigned m_stallTicks;
+};
@@ -0,0 +1,98 @@
+#include "MetricsServer.h"
+#include "../Utils/MetricsRegistry.h"
+#include "../Utils/Constants.h"
+#include <iostream>
+#include <string>
+
+MetricsServer::MetricsServer(const MetricsRegistry &registry, unsigned short port)
+    : m_registryRef(registry),
+      m_port(port),
+      m_running(false),
+      m_requestsServed(0)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+bool MetricsServer::start()
+{
+    // 只监听本机回环地址, 指标不对外暴露
+    if (m_listener.listen(m_port, sf::IpAddress::LocalHost) != sf::Socket::Done)
+    {
+        std::cerr << "MetricsServer: Failed to listen on TCP port " << m_port << "." << std::endl;
+        return false;
+    }
+    m_running = true;
+    m_thread = std::thread(&MetricsServer::run, this);
+    std::cout << "MetricsServer: Serving metrics on http://127.0.0.1:" << m_port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    if (!m_running)
+        return;
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    m_listener.close();
+    std::cout << "MetricsServer: Stopped after " << m_requestsServed.load() << " requests." << std::endl;
+}
+
+void MetricsServer::run()
+{
+    sf::SocketSelector selector;
+    selector.add(m_listener);
+    while (m_running)
+    {
+        // 限时等待, 便于及时响应 stop()
+        if (!selector.wait(sf::milliseconds(METRICS_THREAD_WAIT_MS)))
+            continue;
+
+        sf::TcpSocket client;
+        if (m_listener.accept(client) != sf::Socket::Done)
+            continue;
+        serveClient(client);
+        client.disconnect();
+    }
+}
+
+void MetricsServer::serveClient(sf::TcpSocket &client)
+{
+    // 读到请求头结束为止; 客户端迟迟不发数据时超时放弃, 不能卡住服务线程
+    sf::SocketSelector selector;
+    selector.add(client);
+    std::string request;
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < METRICS_MAX_REQUEST_BYTES)
+    {
+        if (!selector.wait(sf::milliseconds(METRICS_REQUEST_TIMEOUT_MS)))
+            return;
+        char buffer[512];
+        std::size_t received = 0;
+        if (client.receive(buffer, sizeof(buffer), received) != sf::Socket::Done)
+            return;
+        request.append(buffer, received);
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0)
+    {
+        body = m_registryRef.renderText();
+    }
+    else
+    {
+        status = "404 Not Found";
+        body = "Only GET /metrics is served.\n";
+    }
+
+    std::string response = "HTTP/1.0 " + status + "\r\n"
+                           "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+    client.send(response.data(), response.size());
+    m_requestsServed++;
+}
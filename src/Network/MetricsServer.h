@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <atomic>
+#include <thread>
+
+class MetricsRegistry;
+
+// 指标导出服务: 后台线程在本机 TCP 端口上应答 HTTP 请求, 返回注册表的 Prometheus 文本格式
+// 每个连接一问一答后关闭; 主线程只负责启动/停止, 不参与网络收发
+class MetricsServer
+{
+public:
+    MetricsServer(const MetricsRegistry &registry, unsigned short port);
+    ~MetricsServer();
+
+    bool start();
+    void stop();
+
+private:
+    void run();
+    void serveClient(sf::TcpSocket &client);
+
+    const MetricsRegistry &m_registryRef;
+    unsigned short m_port;
+    sf::TcpListener m_listener;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<unsigned> m_requestsServed;
+};
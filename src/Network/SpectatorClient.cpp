@@ -0,0 +1,201 @@
+#include "SpectatorClient.h"
+#include "../Utils/DeltaCodec.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+SpectatorClient::SpectatorClient()
+    : m_connected(false),
+      m_readOffset(0),
+      m_hasBase(false),
+      m_resyncPending(false),
+      m_hasFrame(false),
+      m_framesReceived(0),
+      m_decodeErrors(0),
+      m_bytesReceived(0)
+{
+}
+
+bool SpectatorClient::connect(const sf::IpAddress &address, unsigned short port, sf::Time timeout)
+{
+    if (m_socket.connect(address, port, timeout) != sf::Socket::Done)
+    {
+        std::cerr << "SpectatorClient: Could not connect to " << address.toString() << ":" << port << "." << std::endl;
+        return false;
+    }
+    m_socket.setBlocking(false);
+    m_connected = true;
+    return true;
+}
+
+bool SpectatorClient::poll()
+{
+    if (!m_connected)
+        return false;
+
+    char chunk[16384];
+    while (true)
+    {
+        std::size_t received = 0;
+        sf::Socket::Status status = m_socket.receive(chunk, sizeof(chunk), received);
+        if (received > 0)
+        {
+            m_receiveBuffer.insert(m_receiveBuffer.end(), chunk, chunk + received);
+            m_bytesReceived += received;
+        }
+        if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+        {
+            m_connected = false;
+            break;
+        }
+        if (status != sf::Socket::Done)
+            break;
+    }
+
+    bool newFrame = false;
+    while (m_receiveBuffer.size() - m_readOffset >= 4)
+    {
+        std::uint32_t length = 0;
+        std::memcpy(&length, m_receiveBuffer.data() + m_readOffset, sizeof(length));
+        if (length < 5)
+        {
+            // 流已错位, 无法恢复
+            std::cerr << "SpectatorClient: Corrupt stream, disconnecting." << std::endl;
+            m_connected = false;
+            m_socket.disconnect();
+            break;
+        }
+        if (m_receiveBuffer.size() - m_readOffset < 4 + static_cast<std::size_t>(length))
+            break;
+
+        const std::uint8_t *message = m_receiveBuffer.data() + m_readOffset + 4;
+        std::uint32_t tick = 0;
+        std::memcpy(&tick, message + 1, sizeof(tick));
+        if (handleMessage(static_cast<SpectatorMessageType>(message[0]), tick, message + 5, length - 5))
+            newFrame = true;
+        m_readOffset += 4 + length;
+    }
+
+    if (m_resyncPending && m_connected)
+        sendResyncRequest();
+
+    // 已消费的数据过半时再整体前移, 避免每条消息都搬移缓冲
+    if (m_readOffset > 0 && m_readOffset * 2 >= m_receiveBuffer.size())
+    {
+        m_receiveBuffer.erase(m_receiveBuffer.begin(), m_receiveBuffer.begin() + m_readOffset);
+        m_readOffset = 0;
+    }
+    return newFrame;
+}
+
+bool SpectatorClient::handleMessage(SpectatorMessageType type, std::uint32_t tick, const std::uint8_t *payload, std::size_t size)
+{
+    m_payload.assign(payload, payload + size);
+    if (type == SpectatorMessageType::FULL)
+    {
+        m_frameBytes.swap(m_payload);
+    }
+    else if (type == SpectatorMessageType::DELTA && m_hasBase)
+    {
+        if (!DeltaCodec::decode(m_frameBytes, m_payload, m_decodedBytes))
+        {
+            // 基准帧已失效, 之后的差分都无法还原, 请服务端补发完整帧
+            m_decodeErrors++;
+            m_hasBase = false;
+            m_resyncPending = true;
+            return false;
+        }
+        m_frameBytes.swap(m_decodedBytes);
+    }
+    else
+    {
+        // 还没收到完整帧, 差分无从还原
+        return false;
+    }
+
+    m_hasBase = true;
+    if (!SpectatorProtocol::decodeFrame(m_frameBytes, m_latestFrame))
+    {
+        m_decodeErrors++;
+        return false;
+    }
+    m_latestFrame.tick = tick;
+    m_hasFrame = true;
+    m_framesReceived++;
+    return true;
+}
+
+void SpectatorClient::sendResyncRequest()
+{
+    std::uint8_t request = static_cast<std::uint8_t>(SpectatorRequestType::RESYNC);
+    std::size_t sent = 0;
+    sf::Socket::Status status = m_socket.send(&request, sizeof(request), sent);
+    if (status == sf::Socket::Done)
+    {
+        m_resyncPending = false;
+        std::cerr << "SpectatorClient: Delta decode failed, requested a keyframe." << std::endl;
+    }
+    else if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+    {
+        m_connected = false;
+    }
+}
+
+int SpectatorClient::runHeadlessSwarm(const sf::IpAddress &address, unsigned short port, int count)
+{
+    std::vector<std::unique_ptr<SpectatorClient>> clients;
+    for (int i = 0; i < count; ++i)
+    {
+        auto client = std::make_unique<SpectatorClient>();
+        if (client->connect(address, port, sf::seconds(3.f)))
+            clients.push_back(std::move(client));
+    }
+    std::cout << "SpectatorSwarm: " << clients.size() << "/" << count << " viewers connected." << std::endl;
+    if (clients.empty())
+        return 1;
+
+    sf::Clock reportClock;
+    std::uint64_t lastBytes = 0;
+    while (true)
+    {
+        size_t connected = 0;
+        std::uint64_t bytes = 0;
+        unsigned frames = 0;
+        unsigned errors = 0;
+        std::uint32_t minTick = 0xffffffffu;
+        std::uint32_t maxTick = 0;
+        for (auto &client : clients)
+        {
+            client->poll();
+            if (client->isConnected())
+                connected++;
+            bytes += client->getBytesReceived();
+            frames += client->getFramesReceived();
+            errors += client->getDecodeErrors();
+            if (client->hasFrame())
+            {
+                minTick = std::min(minTick, client->getLatestFrame().tick);
+                maxTick = std::max(maxTick, client->getLatestFrame().tick);
+            }
+        }
+
+        float elapsed = reportClock.getElapsedTime().asSeconds();
+        if (elapsed >= 1.f)
+        {
+            std::cout << "SpectatorSwarm: " << connected << " connected | frames " << frames
+                      << " | " << static_cast<int>((bytes - lastBytes) / elapsed / 1024.f) << " KB/s total"
+                      << " | tick spread " << (maxTick >= minTick ? maxTick - minTick : 0)
+                      << " | decode errors " << errors << std::endl;
+            lastBytes = bytes;
+            reportClock.restart();
+        }
+        if (connected == 0)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::cout << "SpectatorSwarm: All viewers disconnected." << std::endl;
+    return 0;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "SpectatorProtocol.h"
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 观战客户端: 非阻塞接收广播流, 按消息还原完整帧 (完整帧直接解码, 差分帧基于上一帧还原)
+// 观战界面和无界面压力测试 (--spectate-swarm) 共用
+class SpectatorClient
+{
+public:
+    SpectatorClient();
+
+    bool connect(const sf::IpAddress &address, unsigned short port, sf::Time timeout);
+    // 收取已到达的数据, 返回本次是否还原出了新帧
+    bool poll();
+
+    bool isConnected() const { return m_connected; }
+    bool hasFrame() const { return m_hasFrame; }
+    const SpectatorFrame &getLatestFrame() const { return m_latestFrame; }
+
+    unsigned getFramesReceived() const { return m_framesReceived; }
+    unsigned getDecodeErrors() const { return m_decodeErrors; }
+    std::uint64_t getBytesReceived() const { return m_bytesReceived; }
+
+    // 连接 count 个无界面客户端, 持续接收并每秒打印统计, 直到全部断开
+    static int runHeadlessSwarm(const sf::IpAddress &address, unsigned short port, int count);
+
+private:
+    bool handleMessage(SpectatorMessageType type, std::uint32_t tick, const std::uint8_t *payload, std::size_t size);
+    // 发送重新同步请求, 套接字暂时写不进去时留到下次 poll 再发
+    void sendResyncRequest();
+
+    sf::TcpSocket m_socket;
+    bool m_connected;
+    std::vector<std::uint8_t> m_receiveBuffer;
+    std::size_t m_readOffset;
+
+    std::vector<std::uint8_t> m_payload;
+    std::vector<std::uint8_t> m_frameBytes;
+    std::vector<std::uint8_t> m_decodedBytes;
+    bool m_hasBase;
+    bool m_resyncPending;
+    SpectatorFrame m_latestFrame;
+    bool m_hasFrame;
+
+    unsigned m_framesReceived;
+    unsigned m_decodeErrors;
+    std::uint64_t m_bytesReceived;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../Utils/Constants.h"
+#include <SFML/Network/IpAddress.hpp>
+
+// 观战参数: --spectate-serve PORT 开启广播, --spectate ADDRESS:PORT 以观众身份启动
+struct SpectatorConfig
+{
+    unsigned short serverPort = 0;
+    float broadcastRateHz = SPECTATOR_DEFAULT_RATE_HZ;
+
+    sf::IpAddress viewAddress = sf::IpAddress::None;
+    unsigned short viewPort = 0;
+
+    bool isServing() const { return serverPort != 0; }
+    bool isViewing() const { return viewPort != 0; }
+};
@@ -0,0 +1,70 @@
+#include "SpectatorProtocol.h"
+#include "../Utils/BinaryStream.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::uint16_t quantize(float value)
+    {
+        float scaled = std::round(value * SPECTATOR_POSITION_SCALE);
+        return static_cast<std::uint16_t>(std::clamp(scaled, 0.f, 65535.f));
+    }
+}
+
+void SpectatorProtocol::encodeFrame(const SpectatorFrame &frame, std::vector<std::uint8_t> &out)
+{
+    out.clear();
+    out.reserve(8 + frame.entities.size() * 13);
+    BinaryWriter writer(out);
+    writer.write<std::uint16_t>(static_cast<std::uint16_t>(frame.rows));
+    writer.write<std::uint16_t>(static_cast<std::uint16_t>(frame.cols));
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(frame.entities.size()));
+    for (const SpectatorEntity &entity : frame.entities)
+    {
+        writer.write<std::uint32_t>(entity.id);
+        writer.write<std::uint8_t>(static_cast<std::uint8_t>(entity.kind));
+        writer.write<std::uint8_t>(entity.type);
+        writer.write<std::uint8_t>(entity.state);
+        writer.write<std::uint16_t>(quantize(entity.position.x));
+        writer.write<std::uint16_t>(quantize(entity.position.y));
+        writer.write<std::uint16_t>(static_cast<std::uint16_t>(std::clamp(entity.health, 0, 65535)));
+    }
+}
+
+bool SpectatorProtocol::decodeFrame(const std::vector<std::uint8_t> &data, SpectatorFrame &out)
+{
+    BinaryReader reader(data);
+    out.rows = reader.read<std::uint16_t>();
+    out.cols = reader.read<std::uint16_t>();
+    std::uint32_t count = reader.read<std::uint32_t>();
+    if (!reader.isOk() || data.size() != 8 + static_cast<std::size_t>(count) * 13)
+        return false;
+
+    out.entities.resize(count);
+    for (SpectatorEntity &entity : out.entities)
+    {
+        entity.id = reader.read<std::uint32_t>();
+        entity.kind = static_cast<SpectatorEntityKind>(reader.read<std::uint8_t>());
+        entity.type = reader.read<std::uint8_t>();
+        entity.state = reader.read<std::uint8_t>();
+        float x = reader.read<std::uint16_t>() / SPECTATOR_POSITION_SCALE;
+        float y = reader.read<std::uint16_t>() / SPECTATOR_POSITION_SCALE;
+        entity.position = sf::Vector2f(x, y);
+        entity.health = reader.read<std::uint16_t>();
+    }
+    return reader.isOk() && reader.isAtEnd();
+}
+
+void SpectatorProtocol::buildMessage(SpectatorMessageType type, std::uint32_t tick,
+                                     const std::vector<std::uint8_t> &payload, std::vector<std::uint8_t> &out)
+{
+    out.clear();
+    out.reserve(MESSAGE_HEADER_SIZE + payload.size());
+    BinaryWriter writer(out);
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(1 + 4 + payload.size()));
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(type));
+    writer.write<std::uint32_t>(tick);
+    writer.writeBytes(payload.data(), payload.size());
+}
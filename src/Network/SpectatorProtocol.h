@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+// 观战流协议: 服务端每个广播 tick 把实体状态量化成定长记录, 再与上一帧做差分 (DeltaCodec)
+// 消息格式: [u32 后续长度][u8 类型][u32 tick][负载], 负载为完整帧或相对上一帧的差分
+// 观众 -> 服务端只有单字节请求 (SpectatorRequestType)
+enum class SpectatorEntityKind : std::uint8_t
+{
+    PLANT,
+    ZOMBIE,
+    PROJECTILE,
+    SUN
+};
+
+enum class SpectatorMessageType : std::uint8_t
+{
+    FULL,
+    DELTA
+};
+
+enum class SpectatorRequestType : std::uint8_t
+{
+    RESYNC = 0x52 // 差分还原失败, 请求下一帧发完整帧
+};
+
+struct SpectatorEntity
+{
+    std::uint32_t id; // 服务端分配, 实体存活期间不变, 观众端据此插值
+    SpectatorEntityKind kind;
+    std::uint8_t type;  // PlantType / ZombieType / ProjectileType
+    std::uint8_t state; // 僵尸为 ZombieState, 其余为 0
+    sf::Vector2f position;
+    int health;
+};
+
+struct SpectatorFrame
+{
+    std::uint32_t tick = 0;
+    int rows = 0;
+    int cols = 0;
+    std::vector<SpectatorEntity> entities;
+};
+
+class SpectatorProtocol
+{
+public:
+    static const std::size_t MESSAGE_HEADER_SIZE = 9;
+
+    // 坐标按 SPECTATOR_POSITION_SCALE 量化为 u16, 血量截断为 u16; 每个实体 13 字节
+    static void encodeFrame(const SpectatorFrame &frame, std::vector<std::uint8_t> &out);
+    static bool decodeFrame(const std::vector<std::uint8_t> &data, SpectatorFrame &out);
+
+    static void buildMessage(SpectatorMessageType type, std::uint32_t tick,
+                             const std::vector<std::uint8_t> &payload, std::vector<std::uint8_t> &out);
+};
@@ -0,0 +1,257 @@
+#include "SpectatorServer.h"
+#include "../Utils/Constants.h"
+#include "../Utils/DeltaCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <ostream>
+
+SpectatorServer::SpectatorServer(unsigned short port, float broadcastRateHz)
+    : m_port(port),
+      m_broadcastIntervalTicks(1),
+      m_nextEntityId(1),
+      m_frameCounter(0),
+      m_running(false),
+      m_viewerCount(0),
+      m_bytesSent(0),
+      m_resyncCount(0),
+      m_lastDeltaSize(0),
+      m_lastFullSize(0)
+{
+    if (broadcastRateHz > 0.f)
+    {
+        float ticks = std::round(TARGET_FPS / broadcastRateHz);
+        m_broadcastIntervalTicks = static_cast<std::uint32_t>(std::max(1.f, ticks));
+    }
+}
+
+SpectatorServer::~SpectatorServer()
+{
+    stop();
+}
+
+bool SpectatorServer::start()
+{
+    if (m_listener.listen(m_port) != sf::Socket::Done)
+    {
+        std::cerr << "SpectatorServer: Failed to listen on TCP port " << m_port << "." << std::endl;
+        return false;
+    }
+    m_selector.add(m_listener);
+    m_running = true;
+    m_thread = std::thread(&SpectatorServer::run, this);
+    std::cout << "SpectatorServer: Broadcasting on TCP port " << m_port << " every "
+              << m_broadcastIntervalTicks << " ticks." << std::endl;
+    return true;
+}
+
+void SpectatorServer::stop()
+{
+    if (!m_running)
+        return;
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    m_selector.clear();
+    m_viewers.clear();
+    m_listener.close();
+    m_viewerCount = 0;
+}
+
+bool SpectatorServer::shouldBroadcast(std::uint32_t tick) const
+{
+    return m_running && tick % m_broadcastIntervalTicks == 0;
+}
+
+std::uint32_t SpectatorServer::getEntityId(std::uint64_t entityKey)
+{
+    auto result = m_entityIds.emplace(entityKey, EntityIdEntry{m_nextEntityId, m_frameCounter});
+    if (result.second)
+    {
+        m_nextEntityId++;
+    }
+    result.first->second.lastSeenFrame = m_frameCounter;
+    return result.first->second.id;
+}
+
+void SpectatorServer::publish(SpectatorFrame &frame)
+{
+    // 本帧没出现的实体已被销毁, 回收映射
+    for (auto it = m_entityIds.begin(); it != m_entityIds.end();)
+    {
+        if (it->second.lastSeenFrame != m_frameCounter)
+            it = m_entityIds.erase(it);
+        else
+            ++it;
+    }
+    m_frameCounter++;
+
+    // 只编码一次: 完整帧给新观众/重新同步, 差分给其余观众
+    SpectatorProtocol::encodeFrame(frame, m_frameBytes);
+    m_deltaBytes.clear();
+    DeltaCodec::encode(m_previousFrameBytes, m_frameBytes, m_deltaBytes);
+
+    auto full = std::make_shared<std::vector<std::uint8_t>>();
+    SpectatorProtocol::buildMessage(SpectatorMessageType::FULL, frame.tick, m_frameBytes, *full);
+    auto delta = std::make_shared<std::vector<std::uint8_t>>();
+    SpectatorProtocol::buildMessage(SpectatorMessageType::DELTA, frame.tick, m_deltaBytes, *delta);
+    m_lastFullSize = full->size();
+    m_lastDeltaSize = delta->size();
+    m_previousFrameBytes.swap(m_frameBytes);
+
+    std::lock_guard<std::mutex> lock(m_outboxMutex);
+    m_outbox.push_back(OutgoingMessage{std::move(full), std::move(delta)});
+}
+
+void SpectatorServer::writeStatsText(std::ostream &out) const
+{
+    out << "Spectators: " << m_viewerCount.load()
+        << " | frame " << m_lastFullSize.load() << " B, delta " << m_lastDeltaSize.load() << " B"
+        << " | sent " << (m_bytesSent.load() / 1024) << " KB | resyncs " << m_resyncCount.load();
+}
+
+void SpectatorServer::run()
+{
+    std::vector<OutgoingMessage> messages;
+    while (m_running)
+    {
+        if (m_selector.wait(sf::milliseconds(SPECTATOR_THREAD_WAIT_MS)))
+        {
+            if (m_selector.isReady(m_listener))
+            {
+                acceptViewer();
+            }
+            // 观众只会发重新同步请求, 其余数据直接丢弃; 可读也可能意味着断开
+            for (Viewer &viewer : m_viewers)
+            {
+                if (!m_selector.isReady(*viewer.socket))
+                    continue;
+                std::uint8_t requests[256];
+                std::size_t received = 0;
+                sf::Socket::Status status = viewer.socket->receive(requests, sizeof(requests), received);
+                if (status == sf::Socket::Disconnected || status == sf::Socket::Error)
+                    viewer.disconnected = true;
+                if (std::find(requests, requests + received, static_cast<std::uint8_t>(SpectatorRequestType::RESYNC)) != requests + received)
+                {
+                    viewer.needsKeyframe = true;
+                    m_resyncCount++;
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_outboxMutex);
+            messages.swap(m_outbox);
+        }
+        for (const OutgoingMessage &message : messages)
+        {
+            m_latestFull = message.full;
+            for (Viewer &viewer : m_viewers)
+            {
+                if (viewer.needsKeyframe)
+                {
+                    enqueue(viewer, message.full);
+                    viewer.needsKeyframe = false;
+                }
+                else
+                {
+                    enqueue(viewer, message.delta);
+                }
+            }
+        }
+        messages.clear();
+
+        for (Viewer &viewer : m_viewers)
+        {
+            flushViewer(viewer);
+        }
+
+        auto firstGone = std::remove_if(m_viewers.begin(), m_viewers.end(),
+                                        [this](Viewer &viewer)
+                                        {
+                                            if (!viewer.disconnected)
+                                                return false;
+                                            m_selector.remove(*viewer.socket);
+                                            return true;
+                                        });
+        if (firstGone != m_viewers.end())
+        {
+            m_viewers.erase(firstGone, m_viewers.end());
+            m_viewerCount = m_viewers.size();
+            std::cout << "SpectatorServer: Viewer left, " << m_viewers.size() << " watching." << std::endl;
+        }
+    }
+}
+
+void SpectatorServer::acceptViewer()
+{
+    Viewer viewer;
+    viewer.socket = std::make_unique<sf::TcpSocket>();
+    if (m_listener.accept(*viewer.socket) != sf::Socket::Done)
+        return;
+    viewer.socket->setBlocking(false);
+    m_selector.add(*viewer.socket);
+
+    // 有最新完整帧就立刻发, 之后的差分都基于它
+    if (m_latestFull)
+    {
+        enqueue(viewer, m_latestFull);
+        viewer.needsKeyframe = false;
+    }
+    std::cout << "SpectatorServer: Viewer joined from " << viewer.socket->getRemoteAddress().toString()
+              << ", " << (m_viewers.size() + 1) << " watching." << std::endl;
+    m_viewers.push_back(std::move(viewer));
+    m_viewerCount = m_viewers.size();
+}
+
+void SpectatorServer::enqueue(Viewer &viewer, const SharedBuffer &message)
+{
+    if (viewer.queuedBytes + message->size() > SPECTATOR_MAX_VIEWER_BACKLOG)
+    {
+        // 观众跟不上: 丢掉积压 (已发出一半的消息要发完, 否则流会错位), 用完整帧重新同步
+        while (viewer.queue.size() > (viewer.frontOffset > 0 ? 1u : 0u))
+        {
+            viewer.queuedBytes -= viewer.queue.back()->size();
+            viewer.queue.pop_back();
+        }
+        m_resyncCount++;
+        if (m_latestFull)
+        {
+            viewer.queue.push_back(m_latestFull);
+            viewer.queuedBytes += m_latestFull->size();
+        }
+        else
+        {
+            viewer.needsKeyframe = true;
+        }
+        return;
+    }
+    viewer.queue.push_back(message);
+    viewer.queuedBytes += message->size();
+}
+
+void SpectatorServer::flushViewer(Viewer &viewer)
+{
+    while (!viewer.queue.empty() && !viewer.disconnected)
+    {
+        const std::vector<std::uint8_t> &data = *viewer.queue.front();
+        std::size_t sent = 0;
+        sf::Socket::Status status = viewer.socket->send(data.data() + viewer.frontOffset, data.size() - viewer.frontOffset, sent);
+        m_bytesSent += sent;
+        if (status == sf::Socket::Done)
+        {
+            viewer.queuedBytes -= data.size();
+            viewer.queue.pop_front();
+            viewer.frontOffset = 0;
+        }
+        else if (status == sf::Socket::Partial || status == sf::Socket::NotReady)
+        {
+            viewer.frontOffset += sent;
+            return;
+        }
+        else
+        {
+            viewer.disconnected = true;
+        }
+    }
+}
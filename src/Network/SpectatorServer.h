@@ -0,0 +1,96 @@
+#pragma once
+
+#include "SpectatorProtocol.h"
+#include <SFML/Network.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 观战广播服务 (TCP)
+// 主线程每个广播 tick 调用 publish: 量化 + 差分编码只做一次, 结果以共享缓冲交给网络线程
+// 网络线程用 SocketSelector 接受连接, 用非阻塞套接字把同一份数据发给所有观众, 不占用主线程帧时间
+class SpectatorServer
+{
+public:
+    SpectatorServer(unsigned short port, float broadcastRateHz);
+    ~SpectatorServer();
+
+    bool start();
+    void stop();
+
+    // 按广播频率判断本 tick 是否需要广播
+    bool shouldBroadcast(std::uint32_t tick) const;
+    // 实体句柄 (EntityId::pack) -> 稳定 id, 构建帧时调用; 本帧没出现的实体在 publish 时回收
+    std::uint32_t getEntityId(std::uint64_t entityKey);
+    void publish(SpectatorFrame &frame);
+
+    // 写进调用方的流, 不生成临时字符串
+    void writeStatsText(std::ostream &out) const;
+
+private:
+    using SharedBuffer = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+    struct OutgoingMessage
+    {
+        SharedBuffer full;
+        SharedBuffer delta;
+    };
+
+    struct Viewer
+    {
+        std::unique_ptr<sf::TcpSocket> socket;
+        std::deque<SharedBuffer> queue;
+        std::size_t frontOffset = 0; // 队首消息已发出的字节数
+        std::size_t queuedBytes = 0;
+        bool needsKeyframe = true;
+        bool disconnected = false;
+    };
+
+    struct EntityIdEntry
+    {
+        std::uint32_t id;
+        std::uint32_t lastSeenFrame;
+    };
+
+    void run();
+    void acceptViewer();
+    void enqueue(Viewer &viewer, const SharedBuffer &message);
+    void flushViewer(Viewer &viewer);
+
+    unsigned short m_port;
+    std::uint32_t m_broadcastIntervalTicks;
+
+    // 主线程
+    std::vector<std::uint8_t> m_previousFrameBytes;
+    std::vector<std::uint8_t> m_frameBytes;
+    std::vector<std::uint8_t> m_deltaBytes;
+    std::unordered_map<std::uint64_t, EntityIdEntry> m_entityIds;
+    std::uint32_t m_nextEntityId;
+    std::uint32_t m_frameCounter;
+
+    // 主线程 -> 网络线程
+    std::mutex m_outboxMutex;
+    std::vector<OutgoingMessage> m_outbox;
+
+    // 网络线程
+    sf::TcpListener m_listener;
+    sf::SocketSelector m_selector;
+    std::vector<Viewer> m_viewers;
+    SharedBuffer m_latestFull;
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+
+    // 统计 (网络线程写, 主线程读)
+    std::atomic<std::size_t> m_viewerCount;
+    std::atomic<std::uint64_t> m_bytesSent;
+    std::atomic<unsigned> m_resyncCount;
+    std::atomic<std::size_t> m_lastDeltaSize;
+    std::atomic<std::size_t> m_lastFullSize;
+};
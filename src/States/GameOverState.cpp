@@ -8,7 +8,7 @@
 #include <iostream>
 
 GameOverState::GameOverState(StateManager *stateManager)
-    : GameState(stateManager), m_fontLoaded(false)
+    : GameState(stateManager), m_resourceScope(stateManager->getGame()->getResourceManager(), "GameOverState"), m_fontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_PRIMARY)), m_fontLoaded(false)
 {
 }
 
@@ -23,14 +23,11 @@ void GameOverState::enter()
     ResourceManager &resMan = game->getResourceManager();
 
     // 加载背景
-    std::string bgTextureId = "GameOverBackground";
+    const ResourceId bgTextureId{"GameOverBackground"};
     std::string bgTexturePath = "../../assets/images/gameover_background.png";
-    if (!resMan.hasTexture(bgTextureId))
+    if (!m_resourceScope.acquireTexture(bgTextureId, bgTexturePath))
     {
-        if (!resMan.loadTexture(bgTextureId, bgTexturePath))
-        {
-            std::cerr << "GameOverState: Failed to load background texture: " << bgTexturePath << std::endl;
-        }
+        std::cerr << "GameOverState: Failed to load background texture: " << bgTexturePath << std::endl;
     }
     m_backgroundSprite.setTexture(resMan.getTexture(bgTextureId));
     const sf::Texture *tex = m_backgroundSprite.getTexture();
@@ -43,27 +40,20 @@ void GameOverState::enter()
     m_backgroundSprite.setPosition(0, 0);
 
     // 加载字体
-    if (resMan.hasFont(FONT_ID_PRIMARY))
-    {
-        m_font = resMan.getFont(FONT_ID_PRIMARY);
-        m_fontLoaded = true;
-    }
-    else if (m_font.loadFromFile(FONT_PATH_ARIAL))
-    {
-        m_fontLoaded = true;
-    }
-    else
+    // 字体由 Game 的全局资源持有并已预热字形, 这里只引用
+    m_fontLoaded = resMan.hasFont(FONT_ID_PRIMARY);
+    if (!m_fontLoaded)
     {
-        std::cerr << "GameOverState: Failed to load font." << std::endl;
+        std::cerr << "GameOverState: Primary font not loaded." << std::endl;
     }
 
     m_gameOverText.setString("GAME OVER");
     if (m_fontLoaded)
-        m_gameOverText.setFont(m_font);
-    m_gameOverText.setCharacterSize(72);
+        m_gameOverText.setFont(m_fontRef);
+    m_gameOverText.setCharacterSize(GAME_OVER_TITLE_FONT_SIZE);
     m_gameOverText.setFillColor(sf::Color::Red);
     m_gameOverText.setOutlineColor(sf::Color::Black);
-    m_gameOverText.setOutlineThickness(2.f);
+    m_gameOverText.setOutlineThickness(GAME_OVER_TITLE_OUTLINE_THICKNESS);
     sf::FloatRect textBounds = m_gameOverText.getLocalBounds();
     m_gameOverText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
     m_gameOverText.setPosition(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 3.f);
@@ -86,14 +76,14 @@ void GameOverState::setupUI()
     // 重新开始
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, buttonYStart),
-        buttonSize, "Try Again", m_font));
+        buttonSize, "Try Again", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("retry"); });
 
     // 返回主菜单
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, buttonYStart + buttonSpacing),
-        buttonSize, "Main Menu", m_font));
+        buttonSize, "Main Menu", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("menu"); });
 }
@@ -114,6 +104,7 @@ void GameOverState::exit()
 {
     std::cout << "Exiting GameOver State" << std::endl;
     m_buttons.clear();
+    m_resourceScope.release();
 }
 
 void GameOverState::handleEvent(const sf::Event &event)
@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include "../UI/Button.h"
+#include "Core/ResourceScope.h"
 
 class StateManager;
 class ResourceManager;
@@ -18,12 +19,14 @@ public:
     void handleEvent(const sf::Event &event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow &window) override;
+    bool needsContinuousUpdate() const override { return false; }
 
 private:
     void setupUI();
     void executeAction(const std::string &action);
 
-    sf::Font m_font;
+    ResourceScope m_resourceScope; // 背景图只在本状态期间持有
+    const sf::Font &m_fontRef; // 全局共享字体, 不复制
     bool m_fontLoaded;
 
     sf::Text m_gameOverText;
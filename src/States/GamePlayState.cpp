@@ -8,169 +8,183 @@
 #include "Core/Game.h"
 #include "Core/ResourceManager.h"
 #include "../Utils/Constants.h"
-#include "../Entities/Plant.h"
-#include "../Entities/Zombie.h"
-#include "../Entities/Projectile.h"
+#include "../Systems/AnimationLibrary.h"
+#include "../Utils/BinaryStream.h"
 #include <iostream>
 #include <sstream>
-#include <cstdlib>
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
 
 namespace
 {
-    float randomFloat(float min, float max)
-    {
-        if (min >= max)
-            return min;
-        if ((max - min) == 0.0f)
-            return min;
-        return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
-    }
+    // 关卡内的音效, 进入关卡时后台解码; 豌豆射击会成片触发, 限制并发并让它最先被抢占
+    constexpr SoundAsset GAMEPLAY_SOUNDS[] = {
+        {SFX_PEASHOOT, "../../assets/audio/peashoot.wav", {SoundCategory::SFX, 6, -1}},
+        {SFX_ZOMBIE_DIE, "../../assets/audio/zombie_die.wav", {SoundCategory::SFX, 4, 1}},
+        {SFX_SUN_PICKUP, "../../assets/audio/sun_pickup.wav", {SoundCategory::SFX, 4, 2}},
+    };
 }
 
 GamePlayState::GamePlayState(StateManager *stateManager)
     : GameState(stateManager),
+      m_resourceScope(stateManager->getGame()->getResourceManager(), "GamePlayState"),
+      m_primaryGameFontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_PRIMARY)),
+      m_secondaryGameFontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_SECONDARY)),
       m_fontsLoaded(false),
-      m_grid(),
+      m_staticLayerGridVersion(0),
+      m_debugTextTimer(0.f),
+      m_grid(stateManager->getGame()->getBoardConfig()),
+      m_camera(sf::Vector2f(static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)), m_grid.getWorldBounds()),
+      m_levelArena(LEVEL_ARENA_BYTES),
+      m_world(&m_levelArena),
+      m_projectileManager(stateManager->getGame()->getResourceManager(), m_world),
+      m_plantManager(stateManager->getGame()->getResourceManager(), m_grid, m_world, *this, m_projectileManager),
       m_sunManager(INITIAL_SUN_AMOUNT),
-      m_projectileManager(stateManager->getGame()->getResourceManager()),
-      m_zombieManager(stateManager->getGame()->getResourceManager(), m_grid),
+      m_playerTwoSunManager(INITIAL_SUN_AMOUNT),
+      m_hudSunBank(INITIAL_SUN_AMOUNT),
+      m_zombieManager(stateManager->getGame()->getResourceManager(), m_grid, m_world),
+      m_hud(stateManager->getGame()->getResourceManager(), m_hudSunBank, m_primaryGameFontRef, m_secondaryGameFontRef),
       m_waveManager(m_zombieManager, *stateManager->getGame()),
-      m_plantManager(stateManager->getGame()->getResourceManager(), m_grid, *this, m_projectileManager, m_zombieManager),
-      m_hud(stateManager->getGame()->getResourceManager(), m_sunManager, m_waveManager, m_primaryGameFont, m_secondaryGameFont),
-      m_gameTime(0.0f),
-      m_skySunSpawnIntervalMin(5.0f),
-      m_skySunSpawnIntervalMax(12.0f),
-      m_currentSkySunSpawnInterval(0.0f),
+      m_sunPool(stateManager->getGame()->getResourceManager(), m_sunManager, m_world,
+                sf::Vector2f(m_grid.getWorldBounds().width, m_grid.getWorldBounds().height)),
+      m_particleSystem(stateManager->getGame()->getResourceManager(), PARTICLE_POOL_CAPACITY),
+      m_skySunSpawnTimer(0),
+      m_skySunSpawnIntervalMin(5),
+      m_skySunSpawnIntervalMax(12),
+      m_currentSkySunSpawnInterval(0),
+      m_gameTime(0),
       m_collisionSystem(),
-      m_isGameOver(false)
+      m_isGameOver(false),
+      m_rng(static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count())),
+      m_simTick(0),
+      m_exitTick(stateManager->getGame()->getSimulationConfig().exitTick),
+      m_localPlayer(0),
+      m_lastSpectatorTick(0xffffffffu),
+      m_soakWaves(stateManager->getGame()->getSimulationConfig().soakWaves),
+      m_soakWavesCompleted(0),
+      m_quickSaveRequested(false),
+      m_tickArena(SIMULATION_TICK_ARENA_BYTES),
+      m_frameArena(FRAME_ARENA_BYTES),
+      m_rewindHeld(false),
+      m_pendingOutcome(SimulationOutcome::RUNNING),
+      m_exitRequested(false),
+      m_memoryCheckFailed(false),
+      m_simulationFinished(false),
+      m_simulationThread(TIME_PER_FRAME)
 {
     std::cout << "GamePlayState 正在构造..." << std::endl;
     loadAssets();
+    registerMetrics();
 
-    m_currentSkySunSpawnInterval = randomFloat(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
-    m_skySunSpawnTimer.restart();
-    std::cout << "GamePlayState 构造完毕。" << std::endl;
-}
-
-void GamePlayState::loadAssets()
-{
-    std::cout << "GamePlayState:正在加载资源..." << std::endl;
-    if (!m_stateManager || !m_stateManager->getGame())
-    {
-        std::cerr << "GamePlayState::loadAssets: Fatal error - StateManager or Game pointer is null!" << std::endl;
-        return;
-    }
-    ResourceManager &resMan = m_stateManager->getGame()->getResourceManager();
-
-    std::string gameplayBgTextureId = "GamePlayBackgroundTexture";
-    std::string gameplayBgTexturePath = "../../assets/images/gameplay_background.png";
-
-    if (!resMan.hasTexture(gameplayBgTextureId))
+    const LockstepConfig &lockstepConfig = stateManager->getGame()->getLockstepConfig();
+    if (lockstepConfig.isEnabled())
     {
-        std::cout << "GamePlayState::loadAssets: Attempting to load gameplay background from: " << gameplayBgTexturePath << std::endl;
-        if (!resMan.loadTexture(gameplayBgTextureId, gameplayBgTexturePath))
+        m_lockstep = std::make_unique<LockstepSession>(lockstepConfig);
+        if (m_lockstep->open())
         {
-            std::cerr << "GamePlayState::loadAssets: Failed to load gameplay background texture: " << gameplayBgTexturePath << std::endl;
+            m_localPlayer = m_lockstep->getLocalPlayer();
         }
         else
         {
-            std::cout << "GamePlayState::loadAssets: Successfully loaded gameplay background." << std::endl;
+            std::cerr << "GamePlayState: Co-op session could not be opened, falling back to single player." << std::endl;
+            m_lockstep.reset();
         }
     }
-    else
-    {
-        std::cout << "GamePlayState::loadAssets: Gameplay background '" << gameplayBgTextureId << "' already loaded." << std::endl;
-    }
 
-    // 字体加载
-    if (resMan.hasFont(FONT_ID_PRIMARY))
-    {
-        m_primaryGameFont = resMan.getFont(FONT_ID_PRIMARY);
-        m_fontsLoaded = true;
-    }
-    else
+    const SpectatorConfig &spectatorConfig = stateManager->getGame()->getSpectatorConfig();
+    if (spectatorConfig.isServing())
     {
-        std::cerr << "GamePlayState:主要字体 (ID: " << FONT_ID_PRIMARY << ") 未从 ResourceManager 加载!" << std::endl;
-        if (m_primaryGameFont.loadFromFile(FONT_PATH_ARIAL))
-        {
-            m_fontsLoaded = true;
-            std::cout << "GamePlayState: Loaded fallback primary font: " << FONT_PATH_ARIAL << std::endl;
-        }
-        else
+        m_spectatorServer = std::make_unique<SpectatorServer>(spectatorConfig.serverPort, spectatorConfig.broadcastRateHz);
+        if (!m_spectatorServer->start())
         {
-            std::cerr << "GamePlayState:备用主要字体也加载失败!" << std::endl;
+            m_spectatorServer.reset();
         }
     }
-    if (resMan.hasFont(FONT_ID_SECONDARY))
+
+    const SimulationConfig &simulationConfig = stateManager->getGame()->getSimulationConfig();
+    if (simulationConfig.hasFixedSeed)
     {
-        m_secondaryGameFont = resMan.getFont(FONT_ID_SECONDARY);
+        // 联机时客户端仍以主机的初始快照为准
+        m_rng.seed(simulationConfig.seed);
+        m_waveManager.seed(simulationConfig.seed + 1);
     }
-    else
+    if (simulationConfig.isHashLogging())
     {
-        std::cerr << "GamePlayState:次要字体 (ID: " << FONT_ID_SECONDARY << ") 未从 ResourceManager 加载，尝试备用。" << std::endl;
-        if (m_secondaryGameFont.loadFromFile(FONT_PATH_VERDANA))
-        {
-            std::cout << "GamePlayState: Loaded fallback secondary font: " << FONT_PATH_VERDANA << std::endl;
-        }
-        else
+        m_tickHashLog.open(simulationConfig.tickHashLogPath, std::ios::out | std::ios::trunc);
+        if (!m_tickHashLog)
         {
-            std::cerr << "GamePlayState:备用次要字体也加载失败, 将使用主要字体。" << std::endl;
-            m_secondaryGameFont = m_primaryGameFont;
+            std::cerr << "GamePlayState: Failed to open tick hash log " << simulationConfig.tickHashLogPath << std::endl;
         }
     }
-    if (!m_fontsLoaded && m_primaryGameFont.getInfo().family.empty())
-    {
-        std::cerr << "GamePlayState:警告 - 没有有效的字体被加载!UI文本可能无法显示。" << std::endl;
-    }
-    if (!resMan.hasTexture(BASIC_ZOMBIE_TEXTURE_KEY))
+    if (simulationConfig.hasCommandScript())
     {
-        resMan.loadTexture(BASIC_ZOMBIE_TEXTURE_KEY, "../../assets/images/basic_zombie.png");
+        loadCommandScript(simulationConfig.commandScriptPath);
     }
 
-    if (!resMan.hasTexture(BIG_ZOMBIE_TEXTURE_KEY))
-    {
-        resMan.loadTexture(BIG_ZOMBIE_TEXTURE_KEY, "../../assets/images/big_zombie.png");
-    }
+    m_currentSkySunSpawnInterval = m_rng.nextFixed(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
+    m_skySunSpawnTimer = 0;
+    std::cout << "GamePlayState 构造完毕。棋盘 " << m_grid.getRows() << "x" << m_grid.getCols() << std::endl;
+}
 
-    if (!resMan.hasTexture(BOSS_ZOMBIE_TEXTURE_KEY))
-    {
-        resMan.loadTexture(BOSS_ZOMBIE_TEXTURE_KEY, "../../assets/images/boss_zombie.png");
-    }
+GamePlayState::~GamePlayState()
+{
+    m_simulationThread.stop();
+}
 
-    if (!resMan.hasTexture(QUICK_ZOMBIE_TEXTURE_KEY))
-    {
-        resMan.loadTexture(QUICK_ZOMBIE_TEXTURE_KEY, "../../assets/images/quick_zombie.png");
-    }
-    if (!resMan.hasTexture(SUNFLOWER_TEXTURE_KEY))
-    {
-        resMan.loadTexture(SUNFLOWER_TEXTURE_KEY, "../../assets/images/sunflower.png");
-    }
-    if (!resMan.hasTexture(PEASHOOTER_TEXTURE_KEY))
+void GamePlayState::loadAssets()
+{
+    std::cout << "GamePlayState:正在加载资源..." << std::endl;
+    if (!m_stateManager || !m_stateManager->getGame())
     {
-        resMan.loadTexture(PEASHOOTER_TEXTURE_KEY, "../../assets/images/peashooter.png");
+        std::cerr << "GamePlayState::loadAssets: Fatal error - StateManager or Game pointer is null!" << std::endl;
+        return;
     }
-    if (!resMan.hasTexture(WALLNUT_TEXTURE_KEY))
+    ResourceManager &resMan = m_stateManager->getGame()->getResourceManager();
+
+    const ResourceId gameplayBgTextureId{"GamePlayBackgroundTexture"};
+    std::string gameplayBgTexturePath = "../../assets/images/gameplay_background.png";
+
+    std::cout << "GamePlayState::loadAssets: Attempting to load gameplay background from: " << gameplayBgTexturePath << std::endl;
+    if (!m_resourceScope.acquireTexture(gameplayBgTextureId, gameplayBgTexturePath))
     {
-        resMan.loadTexture(WALLNUT_TEXTURE_KEY, "../../assets/images/wallnut.png");
+        std::cerr << "GamePlayState::loadAssets: Failed to load gameplay background texture: " << gameplayBgTexturePath << std::endl;
     }
-    if (!resMan.hasTexture(ICE_PEASHOOTER_TEXTURE_KEY))
+
+    // 字体加载: 两个字体都是 Game 全局持有的共享字体 (加载时已预热字形), 这里只检查是否可用
+    m_fontsLoaded = resMan.hasFont(FONT_ID_PRIMARY);
+    if (!m_fontsLoaded)
     {
-        resMan.loadTexture(ICE_PEASHOOTER_TEXTURE_KEY, "../../assets/images/ice_peashooter.png");
+        std::cerr << "GamePlayState:主要字体 (ID: " << FONT_ID_PRIMARY << ") 未从 ResourceManager 加载, 使用默认字体。" << std::endl;
     }
-    if (!resMan.hasTexture(SUN_TEXTURE_KEY))
+    if (!resMan.hasFont(FONT_ID_SECONDARY))
     {
-        resMan.loadTexture(SUN_TEXTURE_KEY, "../../assets/images/sun.png");
+        std::cerr << "GamePlayState:次要字体 (ID: " << FONT_ID_SECONDARY << ") 未从 ResourceManager 加载, 使用默认字体。" << std::endl;
     }
-    if (!resMan.hasTexture(PEA_TEXTURE_KEY))
+
+    // 关卡内的实体纹理; 植物纹理与种子包图标是同一文件, 由资源管理器共享
+    const struct
     {
-        resMan.loadTexture(PEA_TEXTURE_KEY, "../../assets/images/pea.png");
-    }
-    if (!resMan.hasTexture(ICE_PEA_TEXTURE_KEY))
+        ResourceId id;
+        const char *path;
+    } levelTextures[] = {
+        {BASIC_ZOMBIE_TEXTURE_KEY, "../../assets/images/basic_zombie.png"},
+        {BIG_ZOMBIE_TEXTURE_KEY, "../../assets/images/big_zombie.png"},
+        {BOSS_ZOMBIE_TEXTURE_KEY, "../../assets/images/boss_zombie.png"},
+        {QUICK_ZOMBIE_TEXTURE_KEY, "../../assets/images/quick_zombie.png"},
+        {SUNFLOWER_TEXTURE_KEY, "../../assets/images/sunflower.png"},
+        {PEASHOOTER_TEXTURE_KEY, "../../assets/images/peashooter.png"},
+        {WALLNUT_TEXTURE_KEY, "../../assets/images/wallnut.png"},
+        {ICE_PEASHOOTER_TEXTURE_KEY, "../../assets/images/ice_peashooter.png"},
+        {SUN_TEXTURE_KEY, "../../assets/images/sun.png"},
+        {PEA_TEXTURE_KEY, "../../assets/images/pea.png"},
+        {ICE_PEA_TEXTURE_KEY, "../../assets/images/ice_pea.png"},
+    };
+    for (const auto &texture : levelTextures)
     {
-        resMan.loadTexture(ICE_PEA_TEXTURE_KEY, "../../assets/images/ice_pea.png");
+        m_resourceScope.acquireTexture(texture.id, texture.path);
     }
     std::cout << "GamePlayState:source load trying finish。" << std::endl;
 }
@@ -184,8 +198,10 @@ void GamePlayState::enter()
         return;
     }
     ResourceManager &resManager = m_stateManager->getGame()->getResourceManager();
+    // 动画时钟随关卡归零, 同一种子下每局的帧号序列一致
+    AnimationLibrary::resetClock();
 
-    std::string gameplayBgTextureId = "GamePlayBackgroundTexture";
+    const ResourceId gameplayBgTextureId{"GamePlayBackgroundTexture"};
     if (!resManager.hasTexture(gameplayBgTextureId))
     {
         std::cerr << "GamePlayState::enter: Gameplay background texture NOT FOUND. ID: " << gameplayBgTextureId << std::endl;
@@ -194,37 +210,53 @@ void GamePlayState::enter()
     const sf::Texture *tex = m_BackgroundSpite.getTexture();
     if (tex && tex->getSize().x > 0 && tex->getSize().y > 0)
     {
+        // 背景铺满整个关卡世界 (默认棋盘时即窗口大小)
         sf::Vector2u textureSize = tex->getSize();
+        sf::FloatRect worldBounds = m_grid.getWorldBounds();
         m_BackgroundSpite.setScale(
-            static_cast<float>(WINDOW_WIDTH) / textureSize.x,
-            static_cast<float>(WINDOW_HEIGHT) / textureSize.y);
+            worldBounds.width / textureSize.x,
+            worldBounds.height / textureSize.y);
     }
     m_BackgroundSpite.setPosition(0.f, 0.f);
 
     if (m_fontsLoaded)
     {
-        m_debugInfoText.setFont(m_primaryGameFont);
+        m_debugInfoText.setFont(m_primaryGameFontRef);
     }
     else
     {
         std::cerr << "GamePlayState::enter - 调试文本无法设置字体，因字体未加载。" << std::endl;
     }
-    m_debugInfoText.setCharacterSize(14);
+    m_debugInfoText.setCharacterSize(DEBUG_TEXT_FONT_SIZE);
     m_debugInfoText.setFillColor(sf::Color::White);
-    m_debugInfoText.setPosition(10, WINDOW_HEIGHT - 50);
+    m_debugInfoText.setPosition(10, WINDOW_HEIGHT - 68);
 
     m_grid.initialize();
+    m_camera.setWorldBounds(m_grid.getWorldBounds());
+    m_camera.reset();
+    m_staticLayer.invalidate();
     m_sunManager.reset();
+    m_playerTwoSunManager.reset();
     m_plantManager.clear();
     m_projectileManager.clear();
     m_zombieManager.clear();
-    m_activeSuns.clear();
-    m_skySunSpawnTimer.restart();
-    m_currentSkySunSpawnInterval = randomFloat(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
+    m_sunPool.clear();
+    m_particleSystem.clear();
+    m_skySunSpawnTimer = 0;
+    m_currentSkySunSpawnInterval = m_rng.nextFixed(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
     m_isGameOver = false;
     m_waveManager.start();
 
-    m_gameTime = 0.f;
+    m_gameTime = 0;
+
+    // 关卡初始状态作为检查点, 重新开始时直接恢复
+    saveSnapshot(m_checkpointSnapshot);
+    resetRewindHistory();
+    if (m_lockstep && m_lockstep->getRole() == LockstepRole::HOST)
+    {
+        // 主机的初始状态就是双方共同的起点
+        m_lockstep->setStartSnapshot(m_checkpointSnapshot);
+    }
 
     if (m_stateManager && m_stateManager->getGame())
     {
@@ -239,17 +271,34 @@ void GamePlayState::enter()
     {
         std::cerr << "GamePlayState::enter - Cannot access SoundManager, Game or StateManager is null." << std::endl;
     }
+
+    // 先发布初始画面, 再交给模拟线程推进
+    m_pendingOutcome = SimulationOutcome::RUNNING;
+    m_simulationFinished = false;
+    publishRenderSnapshot();
+    m_tickArena.reset();
+    m_renderSnapshots.fetch();
+    // 浸泡测试的基线: 关卡资源、检查点和初始画面都已就绪
+    for (std::size_t tag = 0; tag < AllocationCounter::TAG_COUNT; ++tag)
+    {
+        m_memoryBaseline[tag] = AllocationCounter::getLiveBytes(static_cast<AllocationTag>(tag));
+    }
+    m_simulationThread.start([this]
+                             { simulationTick(); });
     std::cout << "GamePlayState enter finish。" << std::endl;
 }
 
 void GamePlayState::exit()
 {
     std::cout << "GamePlayState exit。" << std::endl;
-    m_plantManager.clear();
-    m_projectileManager.clear();
-    m_zombieManager.clear();
-    m_activeSuns.clear();
+    // 等模拟线程停下再清理模拟状态
+    m_simulationThread.stop();
+    writePendingQuickSave();
+    releaseLevelStorage();
+    m_particleSystem.clear();
     m_waveManager.reset();
+    // 实体都已清除, 可以归还本关纹理
+    m_resourceScope.release();
     if (m_stateManager && m_stateManager->getGame())
     {
         SoundManager &soundMan = m_stateManager->getGame()->getSoundManager();
@@ -261,23 +310,33 @@ void GamePlayState::exit()
     }
 }
 
+std::span<const SoundAsset> GamePlayState::getSoundManifest() const
+{
+    return GAMEPLAY_SOUNDS;
+}
+
 void GamePlayState::handleEvent(const sf::Event &event)
 {
     sf::RenderWindow &window = m_stateManager->getGame()->getWindow();
-    sf::Vector2f mousePosView;
+    // HUD 使用窗口视图 (屏幕坐标), 棋盘/阳光使用摄像机视图 (世界坐标)
+    sf::Vector2i eventPixelPos = m_mousePixelPos;
 
     if (event.type == sf::Event::MouseMoved)
     {
         m_mousePixelPos = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
-        mousePosView = window.mapPixelToCoords(m_mousePixelPos, window.getView());
+        eventPixelPos = m_mousePixelPos;
     }
     else if (event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseButtonReleased)
     {
-        mousePosView = window.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y), window.getView());
+        eventPixelPos = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
     }
-    else
+    sf::Vector2f mousePosView = window.mapPixelToCoords(eventPixelPos, window.getView());
+    sf::Vector2f mousePosWorld = window.mapPixelToCoords(eventPixelPos, m_camera.getView());
+
+    if (event.type == sf::Event::Resized)
     {
-        mousePosView = window.mapPixelToCoords(m_mousePixelPos, window.getView());
+        m_staticLayer.invalidate();
+        return;
     }
 
     if (event.type == sf::Event::KeyPressed)
@@ -289,6 +348,11 @@ void GamePlayState::handleEvent(const sf::Event &event)
                 m_hud.resetInteractionMode();
                 std::cout << "GamePlayState: Shovel mode cancelled by ESC." << std::endl;
             }
+            else if (m_lockstep)
+            {
+                // 联机时本地不能暂停: 模拟停下就不再发送输入帧, 对方会判定断线
+                std::cout << "GamePlayState: Pause is not available in co-op." << std::endl;
+            }
             else
             {
                 m_stateManager->pushState(std::make_unique<PauseState>(m_stateManager)); // 返回主菜单
@@ -297,13 +361,47 @@ void GamePlayState::handleEvent(const sf::Event &event)
         }
         if (event.key.code == sf::Keyboard::F1)
         {
-            m_sunManager.addSun(100);
-            std::cout << "sun add to " << m_sunManager.getCurrentSun() << std::endl;
+            PlayerCommand command{};
+            command.type = PlayerCommandType::ADD_SUN;
+            command.amount = 100;
+            queuePlayerCommand(command);
+            std::cout << "sun add to " << m_hudSunBank.getCurrentSun() + command.amount << std::endl;
+        }
+        if (event.key.code == sf::Keyboard::F2)
+        {
+            // 切换帧节奏模式, 调试用
+            m_stateManager->getGame()->getFramePacer().cycleMode();
+        }
+        if (event.key.code == sf::Keyboard::F5)
+        {
+            m_quickSaveRequested = true;
+            queueSimulationInput(SimulationInput{SimulationInputType::QUICK_SAVE, PlayerCommand{}, 0.f});
         }
+        if (event.key.code == sf::Keyboard::F9)
+        {
+            requestQuickLoad();
+        }
+        if (event.key.code == sf::Keyboard::F3)
+        {
+            // 粒子压力测试: 在光标处一次发射大量粒子
+            ParticleEmitterPreset stressPreset = ParticleSystem::getPreset(ParticleEffect::DEATH);
+            stressPreset.speedMax = 400.f;
+            stressPreset.lifeMax = 3.f;
+            m_particleSystem.emit(stressPreset, mousePosWorld, PARTICLE_STRESS_BURST);
+        }
+    }
+
+    if (m_camera.handleEvent(event, window))
+    {
+        return;
     }
 
     // 2. 将所有事件（包括按键和鼠标）传递给 HUD 处理
-    bool eventConsumedByHUD = m_hud.handleEvent(event, mousePosView);
+    bool eventConsumedByHUD = false;
+    {
+        AllocationScope allocationScope(AllocationTag::UI);
+        eventConsumedByHUD = m_hud.handleEvent(event, mousePosView);
+    }
 
     if (eventConsumedByHUD)
     {
@@ -311,6 +409,8 @@ void GamePlayState::handleEvent(const sf::Event &event)
         return;
     }
 
+    // 操作在下一个模拟 tick 才执行, 这里按最新渲染快照预判能否生效 (决定提示、粒子和卡片冷却)
+    const RenderSnapshot &snapshot = m_renderSnapshots.getReadBuffer();
     if (event.type == sf::Event::MouseButtonPressed)
     {
         if (event.mouseButton.button == sf::Mouse::Left)
@@ -319,15 +419,17 @@ void GamePlayState::handleEvent(const sf::Event &event)
             if (m_hud.getCurrentInteractionMode() == HUDInteractionMode::SHOVEL_SELECTED)
             {
                 // --- A. 铲子模式：尝试移除植物 ---
-                sf::Vector2i gridCoords = m_grid.getGridPosition(mousePosView);
+                sf::Vector2i gridCoords = m_grid.getGridPosition(mousePosWorld);
 
                 if (m_grid.isValidGridPosition(gridCoords))
                 {
-                    Plant *plantToShovel = m_plantManager.getPlantAt(gridCoords);
-                    if (plantToShovel)
+                    PlayerCommand command{};
+                    command.type = PlayerCommandType::SHOVEL;
+                    command.gridPos = gridCoords;
+                    if (snapshot.isCellOccupied(gridCoords))
                     {
-                        std::cout << "GamePlayState: Shoveling plant at grid (" << gridCoords.x << "," << gridCoords.y << ")" << std::endl;
-                        m_plantManager.removePlant(plantToShovel);
+                        queuePlayerCommand(command);
+                        std::cout << "GamePlayState: Shoveled plant at grid (" << gridCoords.x << "," << gridCoords.y << ")" << std::endl;
                     }
                     else
                     {
@@ -345,19 +447,15 @@ void GamePlayState::handleEvent(const sf::Event &event)
             {
                 // --- B. 正常模式：收集阳光或尝试种植 ---
                 // B.1 尝试收集阳光
-                bool sunCollectedThisClick = false;
-                for (auto it = m_activeSuns.rbegin(); it != m_activeSuns.rend(); ++it)
-                {
-                    if (!(*it)->isCollected() && (*it)->handleClick(mousePosView))
-                    {
-                        (*it)->collect();
-                        sunCollectedThisClick = true;
-                        std::cout << "GamePlayState: Sun collected." << std::endl;
-                        break;
-                    }
-                }
-                if (sunCollectedThisClick)
+                PlayerCommand collectCommand{};
+                collectCommand.type = PlayerCommandType::COLLECT_SUN;
+                collectCommand.worldPos = mousePosWorld;
+                if (snapshot.hasSunAt(mousePosWorld))
                 {
+                    queuePlayerCommand(collectCommand);
+                    m_particleSystem.emit(ParticleEffect::SUN_PICKUP, mousePosWorld);
+                    m_stateManager->getGame()->getSoundManager().playSound(SFX_SUN_PICKUP);
+                    std::cout << "GamePlayState: Sun collected." << std::endl;
                     return;
                 }
 
@@ -365,25 +463,31 @@ void GamePlayState::handleEvent(const sf::Event &event)
                 bool clickedOnGridArea = mousePosView.y > (SEED_PACKET_UI_START_Y + SEED_PACKET_HEIGHT + SEED_PACKET_SPACING);
                 if (clickedOnGridArea)
                 {
-                    sf::Vector2i gridCoords = m_grid.getGridPosition(mousePosView);
+                    sf::Vector2i gridCoords = m_grid.getGridPosition(mousePosWorld);
                     bool isValidPlantSelection = false;
                     PlantType selectedPlant = m_hud.getSelectedPlantTypeFromSeedManager(isValidPlantSelection);
 
                     if (m_grid.isValidGridPosition(gridCoords) && isValidPlantSelection)
                     {
-                        if (!m_grid.isCellOccupied(gridCoords.x, gridCoords.y))
+                        if (!snapshot.isCellOccupied(gridCoords))
                         {
                             int cost = m_hud.getSelectedPlantCostFromSeedManager();
-                            if (m_sunManager.getCurrentSun() >= cost)
+                            if (m_hudSunBank.getCurrentSun() >= cost)
                             {
-                                if (m_plantManager.tryAddPlant(selectedPlant, gridCoords))
+                                PlayerCommand plantCommand{};
+                                plantCommand.type = PlayerCommandType::PLANT;
+                                plantCommand.plantType = selectedPlant;
+                                plantCommand.gridPos = gridCoords;
+                                // 冷却等模拟线程确认种植成功后才开始 (见 update), 被拒绝时不进入冷却
+                                std::size_t typeIndex = static_cast<std::size_t>(selectedPlant);
+                                if (m_plantRequestsSent[typeIndex] != snapshot.hud.plantRequestsResolved[typeIndex])
                                 {
-                                    m_sunManager.trySpendSun(cost);
-                                    m_hud.notifyPlantPlacedToSeedManager(selectedPlant);
+                                    std::cout << "GamePlayState: Previous planting is not confirmed yet." << std::endl;
                                 }
-                                else
+                                else if (queuePlayerCommand(plantCommand))
                                 {
-                                    std::cout << "GamePlayState: PlantManager failed to add plant." << std::endl;
+                                    m_plantRequestsSent[typeIndex]++;
+                                    m_hud.notifyPlantRequestedToSeedManager();
                                 }
                             }
                             else
@@ -424,156 +528,1065 @@ void GamePlayState::update(float deltaTime)
     if (m_isGameOver)
         return;
 
-    m_gameTime += deltaTime;
+    sf::RenderWindow &window = m_stateManager->getGame()->getWindow();
+    // 模拟线程已分出胜负: 切换状态会销毁本状态, 之后不能再访问成员
+    if (handleSimulationOutcome(m_pendingOutcome.load()))
+        return;
+    if (m_exitRequested.exchange(false))
+    {
+        if (m_memoryCheckFailed)
+            m_stateManager->getGame()->setExitCode(MEMORY_CHECK_FAILED_EXIT_CODE);
+        window.close();
+        return;
+    }
+
+    writePendingQuickSave();
+    m_camera.update(deltaTime, window);
+    // 键盘状态只能在主线程查询, 按住退格键时模拟线程改为倒带
+    m_rewindHeld = !m_lockstep && window.hasFocus() && sf::Keyboard::isKeyPressed(sf::Keyboard::BackSpace);
 
-    for (auto &sun : m_activeSuns)
+    m_renderSnapshots.fetch();
+    const RenderSnapshot &snapshot = m_renderSnapshots.getReadBuffer();
+
+    ParticleRequest request;
+    while (m_particleQueue.pop(request))
     {
-        sun->update(deltaTime);
+        if (request.clear)
+            m_particleSystem.clear();
+        else
+            m_particleSystem.emit(request.effect, request.position);
     }
-    m_activeSuns.erase(
-        std::remove_if(m_activeSuns.begin(), m_activeSuns.end(),
-                       [](const std::unique_ptr<Sun> &s)
-                       { return s->isExpired(); }),
-        m_activeSuns.end());
+    m_particleSystem.update(deltaTime);
 
-    if (m_skySunSpawnTimer.getElapsedTime().asSeconds() >= m_currentSkySunSpawnInterval)
+    // 模拟线程的音效请求在这里交给混音器, 保证只有主线程向混音器发命令
+    SoundManager &soundManager = m_stateManager->getGame()->getSoundManager();
+    ResourceId sound;
+    while (m_soundQueue.pop(sound))
     {
-        spawnSunFromSky();
+        soundManager.playSound(sound);
     }
 
-    m_plantManager.update(deltaTime);
-    m_projectileManager.update(deltaTime, m_stateManager->getGame()->getWindow());
+    AllocationScope allocationScope(AllocationTag::UI);
+    m_hudSunBank.setCurrentSun(snapshot.hud.sun[m_localPlayer]);
+    for (std::size_t type = 0; type < PLANT_TYPE_COUNT; ++type)
+    {
+        if (snapshot.hud.plantsPlaced[type] != m_plantsPlacedSeen[type])
+        {
+            m_plantsPlacedSeen[type] = snapshot.hud.plantsPlaced[type];
+            m_hud.notifyPlantPlacedToSeedManager(static_cast<PlantType>(type));
+        }
+    }
+    m_hud.update(deltaTime, snapshot.hud);
 
-    std::vector<Plant *> activePlantsForZombies = m_plantManager.getAllActivePlants();
-    std::vector<Zombie *> activeZombiesToUpdate = m_zombieManager.getActiveZombies();
-    for (Zombie *zombie : activeZombiesToUpdate)
+    // sf::Text::setString 每次都会复制并重建字形顶点, 调试文本降频刷新
+    m_debugTextTimer -= deltaTime;
+    if (m_debugTextTimer <= 0.f)
     {
-        if (zombie && zombie->isAlive())
+        m_debugTextTimer = DEBUG_TEXT_REFRESH_INTERVAL.asSeconds();
+        Game *game = m_stateManager->getGame();
+        ArenaStringStream ss(std::ios_base::out, &m_frameArena);
+        ss.precision(1);
+        ss << std::fixed;
+        ss << "Time: " << snapshot.gameTime << "s | FPS: " << static_cast<int>(1.f / deltaTime)
+           << " | Mouse: (" << m_mousePixelPos.x << "," << m_mousePixelPos.y << ")"
+           << " | Suns: " << m_hudSunBank.getCurrentSun()
+           << " | Board: " << m_grid.getRows() << "x" << m_grid.getCols()
+           << " | Sim steps: " << m_simulationThread.getStepCount() << " (" << m_simulationThread.getDroppedSteps() << " dropped)"
+           << " | Allocs/frame: " << game->getLastFrameAllocations()
+           << "\n";
+        game->getFramePacer().writeStatsText(ss);
+        ss << "\n";
+        m_particleSystem.writeStatsText(ss);
+        ss << " | ";
+        m_spriteBatch.writeStatsText(ss);
+        ss << " | " << snapshot.statsText << "\n";
+        game->writeMemoryStatsText(ss);
+        m_debugTextBuffer.assign(ss.view());
+        m_debugInfoText.setString(m_debugTextBuffer);
+    }
+    m_frameArena.reset();
+}
+
+void GamePlayState::pause()
+{
+    // 联机时锁步会话必须继续收发, 模拟线程不停 (分出胜负后 simulationTick 自己会停下)
+    if (m_lockstep)
+        return;
+    m_simulationThread.setPaused(true);
+}
+
+void GamePlayState::resume()
+{
+    m_simulationThread.setPaused(false);
+}
+
+void GamePlayState::simulationTick()
+{
+    // 已分出胜负, 画面停在最后一帧, 等主线程切换状态
+    if (m_simulationFinished)
+        return;
+
+    SimulationInput input;
+    while (m_inputQueue.pop(input))
+    {
+        switch (input.type)
         {
-            int currentZombieLane = zombie->getLane();
-            std::vector<Plant *> plantsInThisSpecificLane;
-            if (currentZombieLane != -1)
-            {
-                for (Plant *p : activePlantsForZombies)
-                {
-                    if (p && p->isAlive() && p->getRow() == currentZombieLane)
-                    {
-                        plantsInThisSpecificLane.push_back(p);
-                    }
-                }
-            }
-            zombie->update(deltaTime, plantsInThisSpecificLane);
+        case SimulationInputType::COMMAND:
+            issuePlayerCommand(input.command);
+            break;
+        case SimulationInputType::QUICK_SAVE:
+            quickSave();
+            break;
+        case SimulationInputType::QUICK_LOAD:
+            quickLoad();
+            break;
+        case SimulationInputType::RESET_LEVEL:
+            performResetLevel();
+            break;
+        case SimulationInputType::REWIND_SECONDS:
+            performRewindSeconds(input.seconds);
+            break;
         }
     }
-    for (Zombie *zombie : m_zombieManager.getActiveZombies())
+
+    // 所有实体共用的动画时钟, 每个 tick 只推进一次
+    AnimationLibrary::advanceClock();
+
+    SimulationOutcome outcome = SimulationOutcome::RUNNING;
+    if (m_lockstep)
+    {
+        outcome = updateLockstep();
+    }
+    else if (m_rewindHeld)
     {
-        if (zombie && zombie->isAlive() && zombie->getPosition().x < ZOMBIE_REACHED_HOUSE_X)
+        // 按住退格键倒带
+        if (m_simTick > m_rewindBuffer.getOldestTick())
         {
-            std::cout << "Game Over: A zombie reached the house!" << std::endl;
-            m_isGameOver = true;
-            m_stateManager->changeState(std::make_unique<GameOverState>(m_stateManager));
-            return;
+            std::uint32_t step = static_cast<std::uint32_t>(REWIND_SCRUB_TICKS_PER_UPDATE);
+            rewindToTick(m_simTick > step ? m_simTick - step : 0);
         }
     }
-    m_zombieManager.update(deltaTime, m_stateManager->getGame()->getWindow());
-    m_collisionSystem.update(m_projectileManager, m_zombieManager, m_plantManager);
-    m_waveManager.update(deltaTime);
-    m_hud.update(deltaTime);
+    else
+    {
+        outcome = advanceSimulation();
+    }
+    if (outcome != SimulationOutcome::RUNNING && m_soakWaves != 0 && !m_lockstep)
+    {
+        outcome = continueSoakTest(outcome);
+    }
 
-    if (!m_isGameOver &&
-        m_waveManager.getCurrentWaveNumber() >= TOTAL_WAVES_TO_WIN &&
-        m_waveManager.getCurrentSpawnState() == SpawnState::ALL_WAVES_COMPLETED &&
-        m_zombieManager.getActiveZombies().empty())
+    recordMetrics();
+    if (m_spectatorServer && m_simTick != m_lastSpectatorTick && m_spectatorServer->shouldBroadcast(m_simTick))
+    {
+        broadcastSpectatorFrame();
+    }
+    flushParticleRequests();
+    flushSoundRequests();
+    publishRenderSnapshot();
+    m_tickArena.reset();
+
+    if (outcome != SimulationOutcome::RUNNING)
+    {
+        m_simulationFinished = true;
+        m_pendingOutcome = outcome;
+    }
+}
+
+GamePlayState::SimulationOutcome GamePlayState::advanceSimulation()
+{
+    issueScriptedCommands();
+    // 模拟固定按 SIM_TICK_DT 推进, 与渲染帧率无关
+    SimulationOutcome outcome = stepSimulation(SIM_TICK_DT);
+    m_simTick++;
+    recordTickHash();
+    if (outcome != SimulationOutcome::RUNNING)
+        return outcome;
+    if (m_simTick % REWIND_CAPTURE_INTERVAL_TICKS == 0)
+    {
+        saveSnapshot(m_rewindScratch);
+        m_rewindBuffer.capture(m_simTick, m_rewindScratch);
+        // 输入日志只需覆盖缓冲里最旧的记录之后
+        while (!m_commandLog.empty() && m_commandLog.front().tick < m_rewindBuffer.getOldestTick())
+        {
+            m_commandLog.pop_front();
+        }
+    }
+    return outcome;
+}
+
+GamePlayState::SimulationOutcome GamePlayState::updateLockstep()
+{
+    m_lockstep->poll();
+
+    // 客户端: 用主机下发的关卡初始快照替换本地状态, 双方从同一状态开始
+    if (m_lockstep->takeStartSnapshot(m_rewindScratch))
+    {
+        if (loadSnapshot(m_rewindScratch))
+        {
+            m_checkpointSnapshot = m_rewindScratch;
+        }
+        else
+        {
+            std::cerr << "GamePlayState: Host start snapshot rejected, co-op cannot start." << std::endl;
+        }
+    }
+
+    // 双方这一 tick 的输入都到齐才推进, 否则本 tick 停顿等待
+    SimulationOutcome outcome = SimulationOutcome::RUNNING;
+    if (m_lockstep->isTickReady(m_simTick))
+    {
+        m_lockstep->takeCommandsForTick(m_simTick, m_tickCommands);
+        for (const PlayerCommand &command : m_tickCommands)
+        {
+            bool applied = executePlayerCommand(command);
+            if (command.player == m_localPlayer)
+                recordLocalPlantResult(command, applied);
+        }
+        outcome = stepSimulation(SIM_TICK_DT);
+        m_simTick++;
+        recordTickHash();
+        m_lockstep->onTickSimulated(m_simTick);
+        if (m_simTick % COOP_CHECKSUM_INTERVAL_TICKS == 0)
+        {
+            saveSnapshot(m_rewindScratch);
+            m_lockstep->recordChecksum(m_simTick, LockstepSession::computeChecksum(m_rewindScratch));
+        }
+    }
+    // 结算后本状态会被销毁, 每个 tick 都把输入发出去
+    m_lockstep->flush();
+    return outcome;
+}
+
+void GamePlayState::recordTickHash()
+{
+    if (m_tickHashLog.is_open() && m_simTick % COOP_CHECKSUM_INTERVAL_TICKS == 0)
+    {
+        saveSnapshot(m_rewindScratch);
+        m_tickHashLog << m_simTick << ' ' << std::hex << LockstepSession::computeChecksum(m_rewindScratch) << std::dec << '\n';
+    }
+    if (m_exitTick != 0 && m_simTick >= m_exitTick)
+    {
+        std::cout << "GamePlayState: Reached exit tick " << m_simTick << ", closing." << std::endl;
+        m_tickHashLog.flush();
+        // 窗口只能由主线程关闭
+        m_exitRequested = true;
+        m_exitTick = 0;
+    }
+}
+
+void GamePlayState::publishRenderSnapshot()
+{
+    RenderSnapshot &snapshot = m_renderSnapshots.getWriteBuffer();
+    snapshot.tick = m_simTick;
+    snapshot.gameTime = m_gameTime.toFloat();
+
+    // 收集顺序即绘制顺序
+    snapshot.sprites.clear();
+    m_plantManager.collectRenderSprites(snapshot.sprites);
+    m_sunPool.collectRenderSprites(snapshot.sprites);
+    m_projectileManager.collectRenderSprites(snapshot.sprites);
+    m_zombieManager.collectRenderSprites(snapshot.sprites);
+
+    snapshot.rowOccupancyMasks.resize(static_cast<size_t>(m_grid.getRows()));
+    for (int row = 0; row < m_grid.getRows(); ++row)
+    {
+        snapshot.rowOccupancyMasks[static_cast<size_t>(row)] = m_grid.getRowOccupancyMask(row);
+    }
+
+    snapshot.hud.sun[0] = m_sunManager.getCurrentSun();
+    snapshot.hud.sun[1] = m_playerTwoSunManager.getCurrentSun();
+    snapshot.hud.waveProgress = m_waveManager.getCurrentWaveProgress();
+    snapshot.hud.waveState = m_waveManager.getCurrentSpawnState();
+    snapshot.hud.plantRequestsResolved = m_plantRequestsResolved;
+    snapshot.hud.plantsPlaced = m_plantsPlaced;
+
+    // 文本先拼在 tick 内存区上, 再拷进快照里的字符串; 快照三份轮流复用, 容量稳定后不再分配
+    ArenaStringStream label(std::ios_base::out, &m_tickArena);
+    m_waveManager.writeWaveProgressLabel(label);
+    snapshot.hud.waveLabel.assign(label.view());
+    ArenaStringStream status(std::ios_base::out, &m_tickArena);
+    m_waveManager.writeCurrentWaveStatusText(status);
+    snapshot.hud.waveStatusText.assign(status.view());
+
+    ArenaStringStream ss(std::ios_base::out, &m_tickArena);
+    ss << "Entities: S:" << m_sunPool.getActiveCount()
+       << " P:" << m_projectileManager.getProjectileCount()
+       << " Z:" << m_zombieManager.getActiveZombieCount()
+       << " | Plants: " << m_plantManager.getPlantCount()
+       << " | " << snapshot.hud.waveStatusText
+       << " | Tick: " << m_simTick
+       << " | Level arena: " << m_levelArena.getUsedBytes() / 1024 << "/" << m_levelArena.getCapacity() / 1024 << " KB | ";
+    if (m_lockstep)
+    {
+        m_lockstep->writeStatsText(ss);
+        ss << " | P1 sun " << m_sunManager.getCurrentSun()
+           << " P2 sun " << m_playerTwoSunManager.getCurrentSun();
+    }
+    else
+    {
+        m_rewindBuffer.writeStatsText(ss);
+    }
+    if (m_spectatorServer)
+    {
+        ss << " | ";
+        m_spectatorServer->writeStatsText(ss);
+    }
+    snapshot.statsText.assign(ss.view());
+
+    m_renderSnapshots.publish();
+}
+
+void GamePlayState::flushParticleRequests()
+{
+    for (const ParticleRequest &request : m_particleRequests)
+    {
+        // 主线程跟不上时丢弃多出的特效, 不影响模拟
+        if (!m_particleQueue.push(request))
+            break;
+    }
+    m_particleRequests.clear();
+}
+
+void GamePlayState::requestParticleClear()
+{
+    // 之前积累的请求一并作废; 回溯重放产生的音效也不播放
+    m_particleRequests.clear();
+    m_particleRequests.push_back(ParticleRequest{ParticleEffect::HIT, sf::Vector2f(), true});
+    m_soundRequests.clear();
+}
+
+void GamePlayState::flushSoundRequests()
+{
+    for (ResourceId sound : m_soundRequests)
+    {
+        // 主线程跟不上 (或被覆盖层挡住不更新) 时丢弃, 不影响模拟
+        if (!m_soundQueue.push(sound))
+            break;
+    }
+    m_soundRequests.clear();
+}
+
+bool GamePlayState::handleSimulationOutcome(SimulationOutcome outcome)
+{
+    if (outcome == SimulationOutcome::LOST)
+    {
+        std::cout << "Game Over: A zombie reached the house!" << std::endl;
+        m_isGameOver = true;
+        m_stateManager->changeState(std::make_unique<GameOverState>(m_stateManager));
+        return true;
+    }
+    if (outcome == SimulationOutcome::WON)
     {
         std::cout << "Victory! All waves cleared." << std::endl;
         m_isGameOver = true;
         m_stateManager->changeState(std::make_unique<VictoryState>(m_stateManager));
-        return;
+        return true;
+    }
+    return false;
+}
+
+bool GamePlayState::queueSimulationInput(const SimulationInput &input)
+{
+    if (!m_inputQueue.push(input))
+    {
+        std::cerr << "GamePlayState: Simulation input queue full, input dropped." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool GamePlayState::queuePlayerCommand(const PlayerCommand &command)
+{
+    return queueSimulationInput(SimulationInput{SimulationInputType::COMMAND, command, 0.f});
+}
+
+SunManager &GamePlayState::getSunBank(int player)
+{
+    return player == 1 ? m_playerTwoSunManager : m_sunManager;
+}
+
+void GamePlayState::registerMetrics()
+{
+    static const char *SYSTEM_LABELS[SYSTEM_COUNT] = {"sun", "plants", "projectiles", "zombies", "collision", "waves"};
+    static const char *WAVE_STATE_LABELS[WAVE_STATE_COUNT] = {"IDLE", "PREPARING_WAVE", "NORMAL_SPAWN", "HUGE_WAVE_ANNOUNCE",
+                                                              "HUGE_WAVE_SPAWN", "WAVE_COOLDOWN", "ALL_WAVES_COMPLETED"};
+    // 单步模拟预算约 16.7ms, 桶从 10us 到 16ms
+    const std::vector<double> stepBuckets = {0.00001, 0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016};
+
+    MetricsRegistry &metrics = m_stateManager->getGame()->getMetrics();
+    m_stepTimeMetric = &metrics.histogram("pvz_simulation_step_seconds", "Time spent in one fixed simulation step.", stepBuckets);
+    for (int i = 0; i < SYSTEM_COUNT; ++i)
+    {
+        m_systemTimeMetrics[i] = &metrics.histogram("pvz_system_update_seconds", "Time spent updating one simulation system per step.",
+                                                    stepBuckets, std::string("system=\"") + SYSTEM_LABELS[i] + "\"");
+    }
+    m_plantCountMetric = &metrics.gauge("pvz_entities", "Active entities by kind.", "kind=\"plant\"");
+    m_zombieCountMetric = &metrics.gauge("pvz_entities", "Active entities by kind.", "kind=\"zombie\"");
+    m_projectileCountMetric = &metrics.gauge("pvz_entities", "Active entities by kind.", "kind=\"projectile\"");
+    m_sunCountMetric = &metrics.gauge("pvz_entities", "Active entities by kind.", "kind=\"sun\"");
+    m_waveNumberMetric = &metrics.gauge("pvz_wave_number", "Current wave number.");
+    for (int i = 0; i < WAVE_STATE_COUNT; ++i)
+    {
+        m_waveStateMetrics[i] = &metrics.gauge("pvz_wave_state", "1 for the wave manager's current spawn state, 0 otherwise.",
+                                               std::string("state=\"") + WAVE_STATE_LABELS[i] + "\"");
+    }
+}
+
+void GamePlayState::recordMetrics()
+{
+    m_plantCountMetric->set(static_cast<double>(m_plantManager.getPlantCount()));
+    m_zombieCountMetric->set(static_cast<double>(m_zombieManager.getActiveZombieCount()));
+    m_projectileCountMetric->set(static_cast<double>(m_projectileManager.getProjectileCount()));
+    m_sunCountMetric->set(static_cast<double>(m_sunPool.getActiveCount()));
+    m_waveNumberMetric->set(m_waveManager.getCurrentWaveNumber());
+    int currentState = static_cast<int>(m_waveManager.getCurrentSpawnState());
+    for (int i = 0; i < WAVE_STATE_COUNT; ++i)
+    {
+        m_waveStateMetrics[i]->set(i == currentState ? 1.0 : 0.0);
+    }
+}
+
+void GamePlayState::broadcastSpectatorFrame()
+{
+    m_lastSpectatorTick = m_simTick;
+    m_spectatorFrame.tick = m_simTick;
+    m_spectatorFrame.rows = m_grid.getRows();
+    m_spectatorFrame.cols = m_grid.getCols();
+    m_spectatorFrame.entities.clear();
+
+    SpectatorServer &server = *m_spectatorServer;
+    std::vector<SpectatorEntity> &entities = m_spectatorFrame.entities;
+    m_world.each<Transform, Health, PlantInfo>(
+        [&](EntityId id, const Transform &transform, const Health &health, const PlantInfo &info)
+        {
+            entities.push_back(SpectatorEntity{server.getEntityId(id.pack()), SpectatorEntityKind::PLANT,
+                                               static_cast<std::uint8_t>(info.type), 0,
+                                               transform.position.toVector2f(), health.current});
+        });
+    m_world.each<Transform, Health, ZombieInfo, ZombieBrain>(
+        [&](EntityId id, const Transform &transform, const Health &health, const ZombieInfo &info, const ZombieBrain &brain)
+        {
+            if (brain.state == ZombieState::DEAD)
+                return;
+            entities.push_back(SpectatorEntity{server.getEntityId(id.pack()), SpectatorEntityKind::ZOMBIE,
+                                               static_cast<std::uint8_t>(info.type),
+                                               static_cast<std::uint8_t>(brain.state),
+                                               transform.position.toVector2f(), health.current});
+        });
+    m_world.each<Transform, ProjectileInfo>(
+        [&](EntityId id, const Transform &transform, const ProjectileInfo &info)
+        {
+            if (info.hasHit)
+                return;
+            entities.push_back(SpectatorEntity{server.getEntityId(id.pack()), SpectatorEntityKind::PROJECTILE,
+                                               static_cast<std::uint8_t>(info.type), 0,
+                                               transform.position.toVector2f(), 0});
+        });
+    m_world.each<Transform, SunState>(
+        [&](EntityId id, const Transform &transform, const SunState &sun)
+        {
+            entities.push_back(SpectatorEntity{server.getEntityId(id.pack()), SpectatorEntityKind::SUN,
+                                               0, 0, transform.position.toVector2f(), sun.value});
+        });
+    server.publish(m_spectatorFrame);
+}
+
+GamePlayState::SimulationOutcome GamePlayState::stepSimulation(Fixed deltaTime)
+{
+    ScopedMetricTimer stepTimer(*m_stepTimeMetric);
+    m_gameTime += deltaTime;
+    m_skySunSpawnTimer += deltaTime;
+
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_SUN]);
+        AllocationScope allocationScope(AllocationTag::SUNS);
+        m_sunPool.update(deltaTime);
+
+        if (m_skySunSpawnTimer >= m_currentSkySunSpawnInterval)
+        {
+            spawnSunFromSky();
+        }
+    }
+
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_PLANTS]);
+        AllocationScope allocationScope(AllocationTag::PLANTS);
+        m_plantManager.update(deltaTime);
+        // 同一 tick 的多次射击只播一次, 声部数另由混音器按片段限制
+        if (m_plantManager.getShotsFiredLastUpdate() > 0)
+            m_soundRequests.push_back(SFX_PEASHOOT);
+    }
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_PROJECTILES]);
+        AllocationScope allocationScope(AllocationTag::PROJECTILES);
+        m_projectileManager.update(deltaTime, FixedRect::fromRect(m_grid.getWorldBounds()));
+    }
+
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_ZOMBIES]);
+        AllocationScope allocationScope(AllocationTag::ZOMBIES);
+        m_zombieManager.update(deltaTime);
+        if (m_zombieManager.hasZombieReached(Fixed::fromFloat(ZOMBIE_REACHED_HOUSE_X)))
+        {
+            return SimulationOutcome::LOST;
+        }
+    }
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_COLLISION]);
+        // 碰撞只产生子弹命中 (销毁子弹、扣血), 计入子弹
+        AllocationScope allocationScope(AllocationTag::PROJECTILES);
+        m_collisionSystem.update(m_world, m_particleRequests, m_soundRequests);
+    }
+    {
+        ScopedMetricTimer timer(*m_systemTimeMetrics[SYSTEM_WAVES]);
+        // 波次管理器的分配都是生成僵尸
+        AllocationScope allocationScope(AllocationTag::ZOMBIES);
+        m_waveManager.update(deltaTime);
+    }
+
+    if (m_waveManager.getCurrentWaveNumber() >= TOTAL_WAVES_TO_WIN &&
+        m_waveManager.getCurrentSpawnState() == SpawnState::ALL_WAVES_COMPLETED &&
+        m_zombieManager.getActiveZombieCount() == 0)
+    {
+        return SimulationOutcome::WON;
+    }
+    return SimulationOutcome::RUNNING;
+}
+
+bool GamePlayState::rewindToTick(std::uint32_t targetTick)
+{
+    // 联机时单方面回溯会导致不同步
+    if (m_lockstep || targetTick >= m_simTick)
+        return false;
+
+    std::uint32_t restoredTick = 0;
+    if (!m_rewindBuffer.restore(targetTick, m_rewindScratch, restoredTick) || !applySnapshot(m_rewindScratch))
+    {
+        std::cerr << "GamePlayState: No rewind capture available for tick " << targetTick << "." << std::endl;
+        return false;
+    }
+
+    // 从记录点按原输入重新模拟到目标 tick, 固定步长保证结果一致
+    auto commandIt = std::lower_bound(m_commandLog.begin(), m_commandLog.end(), restoredTick,
+                                      [](const PlayerCommand &command, std::uint32_t tick)
+                                      { return command.tick < tick; });
+    m_simTick = restoredTick;
+    while (m_simTick < targetTick)
+    {
+        while (commandIt != m_commandLog.end() && commandIt->tick == m_simTick)
+        {
+            executePlayerCommand(*commandIt);
+            ++commandIt;
+        }
+        stepSimulation(SIM_TICK_DT);
+        m_simTick++;
+    }
+
+    // 目标之后的时间线作废
+    while (!m_commandLog.empty() && m_commandLog.back().tick >= targetTick)
+    {
+        m_commandLog.pop_back();
+    }
+    m_rewindBuffer.truncateAfter(targetTick);
+    requestParticleClear();
+    return true;
+}
+
+void GamePlayState::rewindSeconds(float seconds)
+{
+    queueSimulationInput(SimulationInput{SimulationInputType::REWIND_SECONDS, PlayerCommand{}, seconds});
+}
+
+void GamePlayState::releaseLevelStorage()
+{
+    // 先经由各管理器清除, 网格占用和管理器自己的索引随之清空
+    m_plantManager.clear();
+    m_projectileManager.clear();
+    m_zombieManager.clear();
+    m_sunPool.clear();
+    m_world.releaseStorage();
+    m_levelArena.reset();
+    std::cout << "GamePlayState: Level arena released (peak " << m_levelArena.getPeakBytes() / 1024 << " KB of "
+              << m_levelArena.getCapacity() / 1024 << " KB, " << m_levelArena.getOverflowCount() << " overflow allocations)." << std::endl;
+}
+
+GamePlayState::SimulationOutcome GamePlayState::continueSoakTest(SimulationOutcome outcome)
+{
+    // 开局就输掉也算一波, 保证测试一定能结束
+    m_soakWavesCompleted += static_cast<std::uint32_t>(std::max(1, m_waveManager.getCurrentWaveNumber()));
+    std::cout << "GamePlayState: Soak run " << (outcome == SimulationOutcome::WON ? "won" : "lost") << ", "
+              << m_soakWavesCompleted << "/" << m_soakWaves << " waves." << std::endl;
+    performResetLevel();
+    if (m_soakWavesCompleted >= m_soakWaves)
+    {
+        m_memoryCheckFailed = !checkMemoryBaseline();
+        m_soakWaves = 0;
+        m_exitRequested = true;
+    }
+    return SimulationOutcome::RUNNING;
+}
+
+bool GamePlayState::checkMemoryBaseline() const
+{
+    // 资源和音频是全局常驻/后台加载的, 其他线程的分配不归关卡管, 只比较关卡相关的标签
+    const AllocationTag levelTags[] = {AllocationTag::PLANTS, AllocationTag::ZOMBIES, AllocationTag::PROJECTILES,
+                                       AllocationTag::SUNS, AllocationTag::UI, AllocationTag::STATES};
+    bool passed = true;
+    for (AllocationTag tag : levelTags)
+    {
+        std::uint64_t baseline = m_memoryBaseline[static_cast<std::size_t>(tag)];
+        std::uint64_t live = AllocationCounter::getLiveBytes(tag);
+        bool withinTolerance = live <= baseline + MEMORY_BASELINE_TOLERANCE_BYTES;
+        passed = passed && withinTolerance;
+        std::cout << "GamePlayState: Memory check " << AllocationCounter::getTagName(tag) << ": baseline "
+                  << baseline << " B, now " << live << " B" << (withinTolerance ? "" : " (OVER TOLERANCE)") << std::endl;
+    }
+    std::cout << "GamePlayState: Memory check after " << m_soakWavesCompleted << " waves "
+              << (passed ? "PASSED" : "FAILED") << "." << std::endl;
+    return passed;
+}
+
+void GamePlayState::performRewindSeconds(float seconds)
+{
+    std::uint32_t ticks = static_cast<std::uint32_t>(seconds / TIME_PER_FRAME.asSeconds());
+    std::uint32_t oldestTick = m_rewindBuffer.getOldestTick();
+    std::uint32_t targetTick = (m_simTick > oldestTick + ticks) ? m_simTick - ticks : oldestTick;
+    if (rewindToTick(targetTick))
+    {
+        std::cout << "GamePlayState: Rewound to tick " << m_simTick << " (" << m_gameTime.toFloat() << "s)." << std::endl;
+    }
+}
+
+void GamePlayState::resetRewindHistory()
+{
+    m_simTick = 0;
+    m_commandLog.clear();
+    m_rewindBuffer.clear();
+    saveSnapshot(m_rewindScratch);
+    m_rewindBuffer.capture(m_simTick, m_rewindScratch);
+}
+
+bool GamePlayState::issuePlayerCommand(PlayerCommand command)
+{
+    command.player = static_cast<std::uint8_t>(m_localPlayer);
+    if (m_lockstep)
+    {
+        // 联机: 操作延后到双方都收到后的 tick 才执行, 这里只按本地状态预判能否生效
+        if (command.type == PlayerCommandType::COLLECT_SUN && !m_sunPool.hasSunAt(command.worldPos))
+            return false;
+        m_lockstep->queueLocalCommand(command);
+        return true;
     }
 
-    std::stringstream ss;
-    ss.precision(1);
-    ss << std::fixed;
-    ss << "Time: " << m_gameTime << "s | FPS: " << static_cast<int>(1.f / deltaTime)
-       << " | Mouse: (" << m_mousePixelPos.x << "," << m_mousePixelPos.y << ")"
-       << " | Suns: " << m_sunManager.getCurrentSun()
-       << " | Entities: S:" << m_activeSuns.size()
-       << " P:" << m_projectileManager.getAllProjectiles().size()
-       << " Z:" << m_zombieManager.getActiveZombies().size()
-       << " | Plants: " << m_plantManager.getAllActivePlants().size()
-       << " | " << m_waveManager.getCurrentWaveStatusText();
-    m_debugInfoText.setString(ss.str());
+    command.tick = m_simTick;
+    bool applied = executePlayerCommand(command);
+    recordLocalPlantResult(command, applied);
+    if (!applied)
+        return false;
+    m_commandLog.push_back(command);
+    return true;
+}
+
+bool GamePlayState::loadCommandScript(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "GamePlayState: Failed to open command script " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream in(line);
+        PlayerCommand command{};
+        std::string verb;
+        bool parsed = false;
+        if (in >> command.tick >> verb)
+        {
+            if (verb == "plant")
+            {
+                int type = -1;
+                command.type = PlayerCommandType::PLANT;
+                parsed = static_cast<bool>(in >> type >> command.gridPos.x >> command.gridPos.y);
+                command.plantType = static_cast<PlantType>(type);
+            }
+            else if (verb == "shovel")
+            {
+                command.type = PlayerCommandType::SHOVEL;
+                parsed = static_cast<bool>(in >> command.gridPos.x >> command.gridPos.y);
+            }
+            else if (verb == "collect")
+            {
+                command.type = PlayerCommandType::COLLECT_SUN;
+                parsed = static_cast<bool>(in >> command.worldPos.x >> command.worldPos.y);
+            }
+            else if (verb == "sun")
+            {
+                command.type = PlayerCommandType::ADD_SUN;
+                parsed = static_cast<bool>(in >> command.amount);
+            }
+        }
+        if (!parsed)
+        {
+            std::cerr << "GamePlayState: Ignoring command script line " << lineNumber << ": " << line << std::endl;
+            continue;
+        }
+        m_scriptedCommands.push_back(command);
+    }
+    // 同一 tick 的操作保持脚本里的先后顺序
+    std::stable_sort(m_scriptedCommands.begin(), m_scriptedCommands.end(),
+                     [](const PlayerCommand &a, const PlayerCommand &b)
+                     { return a.tick < b.tick; });
+    std::cout << "GamePlayState: Loaded " << m_scriptedCommands.size() << " scripted commands from " << path << std::endl;
+    return true;
+}
+
+void GamePlayState::issueScriptedCommands()
+{
+    // 与玩家输入走同一条路径 (写入输入日志), 回溯重放时不会重复执行
+    auto it = std::lower_bound(m_scriptedCommands.begin(), m_scriptedCommands.end(), m_simTick,
+                               [](const PlayerCommand &command, std::uint32_t tick)
+                               { return command.tick < tick; });
+    for (; it != m_scriptedCommands.end() && it->tick == m_simTick; ++it)
+    {
+        issuePlayerCommand(*it);
+    }
+}
+
+void GamePlayState::recordLocalPlantResult(const PlayerCommand &command, bool placed)
+{
+    if (command.type != PlayerCommandType::PLANT || !isValidPlantType(command.plantType))
+        return;
+    std::size_t typeIndex = static_cast<std::size_t>(command.plantType);
+    m_plantRequestsResolved[typeIndex]++;
+    if (placed)
+        m_plantsPlaced[typeIndex]++;
+}
+
+bool GamePlayState::executePlayerCommand(const PlayerCommand &command)
+{
+    switch (command.type)
+    {
+    case PlayerCommandType::PLANT:
+    {
+        AllocationScope allocationScope(AllocationTag::PLANTS);
+        // 花费由模拟按植物类型查表, 不信任指令里的数值 (可能来自联机对方)
+        if (!isValidPlantType(command.plantType))
+            return false;
+        int cost = getPlantDescriptor(command.plantType).cost;
+        if (m_grid.isCellOccupied(command.gridPos.x, command.gridPos.y) ||
+            getSunBank(command.player).getCurrentSun() < cost)
+            return false;
+        if (!m_plantManager.tryAddPlant(command.plantType, command.gridPos))
+            return false;
+        getSunBank(command.player).trySpendSun(cost);
+        return true;
+    }
+    case PlayerCommandType::SHOVEL:
+    {
+        AllocationScope allocationScope(AllocationTag::PLANTS);
+        EntityId plantToShovel = m_plantManager.getPlantAt(command.gridPos);
+        if (!plantToShovel.isValid())
+            return false;
+        m_plantManager.removePlant(plantToShovel);
+        return true;
+    }
+    case PlayerCommandType::COLLECT_SUN:
+    {
+        AllocationScope allocationScope(AllocationTag::SUNS);
+        return m_sunPool.tryCollectAt(command.worldPos, getSunBank(command.player));
+    }
+    case PlayerCommandType::ADD_SUN:
+        getSunBank(command.player).addSun(command.amount);
+        return true;
+    }
+    return false;
 }
 
 void GamePlayState::render(sf::RenderWindow &window)
 {
+    // 世界内容用摄像机视图绘制, 并剔除视野外的实体
+    const sf::View uiView = window.getView();
+    window.setView(m_camera.getView());
+    sf::FloatRect visibleArea = m_camera.getVisibleArea();
 
-    window.draw(m_BackgroundSpite);
-    m_grid.render(window);
-    m_plantManager.draw(window);
-    for (const auto &sun : m_activeSuns)
+    // 静态图层在世界坐标中只画一次, 平移/缩放只改变摄像机视图
+    if (m_staticLayer.isUsable() &&
+        (!m_staticLayer.isValid() || m_staticLayerGridVersion != m_grid.getLayoutVersion()))
+    {
+        m_staticLayerGridVersion = m_grid.getLayoutVersion();
+        float pixelsPerUnit = static_cast<float>(window.getSize().x) / static_cast<float>(WINDOW_WIDTH);
+        m_staticLayer.rebuild(m_grid.getWorldBounds(), pixelsPerUnit, [this](sf::RenderTarget &target)
+                              { drawStaticContent(target); });
+    }
+    if (m_staticLayer.isValid())
+    {
+        m_staticLayer.draw(window);
+    }
+    else
     {
-        sun->draw(window);
+        drawStaticContent(window);
     }
-    m_projectileManager.draw(window);
-    m_zombieManager.draw(window);
+    // 实体来自模拟线程最新发布的快照, 精灵停在 (0,0), 合批时平移到快照里的位置
+    const RenderSnapshot &snapshot = m_renderSnapshots.getReadBuffer();
+    m_spriteBatch.build(snapshot.sprites, visibleArea);
+    m_spriteBatch.draw(window);
+    m_particleSystem.draw(window, visibleArea);
+
+    // HUD 固定在屏幕上
+    window.setView(uiView);
+    AllocationScope allocationScope(AllocationTag::UI);
     m_hud.draw(window);
     window.draw(m_debugInfoText);
 }
 
+void GamePlayState::drawStaticContent(sf::RenderTarget &target) const
+{
+    target.draw(m_BackgroundSpite);
+    m_grid.render(target);
+}
+
 void GamePlayState::spawnSunFromSky()
 {
-    sf::RenderWindow &window = m_stateManager->getGame()->getWindow();
-    float spawnX = randomFloat(window.getSize().x * 0.05f, window.getSize().x * 0.95f);
-    float spawnY = -30.f;
-    float groundMinY = GRID_START_Y + (GRID_ROWS / 2.0f) * GRID_CELL_HEIGHT;
-    float groundMaxY = GRID_START_Y + GRID_ROWS * GRID_CELL_HEIGHT - GRID_CELL_HEIGHT * 0.5f;
-    groundMaxY = std::min(groundMaxY, static_cast<float>(window.getSize().y - 50.f));
+    // 落点只取决于棋盘 (与摄像机无关), 保证快照恢复后的模拟可复现; 默认棋盘时即整个窗口
+    FixedRect visibleArea = FixedRect::fromRect(m_grid.getWorldBounds());
+    Fixed gridStartY = Fixed::fromFloat(m_grid.getGridStartPosition().y);
+    Fixed cellHeight = Fixed::fromFloat(m_grid.getCellSize().y);
+    Fixed spawnX = m_rng.nextFixed(visibleArea.left + visibleArea.width * Fixed::fromFloat(0.05f),
+                                   visibleArea.left + visibleArea.width * Fixed::fromFloat(0.95f));
+    Fixed spawnY = visibleArea.top - 30;
+    Fixed gridTop = Fixed::max(gridStartY, visibleArea.top);
+    Fixed gridBottom = Fixed::min(gridStartY + cellHeight * m_grid.getRows(), visibleArea.getBottom());
+    Fixed groundMinY = gridTop + (gridBottom - gridTop) / 2;
+    Fixed groundMaxY = gridBottom - cellHeight / 2;
+    groundMaxY = Fixed::min(groundMaxY, visibleArea.getBottom() - 50);
     if (groundMinY >= groundMaxY)
-        groundMinY = groundMaxY - 50.f;
-    float targetY = randomFloat(groundMinY, groundMaxY);
+        groundMinY = groundMaxY - 50;
+    Fixed targetY = m_rng.nextFixed(groundMinY, groundMaxY);
 
-    m_activeSuns.emplace_back(std::make_unique<Sun>(
-        m_stateManager->getGame()->getResourceManager(), m_sunManager,
-        sf::Vector2f(spawnX, spawnY), SunSpawnType::FROM_SKY, targetY));
+    m_sunPool.spawn(FixedVector2(spawnX, spawnY), SunSpawnType::FROM_SKY, targetY);
 
-    m_skySunSpawnTimer.restart();
-    m_currentSkySunSpawnInterval = randomFloat(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
+    m_skySunSpawnTimer = 0;
+    m_currentSkySunSpawnInterval = m_rng.nextFixed(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
 }
 
-void GamePlayState::spawnSunFromPlant(Plant *plant)
+void GamePlayState::spawnSunFromPlant(const FixedVector2 &plantPosition, Fixed plantHeight)
 {
-    if (!plant)
-        return;
-    sf::Vector2f plantPos = plant->getPosition();
-    float heightOffset = plant->getGlobalBounds().height * 0.3f;
+    Fixed heightOffset = plantHeight * Fixed::fromFloat(0.3f);
     if (heightOffset <= 0)
-        heightOffset = 20.f;
+        heightOffset = 20;
 
-    sf::Vector2f sunSpawnPos = sf::Vector2f(plantPos.x, plantPos.y - heightOffset);
-    m_activeSuns.emplace_back(std::make_unique<Sun>(
-        m_stateManager->getGame()->getResourceManager(), m_sunManager,
-        sunSpawnPos, SunSpawnType::FROM_PLANT));
+    FixedVector2 sunSpawnPos(plantPosition.x, plantPosition.y - heightOffset);
+    AllocationScope allocationScope(AllocationTag::SUNS);
+    m_sunPool.spawn(sunSpawnPos, SunSpawnType::FROM_PLANT);
 }
 
 void GamePlayState::resetLevel()
 {
+    queueSimulationInput(SimulationInput{SimulationInputType::RESET_LEVEL, PlayerCommand{}, 0.f});
+}
+
+void GamePlayState::performResetLevel()
+{
+    if (m_lockstep)
+    {
+        // 联机时只能双方同时重开, 单方面重置会导致不同步
+        std::cout << "GamePlayState: Restart is not available in co-op." << std::endl;
+        return;
+    }
     std::cout << "GamePlayState: Resetting level..." << std::endl;
+    // 旧关卡的组件块整体归还, 检查点重新从内存区起点分配
+    releaseLevelStorage();
 
-    m_isGameOver = false;
-    m_gameTime = 0.f;
+    if (!m_checkpointSnapshot.empty() && loadSnapshot(m_checkpointSnapshot))
+    {
+        std::cout << "GamePlayState: Level restored from checkpoint." << std::endl;
+        return;
+    }
+
+    m_gameTime = 0;
 
     m_sunManager.reset();
-    m_plantManager.clear();
-    m_projectileManager.clear();
-    m_zombieManager.clear();
+    m_playerTwoSunManager.reset();
     m_waveManager.reset();
     m_waveManager.start();
+    requestParticleClear();
 
-    m_activeSuns.clear();
-
-    m_skySunSpawnTimer.restart();
-    m_currentSkySunSpawnInterval = randomFloat(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
+    m_skySunSpawnTimer = 0;
+    m_currentSkySunSpawnInterval = m_rng.nextFixed(m_skySunSpawnIntervalMin, m_skySunSpawnIntervalMax);
+    resetRewindHistory();
 
     std::cout << "GamePlayState: Level reset complete." << std::endl;
-}
\ No newline at end of file
+}
+
+void GamePlayState::saveSnapshot(std::vector<std::uint8_t> &outBuffer) const
+{
+    outBuffer.clear();
+    BinaryWriter writer(outBuffer);
+
+    writer.write<std::uint32_t>(SNAPSHOT_MAGIC);
+    writer.write<std::uint16_t>(SNAPSHOT_VERSION);
+    writer.write<std::int32_t>(m_grid.getRows());
+    writer.write<std::int32_t>(m_grid.getCols());
+
+    writer.writeFixed(m_gameTime);
+    writer.writeFixed(m_skySunSpawnTimer);
+    writer.writeFixed(m_currentSkySunSpawnInterval);
+    writer.write(m_rng.getState());
+    writer.write(m_rng.getIncrement());
+    writer.write<std::int32_t>(m_sunManager.getCurrentSun());
+    writer.write<std::int32_t>(m_playerTwoSunManager.getCurrentSun());
+
+    m_waveManager.saveState(writer);
+    m_plantManager.saveState(writer);
+    m_zombieManager.saveState(writer);
+    m_projectileManager.saveState(writer);
+    m_sunPool.saveState(writer);
+}
+
+bool GamePlayState::loadSnapshot(const std::vector<std::uint8_t> &buffer)
+{
+    // 先检查文件头, 不合法时不动当前状态
+    BinaryReader header(buffer);
+    std::uint32_t magic = header.read<std::uint32_t>();
+    std::uint16_t version = header.read<std::uint16_t>();
+    std::int32_t rows = header.read<std::int32_t>();
+    std::int32_t cols = header.read<std::int32_t>();
+    if (!header.isOk() || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION)
+    {
+        std::cerr << "GamePlayState: Snapshot rejected (bad header or version " << version << ")." << std::endl;
+        return false;
+    }
+    if (rows != m_grid.getRows() || cols != m_grid.getCols())
+    {
+        std::cerr << "GamePlayState: Snapshot board " << rows << "x" << cols << " does not match current board "
+                  << m_grid.getRows() << "x" << m_grid.getCols() << "." << std::endl;
+        return false;
+    }
+
+    // 中途读坏时回滚到读档前的状态
+    std::vector<std::uint8_t> previousState;
+    saveSnapshot(previousState);
+    if (applySnapshot(buffer))
+    {
+        // 读档后旧时间线的回溯记录不再有效
+        resetRewindHistory();
+        return true;
+    }
+    std::cerr << "GamePlayState: Snapshot is truncated or corrupt, restoring previous state." << std::endl;
+    applySnapshot(previousState);
+    return false;
+}
+
+bool GamePlayState::applySnapshot(const std::vector<std::uint8_t> &buffer)
+{
+    BinaryReader reader(buffer);
+    reader.read<std::uint32_t>();
+    reader.read<std::uint16_t>();
+    reader.read<std::int32_t>();
+    reader.read<std::int32_t>();
+
+    m_gameTime = reader.readFixed();
+    m_skySunSpawnTimer = reader.readFixed();
+    m_currentSkySunSpawnInterval = reader.readFixed();
+    std::uint64_t rngState = reader.read<std::uint64_t>();
+    std::uint64_t rngIncrement = reader.read<std::uint64_t>();
+    m_rng.setState(rngState, rngIncrement);
+    m_sunManager.setCurrentSun(reader.read<std::int32_t>());
+    m_playerTwoSunManager.setCurrentSun(reader.read<std::int32_t>());
+
+    // 植物必须先于僵尸恢复, 僵尸的攻击目标按格子从网格取回
+    bool ok = m_waveManager.loadState(reader) &&
+              m_plantManager.loadState(reader) &&
+              m_zombieManager.loadState(reader) &&
+              m_projectileManager.loadState(reader) &&
+              m_sunPool.loadState(reader);
+
+    requestParticleClear();
+    return ok && reader.isAtEnd();
+}
+
+void GamePlayState::quickSave()
+{
+    sf::Clock timer;
+    saveSnapshot(m_quickSaveSnapshot);
+    sf::Int64 elapsedUs = timer.getElapsedTime().asMicroseconds();
+
+    // 写盘交给主线程, 模拟线程只复制一份缓冲区
+    {
+        std::lock_guard<std::mutex> lock(m_quickSaveMutex);
+        m_pendingQuickSave.assign(m_quickSaveSnapshot.begin(), m_quickSaveSnapshot.end());
+    }
+    std::cout << "GamePlayState: Quick saved " << m_quickSaveSnapshot.size() << " bytes in " << elapsedUs << " us." << std::endl;
+}
+
+void GamePlayState::quickLoad()
+{
+    if (m_lockstep)
+    {
+        std::cout << "GamePlayState: Quick load is not available in co-op." << std::endl;
+        return;
+    }
+    // 本局还没存过档时使用主线程从文件读出的存档
+    if (m_quickSaveSnapshot.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_quickSaveMutex);
+        m_quickSaveSnapshot.swap(m_pendingQuickLoad);
+    }
+    if (m_quickSaveSnapshot.empty())
+    {
+        std::cout << "GamePlayState: No quick save to load." << std::endl;
+        return;
+    }
+
+    sf::Clock timer;
+    bool loaded = loadSnapshot(m_quickSaveSnapshot);
+    sf::Int64 elapsedUs = timer.getElapsedTime().asMicroseconds();
+    if (loaded)
+    {
+        std::cout << "GamePlayState: Quick loaded " << m_quickSaveSnapshot.size() << " bytes in " << elapsedUs << " us." << std::endl;
+    }
+}
+
+void GamePlayState::writePendingQuickSave()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_quickSaveMutex);
+        if (m_pendingQuickSave.empty())
+            return;
+        m_quickSaveWriteBuffer.swap(m_pendingQuickSave);
+        m_pendingQuickSave.clear();
+    }
+
+    std::ofstream file(QUICKSAVE_FILE_PATH, std::ios::binary);
+    if (file)
+    {
+        file.write(reinterpret_cast<const char *>(m_quickSaveWriteBuffer.data()), static_cast<std::streamsize>(m_quickSaveWriteBuffer.size()));
+    }
+    else
+    {
+        std::cerr << "GamePlayState: Failed to write quick save file: " << QUICKSAVE_FILE_PATH << std::endl;
+    }
+}
+
+void GamePlayState::requestQuickLoad()
+{
+    // 本局按过 F5 时模拟线程手里已有存档 (输入按顺序处理), 否则先在主线程读文件
+    if (!m_quickSaveRequested && !m_lockstep)
+    {
+        std::ifstream file(QUICKSAVE_FILE_PATH, std::ios::binary);
+        if (file)
+        {
+            std::vector<std::uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            std::lock_guard<std::mutex> lock(m_quickSaveMutex);
+            m_pendingQuickLoad.swap(buffer);
+        }
+    }
+    queueSimulationInput(SimulationInput{SimulationInputType::QUICK_LOAD, PlayerCommand{}, 0.f});
+}
@@ -1,71 +1,308 @@
 #pragma once
 
 #include "Core/GameState.h"
+#include "Core/SimulationThread.h"
+#include "Core/ResourceScope.h"
 #include "../Systems/Grid.h"
 #include "../Systems/ProjectileManager.h"
 #include "../Systems/PlantManager.h"
 #include "../Systems/ZombieManager.h"
 #include "../UI/HUD.h"
 #include "../Systems/SunManager.h"
-#include "../Entities/Sun.h"
+#include "../Systems/SunPool.h"
 #include "../Systems/CollisionSystem.h"
 #include "../Systems/WaveManager.h"
+#include "../Systems/StaticLayer.h"
+#include "../Systems/Camera.h"
+#include "../Systems/ParticleSystem.h"
+#include "../Systems/SpriteBatch.h"
+#include "../Systems/RewindBuffer.h"
+#include "../Systems/PlayerCommand.h"
+#include "../Systems/RenderSnapshot.h"
+#include "../Network/LockstepSession.h"
+#include "../Network/SpectatorServer.h"
+#include "../Utils/GameRandom.h"
+#include "../Utils/LinearArena.h"
+#include "../Utils/AllocationCounter.h"
+#include "../Utils/MetricsRegistry.h"
+#include "../Utils/SpscQueue.h"
+#include "../Utils/TripleBuffer.h"
+#include "../Utils/Constants.h"
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <fstream>
 #include <vector>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <cstdint>
 
 class StateManager;
-class Plant;
 
+// 关卡模拟跑在独立的模拟线程上 (固定 60Hz), 主线程只负责输入、摄像机、粒子、HUD 和绘制:
+// 模拟线程每个 tick 把绘制所需数据写成 RenderSnapshot 发布到三缓冲, 主线程取最新一份绘制;
+// 主线程的玩家操作经 SPSC 队列交给模拟线程, 模拟产生的粒子请求经另一条 SPSC 队列送回主线程
+// 模拟状态 (各管理器、网格占用、阳光数、回溯/联机/观战) 只在模拟线程上读写, 线程未运行时 (enter 之前、exit 之后) 除外
 class GamePlayState : public GameState
 {
 public:
     GamePlayState(StateManager *stateManager);
-    ~GamePlayState() override = default;
+    ~GamePlayState() override;
     void enter() override;
     void exit() override;
+    std::span<const SoundAsset> getSoundManifest() const override;
     void handleEvent(const sf::Event &event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow &window) override;
-    void spawnSunFromPlant(Plant *plant);
+    // 被暂停菜单等覆盖时模拟线程停止推进
+    void pause() override;
+    void resume() override;
+    // 模拟线程上由向日葵调用
+    void spawnSunFromPlant(const FixedVector2 &plantPosition, Fixed plantHeight);
+
+    // 主线程调用: 请求在下一个模拟 tick 重开关卡 / 回溯若干秒
     void resetLevel();
+    void rewindSeconds(float seconds);
+
+    // 完整模拟状态的二进制快照 (带版本号), 用于快速存读档和重开关卡; 仅限模拟线程
+    void saveSnapshot(std::vector<std::uint8_t> &outBuffer) const;
+    bool loadSnapshot(const std::vector<std::uint8_t> &buffer);
+
+    // 回溯: 恢复目标 tick 之前最近的记录, 再按输入日志确定性地重新模拟到目标 tick; 仅限模拟线程
+    bool rewindToTick(std::uint32_t targetTick);
 
 private:
+    enum class SimulationOutcome
+    {
+        RUNNING,
+        LOST,
+        WON
+    };
+
+    // 主线程发给模拟线程的请求
+    enum class SimulationInputType
+    {
+        COMMAND,
+        QUICK_SAVE,
+        QUICK_LOAD,
+        RESET_LEVEL,
+        REWIND_SECONDS
+    };
+
+    struct SimulationInput
+    {
+        SimulationInputType type;
+        PlayerCommand command; // COMMAND
+        float seconds;         // REWIND_SECONDS
+    };
+
+    // 单独计时的模拟子系统, 对应指标标签 system="..."
+    enum SimulationSystem
+    {
+        SYSTEM_SUN,
+        SYSTEM_PLANTS,
+        SYSTEM_PROJECTILES,
+        SYSTEM_ZOMBIES,
+        SYSTEM_COLLISION,
+        SYSTEM_WAVES,
+        SYSTEM_COUNT
+    };
+    static const int WAVE_STATE_COUNT = static_cast<int>(SpawnState::ALL_WAVES_COMPLETED) + 1;
+
+    // 模拟线程每个 tick 调用一次: 处理输入, 推进 (或回溯/等待联机输入), 发布渲染快照
+    void simulationTick();
+    // 联机时按 tick 等双方输入到齐再推进, 本 tick 未推进时返回 RUNNING
+    SimulationOutcome updateLockstep();
+    // 直接游戏时推进一步并定期记录回溯快照
+    SimulationOutcome advanceSimulation();
+    // 把本 tick 的精灵、格子占用、HUD 数值和统计文本写入三缓冲并发布
+    void publishRenderSnapshot();
+    // 把本 tick 积累的粒子请求交给主线程; requestParticleClear 用于读档/回溯后清掉旧粒子
+    void flushParticleRequests();
+    void requestParticleClear();
+    // 把本 tick 积累的音效请求交给主线程播放
+    void flushSoundRequests();
+    // 主线程: 处理胜负结果, 返回 true 表示已切换到结算状态
+    bool handleSimulationOutcome(SimulationOutcome outcome);
+    // 主线程: 把操作/请求交给模拟线程, 队列满时返回 false
+    bool queueSimulationInput(const SimulationInput &input);
+    bool queuePlayerCommand(const PlayerCommand &command);
+    // 玩家编号对应的阳光数 (单人只用玩家 0)
+    SunManager &getSunBank(int player);
+    // 收集当前全部实体并交给观战服务广播
+    void broadcastSpectatorFrame();
+    // 在 Game 的指标注册表中登记本关卡用到的指标 / 每帧刷新实体数量和波次仪表
+    void registerMetrics();
+    void recordMetrics();
+    // 确定性校验: 写出本 tick 的状态校验和, 到达 --sim-exit-tick 时通知主线程关闭窗口
+    void recordTickHash();
+
+    // 只推进模拟状态 (不含摄像机/HUD/粒子), 直接游戏和回溯重放共用
+    SimulationOutcome stepSimulation(Fixed deltaTime);
+    // 执行并记录玩家操作, 返回操作是否生效
+    bool issuePlayerCommand(PlayerCommand command);
+    bool executePlayerCommand(const PlayerCommand &command);
+    bool loadCommandScript(const std::string &path);
+    void issueScriptedCommands();
+    // 模拟线程: 累计本地玩家种植请求的处理结果, 随渲染快照交给主线程开始种子冷却
+    void recordLocalPlantResult(const PlayerCommand &command, bool placed);
+    void resetRewindHistory();
     void loadAssets();
     void spawnSunFromSky();
     void spawnInitialZombiesForTesting();
+    void drawStaticContent(sf::RenderTarget &target) const;
+    bool applySnapshot(const std::vector<std::uint8_t> &buffer);
+    // 模拟线程: 序列化/恢复快速存档; 磁盘读写在主线程的 writePendingQuickSave/requestQuickLoad 里
+    void quickSave();
+    void quickLoad();
+    void writePendingQuickSave();
+    void requestQuickLoad();
+    void performResetLevel();
+    void performRewindSeconds(float seconds);
+    // 清除全部实体并把组件块连同关卡内存区一次性归还; 仅在模拟线程未推进时调用
+    void releaseLevelStorage();
+    // 浸泡测试: 一局结束后累计波数并原地重开, 打满后检查内存基线并请求退出; 返回新的模拟结果
+    SimulationOutcome continueSoakTest(SimulationOutcome outcome);
+    // 比较关卡相关标签的存活内存与开局基线, 逐项写日志, 全部在容差内时返回 true
+    bool checkMemoryBaseline() const;
 
-    // 字体
-    sf::Font m_primaryGameFont;
-    sf::Font m_secondaryGameFont;
+    // 本关卡持有的纹理引用, exit 时归还
+    ResourceScope m_resourceScope;
+
+    // 字体: 引用资源管理器里的共享字体, 不复制字形页
+    const sf::Font &m_primaryGameFontRef;
+    const sf::Font &m_secondaryGameFontRef;
     bool m_fontsLoaded;
 
     // 背景
     sf::Sprite m_BackgroundSpite;
+    // 背景 + 网格线的离屏缓存
+    StaticLayer m_staticLayer;
+    unsigned m_staticLayerGridVersion;
 
     // UI
     sf::Text m_debugInfoText;
+    // 调试文本按 DEBUG_TEXT_REFRESH_INTERVAL 刷新, 拼好的文本留在 m_debugTextBuffer 里复用容量
+    float m_debugTextTimer;
+    std::string m_debugTextBuffer;
 
     Grid m_grid;
+    // 关卡摄像机, 棋盘比窗口大时可平移/缩放
+    Camera m_camera;
+    // 关卡内存区: 组件块都从这里分配, 退出/重开关卡时整体回收; 必须先于 m_world 构造
+    LinearArena m_levelArena;
+    // 所有植物/僵尸/子弹/阳光的组件存储, 各管理器只持有引用
+    GameWorld m_world;
     ProjectileManager m_projectileManager;
     PlantManager m_plantManager;
     SunManager m_sunManager;
+    // 联机第二位玩家自己的阳光数
+    SunManager m_playerTwoSunManager;
+    // 主线程上 HUD 显示用的阳光数, 每帧从渲染快照同步 (本地玩家)
+    SunManager m_hudSunBank;
+    // 主线程: 已发出的种植请求数 / 已看到的种植成功数 (按植物类型, 与快照里的累计数比较)
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> m_plantRequestsSent{};
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> m_plantsPlacedSeen{};
+    // 模拟线程: 本地玩家种植请求的累计处理数 / 成功数
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> m_plantRequestsResolved{};
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> m_plantsPlaced{};
     ZombieManager m_zombieManager;
     HUD m_hud;
     WaveManager m_waveManager;
-    std::vector<std::unique_ptr<Sun>> m_activeSuns;
+    SunPool m_sunPool;
+    ParticleSystem m_particleSystem;
+    SpriteBatch m_spriteBatch; // 实体精灵按层/纹理合批 (主线程)
 
-    // 天空阳光生成
-    sf::Clock m_skySunSpawnTimer;
-    float m_skySunSpawnIntervalMin;
-    float m_skySunSpawnIntervalMax;
-    float m_currentSkySunSpawnInterval;
+    // 天空阳光生成 (按模拟时间计时)
+    Fixed m_skySunSpawnTimer;
+    Fixed m_skySunSpawnIntervalMin;
+    Fixed m_skySunSpawnIntervalMax;
+    Fixed m_currentSkySunSpawnInterval;
 
-    float m_gameTime;
+    Fixed m_gameTime;
     sf::Vector2i m_mousePixelPos;
 
     // 碰撞
     CollisionSystem m_collisionSystem;
+    // 模拟线程本 tick 产生的粒子请求, tick 结束时送入 m_particleQueue
+    std::vector<ParticleRequest> m_particleRequests;
+    // 模拟线程本 tick 产生的音效请求, tick 结束时送入 m_soundQueue
+    std::vector<ResourceId> m_soundRequests;
 
+    // 主线程: 已切换到结算状态
     bool m_isGameOver;
+
+    // 模拟用随机数 (天空阳光), 随快照保存
+    GameRandom m_rng;
+
+    // 回溯: 模拟 tick 计数, 快照环形缓冲和对应的输入日志
+    std::uint32_t m_simTick;
+    RewindBuffer m_rewindBuffer;
+    std::deque<PlayerCommand> m_commandLog;
+    std::vector<std::uint8_t> m_rewindScratch;
+
+    // 确定性校验: 每隔 COOP_CHECKSUM_INTERVAL_TICKS 写一行 "tick 校验和"
+    std::ofstream m_tickHashLog;
+    std::uint32_t m_exitTick;
+    // 确定性校验的脚本操作, 按 tick 排序; 每个 tick 按当前 tick 查找, 回溯/重开后照常生效
+    std::vector<PlayerCommand> m_scriptedCommands;
+
+    // 双人合作锁步联机, 单人时为空
+    int m_localPlayer;
+    std::unique_ptr<LockstepSession> m_lockstep;
+    std::vector<PlayerCommand> m_tickCommands;
+
+    // 观战广播服务, 未开启时为空
+    std::unique_ptr<SpectatorServer> m_spectatorServer;
+    SpectatorFrame m_spectatorFrame;
+    std::uint32_t m_lastSpectatorTick;
+
+    // 运行指标 (注册表归 Game 所有, 指针在其生命周期内有效)
+    MetricHistogram *m_stepTimeMetric;
+    MetricHistogram *m_systemTimeMetrics[SYSTEM_COUNT];
+    MetricGauge *m_plantCountMetric;
+    MetricGauge *m_zombieCountMetric;
+    MetricGauge *m_projectileCountMetric;
+    MetricGauge *m_sunCountMetric;
+    MetricGauge *m_waveNumberMetric;
+    MetricGauge *m_waveStateMetrics[WAVE_STATE_COUNT];
+
+    // 浸泡测试: 目标波数 (0 表示未开启)、已打完的波数、开局时各标签的存活字节
+    std::uint32_t m_soakWaves;
+    std::uint32_t m_soakWavesCompleted;
+    std::array<std::uint64_t, AllocationCounter::TAG_COUNT> m_memoryBaseline;
+
+    // 关卡开始时的检查点和快速存档 (模拟线程)
+    std::vector<std::uint8_t> m_checkpointSnapshot;
+    std::vector<std::uint8_t> m_quickSaveSnapshot;
+    // 快速存档的磁盘读写在主线程: 模拟线程存档后放进 m_pendingQuickSave 等待写盘,
+    // 主线程读出的存档文件放进 m_pendingQuickLoad 等待模拟线程读取
+    std::mutex m_quickSaveMutex;
+    std::vector<std::uint8_t> m_pendingQuickSave;
+    std::vector<std::uint8_t> m_pendingQuickLoad;
+    std::vector<std::uint8_t> m_quickSaveWriteBuffer;
+    // 主线程: 本局已请求过快速存档
+    bool m_quickSaveRequested;
+
+    // 单 tick / 单帧的临时内存 (统计和调试文本), 分别在 simulationTick 和 update 结束时回收
+    LinearArena m_tickArena;
+    LinearArena m_frameArena;
+
+    // 模拟线程 <-> 主线程
+    TripleBuffer<RenderSnapshot> m_renderSnapshots;
+    SpscQueue<SimulationInput, SIMULATION_INPUT_QUEUE_CAPACITY> m_inputQueue;
+    SpscQueue<ParticleRequest, PARTICLE_REQUEST_QUEUE_CAPACITY> m_particleQueue;
+    SpscQueue<ResourceId, SOUND_REQUEST_QUEUE_CAPACITY> m_soundQueue;
+    // 主线程每帧写入: 按住退格键倒带
+    std::atomic<bool> m_rewindHeld;
+    // 模拟线程写入, 主线程处理: 胜负结果 / 到达退出 tick
+    std::atomic<SimulationOutcome> m_pendingOutcome;
+    std::atomic<bool> m_exitRequested;
+    std::atomic<bool> m_memoryCheckFailed;
+    // 已分出胜负, 模拟线程不再推进 (等主线程切换状态)
+    bool m_simulationFinished;
+
+    // 最后声明: 析构时最先停止, 其余成员此时都还有效
+    SimulationThread m_simulationThread;
 };
@@ -9,7 +9,7 @@
 #include <iostream>
 
 MenuState::MenuState(StateManager *stateManager)
-    : GameState(stateManager), m_useCustomFont(false), m_mousePosition(0.f, 0.f)
+    : GameState(stateManager), m_fontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_PRIMARY)), m_useCustomFont(false), m_resourceScope(stateManager->getGame()->getResourceManager(), "MenuState"), m_mousePosition(0.f, 0.f)
 {
 }
 
@@ -24,28 +24,16 @@ void MenuState::enter()
     Game *game = m_stateManager->getGame();
     ResourceManager &resManager = game->getResourceManager();
 
-    // 加载字体
-    bool fontLoaded = false;
-    if (m_font.loadFromFile("C:/Windows/Fonts/arial.ttf"))
-    {
-        fontLoaded = true;
-    }
-    else if (m_font.loadFromFile("C:/Windows/Fonts/msyh.ttc"))
-    {
-        fontLoaded = true;
-    }
-    m_useCustomFont = fontLoaded;
+    // 字体: 使用全局共享的主字体, 不再单独从系统目录加载一份
+    m_useCustomFont = resManager.hasFont(FONT_ID_PRIMARY);
 
     // 设置背景
-    std::string backgroundTextureId = "MenuBackgroundTexture";
+    const ResourceId backgroundTextureId{"MenuBackgroundTexture"};
     std::string backgroundTexturePath = "../../assets/images/menu_background.png";
 
-    if (!resManager.hasTexture(backgroundTextureId))
+    if (!m_resourceScope.acquireTexture(backgroundTextureId, backgroundTexturePath))
     {
-        if (!resManager.loadTexture(backgroundTextureId, backgroundTexturePath))
-        {
-            std::cerr << "MenuState::enter: Failed to load background texture: " << backgroundTexturePath << std::endl;
-        }
+        std::cerr << "MenuState::enter: Failed to load background texture: " << backgroundTexturePath << std::endl;
     }
     m_BackgroundSpite.setTexture(resManager.getTexture(backgroundTextureId));
 
@@ -63,9 +51,9 @@ void MenuState::enter()
     m_titleText.setString("Defend Mixue");
     if (m_useCustomFont)
     {
-        m_titleText.setFont(m_font);
+        m_titleText.setFont(m_fontRef);
     }
-    m_titleText.setCharacterSize(60);
+    m_titleText.setCharacterSize(TITLE_FONT_SIZE);
     m_titleText.setFillColor(sf::Color(0, 0, 0));
     sf::FloatRect titleBounds = m_titleText.getLocalBounds();
     m_titleText.setPosition(
@@ -79,6 +67,7 @@ void MenuState::exit()
 {
     std::cout << "Exiting Menu State" << std::endl;
     m_buttons.clear();
+    m_resourceScope.release();
 }
 
 void MenuState::setupButtons()
@@ -90,13 +79,13 @@ void MenuState::setupButtons()
 
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, startY + 0 * spacing),
-        buttonSize, "Start Game", m_font));
+        buttonSize, "Start Game", m_fontRef));
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, startY + 1 * spacing),
-        buttonSize, "Options", m_font));
+        buttonSize, "Options", m_fontRef));
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, startY + 2 * spacing),
-        buttonSize, "Exit", m_font));
+        buttonSize, "Exit", m_fontRef));
 
     m_buttons[0].setCallback([this]()
                              { executeAction("start"); });
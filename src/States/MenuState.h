@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include "../UI/Button.h"
+#include "Core/ResourceScope.h"
 
 class StateManager;
 
@@ -17,13 +18,15 @@ public:
     void handleEvent(const sf::Event &event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow &window) override;
+    bool needsContinuousUpdate() const override { return false; }
 
 private:
     // 字体
-    sf::Font m_font;
+    const sf::Font &m_fontRef; // 全局共享字体, 不复制
     bool m_useCustomFont = false;
 
-    // 背景
+    // 背景, 纹理只在本状态期间持有
+    ResourceScope m_resourceScope;
     sf::Sprite m_BackgroundSpite;
 
     // UI元素
@@ -9,7 +9,7 @@
 #include <iostream>
 
 PauseState::PauseState(StateManager *stateManager)
-    : GameState(stateManager), m_fontLoaded(false)
+    : GameState(stateManager), m_fontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_PRIMARY)), m_fontLoaded(false)
 {
     std::cout << "PauseState constructing..." << std::endl;
 }
@@ -31,29 +31,21 @@ void PauseState::enter()
     m_backgroundOverlay.setPosition(0, 0);
 
     // 2. 加载字体
-    if (resMan.hasFont(FONT_ID_PRIMARY))
+    // 字体由 Game 的全局资源持有并已预热字形, 这里只引用
+    m_fontLoaded = resMan.hasFont(FONT_ID_PRIMARY);
+    if (!m_fontLoaded)
     {
-        m_font = resMan.getFont(FONT_ID_PRIMARY);
-        m_fontLoaded = true;
-    }
-    else if (m_font.loadFromFile(FONT_PATH_ARIAL))
-    {
-        m_fontLoaded = true;
-        std::cerr << "PauseState: Primary font not found, loaded fallback Arial." << std::endl;
-    }
-    else
-    {
-        std::cerr << "PauseState: Failed to load any font for pause text." << std::endl;
+        std::cerr << "PauseState: Primary font not loaded." << std::endl;
     }
 
     // 3. 设置 "Paused" 文本
     m_pauseText.setString("GAME PAUSED");
     if (m_fontLoaded)
-        m_pauseText.setFont(m_font);
-    m_pauseText.setCharacterSize(60);
+        m_pauseText.setFont(m_fontRef);
+    m_pauseText.setCharacterSize(TITLE_FONT_SIZE);
     m_pauseText.setFillColor(sf::Color::White);
     m_pauseText.setOutlineColor(sf::Color::Black);
-    m_pauseText.setOutlineThickness(2.f);
+    m_pauseText.setOutlineThickness(PAUSE_TITLE_OUTLINE_THICKNESS);
     sf::FloatRect textBounds = m_pauseText.getLocalBounds();
     m_pauseText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
     m_pauseText.setPosition(window.getSize().x / 2.f, window.getSize().y / 3.f);
@@ -90,15 +82,23 @@ void PauseState::setupUI()
     // Resume Button
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, currentButtonY),
-        buttonSize, "Resume Game", m_font));
+        buttonSize, "Resume Game", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("resume"); });
     currentButtonY += buttonSpacing;
 
+    // Rewind Button
+    m_buttons.emplace_back(Button(
+        sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, currentButtonY),
+        buttonSize, "Rewind 5s", m_fontRef));
+    m_buttons.back().setCallback([this]()
+                                 { executeAction("rewind"); });
+    currentButtonY += buttonSpacing;
+
     // Restart Button
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, currentButtonY),
-        buttonSize, "Restart", m_font));
+        buttonSize, "Restart", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("restart"); });
     currentButtonY += buttonSpacing;
@@ -106,7 +106,7 @@ void PauseState::setupUI()
     // Main Menu Button
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, currentButtonY),
-        buttonSize, "Main Menu", m_font));
+        buttonSize, "Main Menu", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("menu"); });
 }
@@ -118,6 +118,18 @@ void PauseState::executeAction(const std::string &action)
         std::cout << "PauseState: Action 'resume'. Popping PauseState." << std::endl;
         m_stateManager->popState();
     }
+    else if (action == "rewind")
+    {
+        std::cout << "PauseState: Action 'rewind'. Popping PauseState." << std::endl;
+        // 出栈后本对象即被销毁, 先取出 StateManager 指针
+        StateManager *stateManager = m_stateManager;
+        stateManager->popState();
+        GamePlayState *gameplayState = stateManager->isEmpty() ? nullptr : dynamic_cast<GamePlayState *>(stateManager->getCurrentState());
+        if (gameplayState)
+        {
+            gameplayState->rewindSeconds(REWIND_PAUSE_MENU_SECONDS);
+        }
+    }
     else if (action == "restart")
     {
         std::cout << "PauseState: Action 'restart'. Popping PauseState first." << std::endl;
@@ -18,12 +18,14 @@ public:
     void handleEvent(const sf::Event &event) override;
     void update(float deltaTime) override;
     void render(sf::RenderWindow &window) override;
+    bool isOverlay() const override { return true; }
+    bool needsContinuousUpdate() const override { return false; }
 
 private:
     void setupUI();
     void executeAction(const std::string &action);
 
-    sf::Font m_font;
+    const sf::Font &m_fontRef; // 全局共享字体, 不复制
     bool m_fontLoaded;
 
     sf::Text m_pauseText;
@@ -0,0 +1,257 @@
+#include "SpectatorState.h"
+#include "Core/StateManager.h"
+#include "Core/Game.h"
+#include "Core/ResourceManager.h"
+#include "../Systems/Grid.h"
+#include "../Ecs/EntityDescriptors.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    constexpr ResourceId SPECTATOR_BACKGROUND_TEXTURE_ID{"GamePlayBackgroundTexture"};
+
+    struct TextureAsset
+    {
+        ResourceId key;
+        const char *path;
+    };
+
+    constexpr TextureAsset SPECTATOR_TEXTURES[] = {
+        {SPECTATOR_BACKGROUND_TEXTURE_ID, "../../assets/images/gameplay_background.png"},
+        {SUNFLOWER_TEXTURE_KEY, "../../assets/images/sunflower.png"},
+        {PEASHOOTER_TEXTURE_KEY, "../../assets/images/peashooter.png"},
+        {WALLNUT_TEXTURE_KEY, "../../assets/images/wallnut.png"},
+        {ICE_PEASHOOTER_TEXTURE_KEY, "../../assets/images/ice_peashooter.png"},
+        {BASIC_ZOMBIE_TEXTURE_KEY, "../../assets/images/basic_zombie.png"},
+        {BIG_ZOMBIE_TEXTURE_KEY, "../../assets/images/big_zombie.png"},
+        {BOSS_ZOMBIE_TEXTURE_KEY, "../../assets/images/boss_zombie.png"},
+        {QUICK_ZOMBIE_TEXTURE_KEY, "../../assets/images/quick_zombie.png"},
+        {PEA_TEXTURE_KEY, "../../assets/images/pea.png"},
+        {ICE_PEA_TEXTURE_KEY, "../../assets/images/ice_pea.png"},
+        {SUN_TEXTURE_KEY, "../../assets/images/sun.png"},
+    };
+
+    const float RECONNECT_INTERVAL_SECONDS = 2.f;
+}
+
+SpectatorState::SpectatorState(StateManager *stateManager)
+    : GameState(stateManager),
+      m_resourceScope(stateManager->getGame()->getResourceManager(), "SpectatorState"),
+      m_everConnected(false),
+      m_camera(sf::Vector2f(static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)),
+               Grid(BoardConfig::standard()).getWorldBounds()),
+      m_boardRows(0),
+      m_boardCols(0),
+      m_frameInterval(1.f / SPECTATOR_DEFAULT_RATE_HZ),
+      m_fontLoaded(false)
+{
+}
+
+void SpectatorState::enter()
+{
+    std::cout << "SpectatorState enter." << std::endl;
+    loadAssets();
+    m_statusText.setCharacterSize(DEBUG_TEXT_FONT_SIZE);
+    m_statusText.setFillColor(sf::Color::White);
+    m_statusText.setPosition(10.f, 10.f);
+    tryConnect();
+}
+
+void SpectatorState::exit()
+{
+    std::cout << "SpectatorState exit." << std::endl;
+    m_resourceScope.release();
+}
+
+void SpectatorState::loadAssets()
+{
+    ResourceManager &resMan = m_stateManager->getGame()->getResourceManager();
+    for (const TextureAsset &asset : SPECTATOR_TEXTURES)
+    {
+        if (!m_resourceScope.acquireTexture(asset.key, asset.path))
+        {
+            std::cerr << "SpectatorState: Failed to load texture " << asset.path << std::endl;
+        }
+    }
+    if (resMan.hasTexture(SPECTATOR_BACKGROUND_TEXTURE_ID))
+    {
+        m_backgroundSprite.setTexture(resMan.getTexture(SPECTATOR_BACKGROUND_TEXTURE_ID));
+    }
+    if (resMan.hasFont(FONT_ID_PRIMARY))
+    {
+        m_fontLoaded = true;
+        m_statusText.setFont(resMan.getFont(FONT_ID_PRIMARY));
+    }
+}
+
+void SpectatorState::tryConnect()
+{
+    m_reconnectClock.restart();
+    const SpectatorConfig &config = m_stateManager->getGame()->getSpectatorConfig();
+    // 断线后的套接字和接收缓冲都作废, 每次重连换一个新客户端
+    m_client = std::make_unique<SpectatorClient>();
+    if (m_client->connect(config.viewAddress, config.viewPort, sf::milliseconds(500)))
+    {
+        m_everConnected = true;
+        std::cout << "SpectatorState: Connected to " << config.viewAddress.toString() << ":" << config.viewPort << std::endl;
+    }
+}
+
+void SpectatorState::handleEvent(const sf::Event &event)
+{
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
+    {
+        m_stateManager->popState();
+        return;
+    }
+    m_camera.handleEvent(event, m_stateManager->getGame()->getWindow());
+}
+
+void SpectatorState::update(float deltaTime)
+{
+    m_camera.update(deltaTime, m_stateManager->getGame()->getWindow());
+
+    if (!m_client->isConnected())
+    {
+        if (m_reconnectClock.getElapsedTime().asSeconds() >= RECONNECT_INTERVAL_SECONDS)
+            tryConnect();
+    }
+    else if (m_client->poll())
+    {
+        onFrameReceived();
+    }
+
+    std::stringstream ss;
+    if (!m_client->isConnected())
+    {
+        ss << (m_everConnected ? "Spectator: connection lost, retrying..." : "Spectator: connecting...");
+    }
+    else
+    {
+        ss << "Spectator | tick " << m_currentFrame.tick << " | entities " << m_currentFrame.entities.size()
+           << " | frames " << m_client->getFramesReceived() << " | " << (m_client->getBytesReceived() / 1024) << " KB"
+           << " | decode errors " << m_client->getDecodeErrors();
+    }
+    m_statusText.setString(ss.str());
+}
+
+void SpectatorState::onFrameReceived()
+{
+    const SpectatorFrame &latest = m_client->getLatestFrame();
+    if (latest.rows != m_boardRows || latest.cols != m_boardCols)
+    {
+        // 棋盘尺寸来自广播, 据此调整世界范围和背景
+        m_boardRows = latest.rows;
+        m_boardCols = latest.cols;
+        sf::FloatRect worldBounds = Grid(BoardConfig{m_boardRows, m_boardCols}).getWorldBounds();
+        m_camera.setWorldBounds(worldBounds);
+        m_camera.reset();
+        const sf::Texture *tex = m_backgroundSprite.getTexture();
+        if (tex && tex->getSize().x > 0 && tex->getSize().y > 0)
+        {
+            m_backgroundSprite.setScale(worldBounds.width / tex->getSize().x, worldBounds.height / tex->getSize().y);
+        }
+        m_previousFrame = latest;
+    }
+    else
+    {
+        m_previousFrame = m_currentFrame;
+    }
+    m_currentFrame = latest;
+
+    m_previousIndex.clear();
+    for (size_t i = 0; i < m_previousFrame.entities.size(); ++i)
+    {
+        m_previousIndex[m_previousFrame.entities[i].id] = i;
+    }
+
+    // 插值区间取两帧的 tick 差, 与广播频率无关
+    if (m_currentFrame.tick > m_previousFrame.tick)
+    {
+        m_frameInterval = (m_currentFrame.tick - m_previousFrame.tick) * TIME_PER_FRAME.asSeconds();
+    }
+    m_frameClock.restart();
+}
+
+void SpectatorState::render(sf::RenderWindow &window)
+{
+    sf::View uiView = window.getView();
+    window.setView(m_camera.getView());
+    window.draw(m_backgroundSprite);
+
+    float alpha = std::min(1.f, m_frameClock.getElapsedTime().asSeconds() / std::max(m_frameInterval, 0.001f));
+    for (const SpectatorEntity &entity : m_currentFrame.entities)
+    {
+        sf::Vector2f position = entity.position;
+        auto it = m_previousIndex.find(entity.id);
+        if (it != m_previousIndex.end())
+        {
+            const SpectatorEntity &previous = m_previousFrame.entities[it->second];
+            sf::Vector2f delta = entity.position - previous.position;
+            if (previous.kind == entity.kind && std::hypot(delta.x, delta.y) < SPECTATOR_SNAP_DISTANCE)
+            {
+                position = previous.position + delta * alpha;
+            }
+        }
+        drawEntity(window, entity, position);
+    }
+
+    window.setView(uiView);
+    if (m_fontLoaded)
+    {
+        window.draw(m_statusText);
+    }
+}
+
+void SpectatorState::drawEntity(sf::RenderWindow &window, const SpectatorEntity &entity, const sf::Vector2f &position)
+{
+    const sf::Texture *texture = getTextureFor(entity);
+    if (!texture)
+        return;
+
+    m_entitySprite.setTexture(*texture, true);
+    sf::FloatRect bounds = m_entitySprite.getLocalBounds();
+    // 原点与游戏内实体一致: 僵尸脚底居中, 普通豌豆左上角, 其余居中
+    if (entity.kind == SpectatorEntityKind::ZOMBIE)
+        m_entitySprite.setOrigin(bounds.width / 2.f, bounds.height);
+    else if (entity.kind == SpectatorEntityKind::PROJECTILE && entity.type == static_cast<std::uint8_t>(ProjectileType::PEA))
+        m_entitySprite.setOrigin(0.f, 0.f);
+    else
+        m_entitySprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+
+    bool dying = entity.kind == SpectatorEntityKind::ZOMBIE && entity.state >= static_cast<std::uint8_t>(ZombieState::DYING);
+    m_entitySprite.setColor(dying ? sf::Color(255, 255, 255, 128) : sf::Color::White);
+    m_entitySprite.setPosition(position);
+    window.draw(m_entitySprite);
+}
+
+const sf::Texture *SpectatorState::getTextureFor(const SpectatorEntity &entity) const
+{
+    ResourceId key;
+    switch (entity.kind)
+    {
+    case SpectatorEntityKind::PLANT:
+        if (isValidPlantType(static_cast<PlantType>(entity.type)))
+            key = getPlantDescriptor(static_cast<PlantType>(entity.type)).textureKey;
+        break;
+    case SpectatorEntityKind::ZOMBIE:
+        if (isValidZombieType(static_cast<ZombieType>(entity.type)))
+            key = getZombieDescriptor(static_cast<ZombieType>(entity.type)).textureKey;
+        break;
+    case SpectatorEntityKind::PROJECTILE:
+        key = (entity.type == static_cast<std::uint8_t>(ProjectileType::ICE_PEA)) ? ICE_PEA_TEXTURE_KEY : PEA_TEXTURE_KEY;
+        break;
+    case SpectatorEntityKind::SUN:
+        key = SUN_TEXTURE_KEY;
+        break;
+    }
+
+    ResourceManager &resMan = m_stateManager->getGame()->getResourceManager();
+    if (!key.isValid() || !resMan.hasTexture(key))
+        return nullptr;
+    return &resMan.getTexture(key);
+}
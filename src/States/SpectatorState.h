@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Core/GameState.h"
+#include "../Network/SpectatorClient.h"
+#include "../Systems/Camera.h"
+#include "Core/ResourceScope.h"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <unordered_map>
+
+class StateManager;
+
+// 观众模式: 接收观战广播, 在相邻两帧之间插值绘制 (画面落后一个广播间隔, 换来平滑运动)
+class SpectatorState : public GameState
+{
+public:
+    SpectatorState(StateManager *stateManager);
+    ~SpectatorState() override = default;
+
+    void enter() override;
+    void exit() override;
+    void handleEvent(const sf::Event &event) override;
+    void update(float deltaTime) override;
+    void render(sf::RenderWindow &window) override;
+
+private:
+    void loadAssets();
+    void tryConnect();
+    void onFrameReceived();
+    void drawEntity(sf::RenderWindow &window, const SpectatorEntity &entity, const sf::Vector2f &position);
+    const sf::Texture *getTextureFor(const SpectatorEntity &entity) const;
+
+    ResourceScope m_resourceScope;
+    std::unique_ptr<SpectatorClient> m_client;
+    sf::Clock m_reconnectClock;
+    bool m_everConnected;
+
+    Camera m_camera;
+    int m_boardRows;
+    int m_boardCols;
+
+    // 插值用的前后两帧, 以及上一帧按 id 的索引
+    SpectatorFrame m_previousFrame;
+    SpectatorFrame m_currentFrame;
+    std::unordered_map<std::uint32_t, size_t> m_previousIndex;
+    sf::Clock m_frameClock;
+    float m_frameInterval;
+
+    sf::Sprite m_backgroundSprite;
+    sf::Sprite m_entitySprite;
+    bool m_fontLoaded;
+    sf::Text m_statusText;
+};
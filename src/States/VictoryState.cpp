@@ -8,7 +8,7 @@
 #include <iostream>
 
 VictoryState::VictoryState(StateManager *stateManager)
-    : GameState(stateManager), m_fontLoaded(false)
+    : GameState(stateManager), m_resourceScope(stateManager->getGame()->getResourceManager(), "VictoryState"), m_fontRef(stateManager->getGame()->getResourceManager().getFont(FONT_ID_PRIMARY)), m_fontLoaded(false)
 {
 }
 
@@ -23,14 +23,11 @@ void VictoryState::enter()
     ResourceManager &resMan = game->getResourceManager();
 
     // 加载背景
-    std::string bgTextureId = "VictoryBackground";
+    const ResourceId bgTextureId{"VictoryBackground"};
     std::string bgTexturePath = "../../assets/images/victory_background.png";
-    if (!resMan.hasTexture(bgTextureId))
+    if (!m_resourceScope.acquireTexture(bgTextureId, bgTexturePath))
     {
-        if (!resMan.loadTexture(bgTextureId, bgTexturePath))
-        {
-            std::cerr << "VictoryState: Failed to load background texture: " << bgTexturePath << std::endl;
-        }
+        std::cerr << "VictoryState: Failed to load background texture: " << bgTexturePath << std::endl;
     }
     m_backgroundSprite.setTexture(resMan.getTexture(bgTextureId));
     const sf::Texture *tex = m_backgroundSprite.getTexture();
@@ -42,35 +39,28 @@ void VictoryState::enter()
     }
     m_backgroundSprite.setPosition(0, 0);
 
-    if (resMan.hasFont(FONT_ID_PRIMARY))
+    // 字体由 Game 的全局资源持有并已预热字形, 这里只引用
+    m_fontLoaded = resMan.hasFont(FONT_ID_PRIMARY);
+    if (!m_fontLoaded)
     {
-        m_font = resMan.getFont(FONT_ID_PRIMARY);
-        m_fontLoaded = true;
-    }
-    else if (m_font.loadFromFile(FONT_PATH_ARIAL))
-    {
-        m_fontLoaded = true;
-    }
-    else
-    {
-        std::cerr << "VictoryState: Failed to load font." << std::endl;
+        std::cerr << "VictoryState: Primary font not loaded." << std::endl;
     }
 
     m_victoryText.setString("VICTORY!");
     if (m_fontLoaded)
-        m_victoryText.setFont(m_font);
-    m_victoryText.setCharacterSize(80);
+        m_victoryText.setFont(m_fontRef);
+    m_victoryText.setCharacterSize(VICTORY_TITLE_FONT_SIZE);
     m_victoryText.setFillColor(sf::Color::Yellow);
     m_victoryText.setOutlineColor(sf::Color(150, 100, 0));
-    m_victoryText.setOutlineThickness(3.f);
+    m_victoryText.setOutlineThickness(VICTORY_TITLE_OUTLINE_THICKNESS);
     sf::FloatRect textBounds = m_victoryText.getLocalBounds();
     m_victoryText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
     m_victoryText.setPosition(WINDOW_WIDTH / 2.f, WINDOW_HEIGHT / 3.f - 40.f);
 
     m_congratsText.setString("You survived all waves!");
     if (m_fontLoaded)
-        m_congratsText.setFont(m_font);
-    m_congratsText.setCharacterSize(36);
+        m_congratsText.setFont(m_fontRef);
+    m_congratsText.setCharacterSize(VICTORY_SUBTITLE_FONT_SIZE);
     m_congratsText.setFillColor(sf::Color::White);
     textBounds = m_congratsText.getLocalBounds();
     m_congratsText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
@@ -89,14 +79,14 @@ void VictoryState::setupUI()
     // 重新开始
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, buttonYStart),
-        buttonSize, "Play Again", m_font));
+        buttonSize, "Play Again", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("play_again"); });
 
     // 返回主菜单
     m_buttons.emplace_back(Button(
         sf::Vector2f((WINDOW_WIDTH - buttonSize.x) / 2.f, buttonYStart + buttonSpacing),
-        buttonSize, "Main Menu", m_font));
+        buttonSize, "Main Menu", m_fontRef));
     m_buttons.back().setCallback([this]()
                                  { executeAction("menu"); });
 }
@@ -117,6 +107,7 @@ void VictoryState::exit()
 {
     std::cout << "Exiting Victory State" << std::endl;
     m_buttons.clear();
+    m_resourceScope.release();
 }
 void VictoryState::handleEvent(const sf::Event &event)
 {
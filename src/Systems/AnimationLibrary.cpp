@@ -0,0 +1,120 @@
+#include "AnimationLibrary.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <iostream>
+
+std::map<ResourceId, AnimationSet> AnimationLibrary::s_sets;
+std::uint32_t AnimationLibrary::s_clockTick = 0;
+
+namespace
+{
+    struct ClipLayout
+    {
+        AnimationState state;
+        int row;        // 精灵表中的行
+        int frameCount; // 该行使用的帧数
+        float fps;
+        bool loop;
+    };
+
+    struct SheetLayout
+    {
+        int columns;
+        int rows;
+        std::vector<ClipLayout> clips;
+    };
+
+    // 各原型的精灵表布局。当前素材都是单帧 PNG, 所以是 1x1;
+    // 换成多帧精灵表后只需要修改这里的行列数和帧数。
+    const std::map<ResourceId, SheetLayout> &getSheetLayouts()
+    {
+        static const std::map<ResourceId, SheetLayout> layouts = {
+            {BASIC_ZOMBIE_TEXTURE_KEY, {1, 1, {{AnimationState::WALK, 0, 1, 8.f, true}, {AnimationState::ATTACK, 0, 1, 8.f, true}, {AnimationState::DIE, 0, 1, 8.f, false}}}},
+            {BIG_ZOMBIE_TEXTURE_KEY, {1, 1, {{AnimationState::WALK, 0, 1, 6.f, true}, {AnimationState::ATTACK, 0, 1, 6.f, true}, {AnimationState::DIE, 0, 1, 6.f, false}}}},
+            {BOSS_ZOMBIE_TEXTURE_KEY, {1, 1, {{AnimationState::WALK, 0, 1, 5.f, true}, {AnimationState::ATTACK, 0, 1, 5.f, true}, {AnimationState::DIE, 0, 1, 5.f, false}}}},
+            {QUICK_ZOMBIE_TEXTURE_KEY, {1, 1, {{AnimationState::WALK, 0, 1, 12.f, true}, {AnimationState::ATTACK, 0, 1, 10.f, true}, {AnimationState::DIE, 0, 1, 10.f, false}}}},
+            {PEASHOOTER_TEXTURE_KEY, {1, 1, {{AnimationState::IDLE, 0, 1, 8.f, true}, {AnimationState::SHOOT, 0, 1, 12.f, false}}}},
+            {ICE_PEASHOOTER_TEXTURE_KEY, {1, 1, {{AnimationState::IDLE, 0, 1, 8.f, true}, {AnimationState::SHOOT, 0, 1, 12.f, false}}}},
+            {SUNFLOWER_TEXTURE_KEY, {1, 1, {{AnimationState::IDLE, 0, 1, 6.f, true}}}},
+            {WALLNUT_TEXTURE_KEY, {1, 1, {{AnimationState::IDLE, 0, 1, 4.f, true}}}},
+        };
+        return layouts;
+    }
+}
+
+const AnimationClip &AnimationSet::getClip(AnimationState state) const
+{
+    const AnimationClip &clip = clips[static_cast<size_t>(state)];
+    if (!clip.frames.empty())
+    {
+        return clip;
+    }
+    return clips[static_cast<size_t>(AnimationState::IDLE)];
+}
+
+const AnimationSet &AnimationLibrary::getSet(ResourceId textureKey, const sf::Texture &texture)
+{
+    auto found = s_sets.find(textureKey);
+    if (found != s_sets.end())
+    {
+        return found->second;
+    }
+
+    AnimationSet set;
+    sf::Vector2u textureSize = texture.getSize();
+    const auto &layouts = getSheetLayouts();
+    auto layoutIt = layouts.find(textureKey);
+
+    if (layoutIt == layouts.end())
+    {
+        // 未配置的原型: 整张纹理作为单帧 IDLE
+        set.clips[static_cast<size_t>(AnimationState::IDLE)] =
+            AnimationClip{{sf::IntRect(0, 0, textureSize.x, textureSize.y)}, 0.f, true};
+    }
+    else
+    {
+        const SheetLayout &layout = layoutIt->second;
+        int frameWidth = static_cast<int>(textureSize.x) / std::max(1, layout.columns);
+        int frameHeight = static_cast<int>(textureSize.y) / std::max(1, layout.rows);
+
+        for (const ClipLayout &clipLayout : layout.clips)
+        {
+            AnimationClip clip{{}, clipLayout.fps, clipLayout.loop};
+            int frameCount = std::min(clipLayout.frameCount, layout.columns);
+            for (int i = 0; i < frameCount; ++i)
+            {
+                clip.frames.emplace_back(i * frameWidth, clipLayout.row * frameHeight, frameWidth, frameHeight);
+            }
+            set.clips[static_cast<size_t>(clipLayout.state)] = clip;
+        }
+
+        // IDLE 没配置时用第一段动画的首帧, 保证总有可回退的帧
+        AnimationClip &idle = set.clips[static_cast<size_t>(AnimationState::IDLE)];
+        if (idle.frames.empty() && !layout.clips.empty())
+        {
+            const AnimationClip &first = set.clips[static_cast<size_t>(layout.clips.front().state)];
+            if (!first.frames.empty())
+            {
+                idle = AnimationClip{{first.frames.front()}, 0.f, true};
+            }
+        }
+    }
+
+    std::cout << "AnimationLibrary: Built animation set for '" << textureKey << "'." << std::endl;
+    return s_sets.emplace(textureKey, std::move(set)).first->second;
+}
+
+void AnimationLibrary::advanceClock()
+{
+    ++s_clockTick;
+}
+
+std::uint32_t AnimationLibrary::getClockTick()
+{
+    return s_clockTick;
+}
+
+void AnimationLibrary::resetClock()
+{
+    s_clockTick = 0;
+}
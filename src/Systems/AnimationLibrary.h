@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <map>
+#include "../Utils/ResourceId.h"
+#include <vector>
+
+// 动画状态, 植物用 IDLE/SHOOT, 僵尸用 WALK/ATTACK/DIE
+enum class AnimationState
+{
+    IDLE,
+    WALK,
+    ATTACK,
+    SHOOT,
+    DIE,
+    COUNT
+};
+
+// 一段动画: 预先算好的帧矩形 + 播放速度
+struct AnimationClip
+{
+    std::vector<sf::IntRect> frames;
+    float fps;
+    bool loop;
+
+    float getDuration() const { return fps > 0.f ? frames.size() / fps : 0.f; }
+};
+
+// 一个原型 (如 basic_zombie) 的全部动画, 每个原型只构建一次, 所有实例共享
+struct AnimationSet
+{
+    std::array<AnimationClip, static_cast<size_t>(AnimationState::COUNT)> clips;
+
+    // 该状态没有配置动画时回退到 IDLE
+    const AnimationClip &getClip(AnimationState state) const;
+};
+
+// 动画库: 按纹理键缓存各原型的动画数据, 并提供所有实体共用的动画时钟
+class AnimationLibrary
+{
+public:
+    // 第一次请求时根据精灵表布局和纹理尺寸切出帧矩形
+    static const AnimationSet &getSet(ResourceId textureKey, const sf::Texture &texture);
+
+    // 共享时钟 (整数 tick), 每个模拟 tick 推进一次, 进入关卡时归零;
+    // 不用浮点秒累加, 避免长时间运行后精度下降、不同编译选项下帧号不一致
+    static void advanceClock();
+    static std::uint32_t getClockTick();
+    static void resetClock();
+
+private:
+    // std::map 保证地址稳定, Animator 长期持有 AnimationSet 指针
+    static std::map<ResourceId, AnimationSet> s_sets;
+    static std::uint32_t s_clockTick;
+};
@@ -0,0 +1,115 @@
+#include "Camera.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+
+Camera::Camera(const sf::Vector2f &viewSize, const sf::FloatRect &worldBounds)
+    : m_baseSize(viewSize), m_worldBounds(worldBounds), m_zoom(1.f)
+{
+    reset();
+}
+
+void Camera::setWorldBounds(const sf::FloatRect &worldBounds)
+{
+    m_worldBounds = worldBounds;
+    m_zoom = std::min(m_zoom, getMaxZoom());
+    m_view.setSize(m_baseSize * m_zoom);
+    clampToWorld();
+}
+
+void Camera::reset()
+{
+    // 默认对齐世界左上角, 房子和植物区域在视野内
+    m_zoom = 1.f;
+    m_view.setSize(m_baseSize);
+    m_view.setCenter(m_worldBounds.left + m_baseSize.x / 2.f, m_worldBounds.top + m_baseSize.y / 2.f);
+    clampToWorld();
+}
+
+void Camera::update(float dt, const sf::RenderWindow &window)
+{
+    if (!window.hasFocus())
+        return;
+
+    sf::Vector2f direction(0.f, 0.f);
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
+        direction.x -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right))
+        direction.x += 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up))
+        direction.y -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down))
+        direction.y += 1.f;
+
+    if (direction.x != 0.f || direction.y != 0.f)
+    {
+        pan(direction * (CAMERA_PAN_SPEED * m_zoom * dt));
+    }
+}
+
+bool Camera::handleEvent(const sf::Event &event, const sf::RenderWindow &window)
+{
+    if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.delta != 0.f)
+    {
+        sf::Vector2f anchor = window.mapPixelToCoords(
+            sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y), m_view);
+        float factor = event.mouseWheelScroll.delta > 0.f ? 1.f / CAMERA_ZOOM_STEP : CAMERA_ZOOM_STEP;
+        zoomAt(factor, anchor);
+        return true;
+    }
+    return false;
+}
+
+void Camera::pan(const sf::Vector2f &delta)
+{
+    m_view.move(delta);
+    clampToWorld();
+}
+
+void Camera::zoomAt(float factor, const sf::Vector2f &worldAnchor)
+{
+    float newZoom = std::max(CAMERA_MIN_ZOOM, std::min(m_zoom * factor, getMaxZoom()));
+    if (newZoom == m_zoom)
+        return;
+
+    // 保持锚点在屏幕上的位置不变
+    float appliedFactor = newZoom / m_zoom;
+    sf::Vector2f center = m_view.getCenter();
+    m_view.setCenter(worldAnchor + (center - worldAnchor) * appliedFactor);
+    m_zoom = newZoom;
+    m_view.setSize(m_baseSize * m_zoom);
+    clampToWorld();
+}
+
+sf::FloatRect Camera::getVisibleArea() const
+{
+    sf::Vector2f size = m_view.getSize();
+    sf::Vector2f center = m_view.getCenter();
+    return sf::FloatRect(center.x - size.x / 2.f, center.y - size.y / 2.f, size.x, size.y);
+}
+
+void Camera::clampToWorld()
+{
+    sf::Vector2f half = m_view.getSize() / 2.f;
+    sf::Vector2f center = m_view.getCenter();
+
+    // 视野比世界大时居中, 否则限制在世界范围内
+    if (half.x * 2.f >= m_worldBounds.width)
+        center.x = m_worldBounds.left + m_worldBounds.width / 2.f;
+    else
+        center.x = std::max(m_worldBounds.left + half.x, std::min(center.x, m_worldBounds.left + m_worldBounds.width - half.x));
+
+    if (half.y * 2.f >= m_worldBounds.height)
+        center.y = m_worldBounds.top + m_worldBounds.height / 2.f;
+    else
+        center.y = std::max(m_worldBounds.top + half.y, std::min(center.y, m_worldBounds.top + m_worldBounds.height - half.y));
+
+    m_view.setCenter(center);
+}
+
+float Camera::getMaxZoom() const
+{
+    // 最多缩小到整个世界都在视野内
+    float fitX = m_worldBounds.width / m_baseSize.x;
+    float fitY = m_worldBounds.height / m_baseSize.y;
+    return std::max(1.f, std::max(fitX, fitY));
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// 关卡摄像机: 在世界坐标上平移/缩放的 sf::View, 并限制在世界范围内
+class Camera
+{
+public:
+    Camera(const sf::Vector2f &viewSize, const sf::FloatRect &worldBounds);
+
+    void setWorldBounds(const sf::FloatRect &worldBounds);
+    void reset();
+
+    // 方向键平移 (窗口有焦点时)
+    void update(float dt, const sf::RenderWindow &window);
+    // 滚轮缩放, 以光标所在的世界坐标为锚点
+    bool handleEvent(const sf::Event &event, const sf::RenderWindow &window);
+
+    void pan(const sf::Vector2f &delta);
+    void zoomAt(float factor, const sf::Vector2f &worldAnchor);
+
+    const sf::View &getView() const { return m_view; }
+    sf::FloatRect getVisibleArea() const;
+
+private:
+    void clampToWorld();
+    float getMaxZoom() const;
+
+    sf::View m_view;
+    sf::Vector2f m_baseSize;
+    sf::FloatRect m_worldBounds;
+    float m_zoom;
+};
@@ -1,79 +1,79 @@
 #include "CollisionSystem.h"
-#include "../Entities/Projectile.h"
-#include "../Entities/Zombie.h"
-#include "../Entities/Plant.h"
-#include "ProjectileManager.h"
-#include "ZombieManager.h"
-#include "PlantManager.h"
+#include "ZombieBehaviorSystem.h"
+#include "RenderSnapshot.h"
 #include "../Utils/Constants.h"
-#include <iostream>
 
 CollisionSystem::CollisionSystem()
 {
 }
 
-void CollisionSystem::update(ProjectileManager &projectileManager,
-                             ZombieManager &zombieManager,
-                             PlantManager &plantManager)
+void CollisionSystem::update(GameWorld &world, std::vector<ParticleRequest> &particleRequests, std::vector<ResourceId> &soundRequests)
 {
-    std::vector<Projectile *> activeProjectiles = projectileManager.getAllActiveProjectiles();
-    std::vector<Zombie *> activeZombies = zombieManager.getActiveZombies();
-    std::vector<Plant *> activePlants = plantManager.getAllActivePlants();
-
-    checkProjectileZombieCollisions(activeProjectiles, activeZombies);
-    checkZombiePlantCollisions(activeZombies, activePlants, 0.f);
+    // 僵尸与植物的接触由 ZombieBehaviorSystem 的索敌处理
+    checkProjectileZombieCollisions(world, particleRequests, soundRequests);
 }
 
-void CollisionSystem::checkProjectileZombieCollisions(std::vector<Projectile *> &projectiles,
-                                                      std::vector<Zombie *> &zombies)
+void CollisionSystem::checkProjectileZombieCollisions(GameWorld &world, std::vector<ParticleRequest> &particleRequests,
+                                                      std::vector<ResourceId> &soundRequests)
 {
-    for (Projectile *projectile : projectiles)
-    {
-        if (!projectile || projectile->hasHit())
-        {
-            continue;
-        }
-        for (Zombie *zombie : zombies)
+    ZombieArchetype &zombies = world.archetype<ZombieArchetype>();
+    world.each<Transform, Visual, ProjectileInfo>(
+        [&](EntityId projectileId, const Transform &projectileTransform, const Visual &projectileVisual, ProjectileInfo &projectile)
         {
-            if (!zombie || !zombie->isAlive())
-            {
-                continue;
-            }
+            if (projectile.hasHit)
+                return;
 
-            if (projectile->getGlobalBounds().intersects(zombie->getGlobalBounds()))
+            FixedRect projectileBounds = projectileVisual.getBounds(projectileTransform.position);
+            for (std::uint32_t row = 0; row < zombies.size(); ++row)
             {
+                ZombieBrain &brain = zombies.get<ZombieBrain>(row);
+                if (brain.state == ZombieState::DEAD)
+                    continue;
+
+                const Transform &zombieTransform = zombies.get<Transform>(row);
+                Visual &zombieVisual = zombies.get<Visual>(row);
+                FixedRect zombieBounds = zombieVisual.getBounds(zombieTransform.position);
+                if (!projectileBounds.intersects(zombieBounds))
+                    continue;
 
-                float projYCenter = projectile->getPosition().y;
+                Fixed projYCenter = projectileTransform.position.y;
+                Fixed zombieSpriteHeight = zombieBounds.height;
+                Fixed zombieFeetY = zombieTransform.position.y;
+                Fixed zombieHeadY = zombieFeetY - zombieSpriteHeight;
+                Fixed yTolerance = projectileBounds.height / 2;
+                if (projYCenter < zombieHeadY - yTolerance || projYCenter > zombieFeetY + yTolerance)
+                    continue;
 
-                float zombieSpriteHeight = zombie->getGlobalBounds().height;
-                float zombieFeetY = zombie->getPosition().y;
-                float zombieHeadY = zombieFeetY - zombieSpriteHeight;
-                float yTolerance = projectile->getGlobalBounds().height / 2.f;
-                if (projYCenter >= zombieHeadY - yTolerance && projYCenter <= zombieFeetY + yTolerance)
+                // 碰撞发生
+                bool wasDying = brain.state == ZombieState::DYING;
+                ZombieBehaviorSystem::takeDamage(zombies.get<Health>(row), brain, zombieVisual, projectile.damage);
+                Slow &slow = zombies.get<Slow>(row);
+                bool slowApplied = false;
+                if (const SlowOnHit *slowOnHit = world.tryGet<SlowOnHit>(projectileId))
                 {
+                    ZombieBehaviorSystem::applySlow(slow, brain, zombies.get<ZombieInfo>(row), zombieVisual,
+                                                    slowOnHit->duration, slowOnHit->factor);
+                    slowApplied = slow.active;
+                }
+                projectile.hasHit = true;
 
-                    // 碰撞发生
-                    zombie->takeDamage(projectile->getDamage());
-                    projectile->applyPrimaryEffect(zombie);
-                    projectile->onHit();
-                    break;
+                // 视觉反馈: 击中、减速、死亡 (只记录请求, 粒子由渲染线程生成)
+                sf::Vector2f hitPosition = projectileTransform.position.toVector2f();
+                particleRequests.push_back(ParticleRequest{ParticleEffect::HIT, hitPosition, false});
+                bool isDying = brain.state == ZombieState::DYING;
+                // 只有本次命中施加了减速才显示减速效果, 普通豌豆打中已减速的僵尸不显示
+                if (!isDying && slowApplied)
+                {
+                    particleRequests.push_back(ParticleRequest{ParticleEffect::SLOW, hitPosition, false});
+                }
+                if (isDying && !wasDying)
+                {
+                    particleRequests.push_back(ParticleRequest{ParticleEffect::DEATH,
+                                                               FixedVector2(zombieTransform.position.x, zombieFeetY - zombieSpriteHeight / 2).toVector2f(),
+                                                               false});
+                    soundRequests.push_back(SFX_ZOMBIE_DIE);
                 }
+                break;
             }
-        }
-    }
+        });
 }
-
-// 检测僵尸与植物的碰撞
-void CollisionSystem::checkZombiePlantCollisions(std::vector<Zombie *> &zombies,
-                                                 std::vector<Plant *> &plants,
-                                                 float dt)
-{
-    for (Zombie *zombie : zombies)
-    {
-        if (!zombie || !zombie->isAlive() || zombie->getCurrentState() == ZombieState::ATTACKING)
-        {
-            continue;
-        }
-    }
-    (void)dt;
-}
\ No newline at end of file
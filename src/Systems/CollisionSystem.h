@@ -1,29 +1,22 @@
 #pragma once
 
 #include <vector>
-#include <memory>
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
+#include "../Utils/ResourceId.h"
 
-class Projectile;
-class Zombie;
-class Plant;
-class ProjectileManager;
-class ZombieManager;
-class PlantManager;
+struct ParticleRequest;
 
 class CollisionSystem
 {
 public:
     CollisionSystem();
     ~CollisionSystem() = default;
-    void update(ProjectileManager &projectileManager,
-                ZombieManager &zombieManager,
-                PlantManager &plantManager);
+    // 命中反馈只记录请求: 粒子和音效都由主线程播放
+    void update(GameWorld &world, std::vector<ParticleRequest> &particleRequests, std::vector<ResourceId> &soundRequests);
 
 private:
-    void checkProjectileZombieCollisions(std::vector<Projectile *> &projectiles,
-                                         std::vector<Zombie *> &zombies);
-
-    void checkZombiePlantCollisions(std::vector<Zombie *> &zombies,
-                                    std::vector<Plant *> &plants,
-                                    float dt);
+    // 子弹与僵尸: 每颗未命中的子弹对僵尸原型的组件数组做一次线性扫描
+    void checkProjectileZombieCollisions(GameWorld &world, std::vector<ParticleRequest> &particleRequests,
+                                         std::vector<ResourceId> &soundRequests);
 };
@@ -1,18 +1,53 @@
 #include "Grid.h"
 #include "../Utils/Constants.h"
+#include <algorithm>
+#include <iostream>
 
-Grid::Grid()
-    : m_rows(GRID_ROWS), m_cols(GRID_COLS), m_cellWidth(GRID_CELL_WIDTH), m_cellHeight(GRID_CELL_HEIGHT), m_startPosition(GRID_START_X, GRID_START_Y)
+BoardConfig BoardConfig::standard()
 {
+    return BoardConfig{GRID_ROWS, GRID_COLS};
+}
 
-    // 初始化占用状态数组
-    m_occupiedCells.resize(m_rows);
-    for (int i = 0; i < m_rows; ++i)
+bool BoardConfig::parse(const std::string &text, BoardConfig &outConfig)
+{
+    size_t separator = text.find_first_of("xX");
+    if (separator == std::string::npos)
+    {
+        return false;
+    }
+    try
+    {
+        int rows = std::stoi(text.substr(0, separator));
+        int cols = std::stoi(text.substr(separator + 1));
+        if (rows <= 0 || cols <= 0 || cols > 64)
+        {
+            return false;
+        }
+        outConfig.rows = rows;
+        outConfig.cols = cols;
+        return true;
+    }
+    catch (const std::exception &)
     {
-        m_occupiedCells[i].resize(m_cols, false);
+        return false;
     }
 }
 
+Grid::Grid(const BoardConfig &config)
+    : m_lineVertices(sf::Quads), m_layoutVersion(0),
+      m_rows(config.rows), m_cols(config.cols), m_cellWidth(GRID_CELL_WIDTH), m_cellHeight(GRID_CELL_HEIGHT), m_startPosition(GRID_START_X, GRID_START_Y)
+{
+    if (m_cols > 64)
+    {
+        std::cerr << "Grid: " << m_cols << " columns exceed the 64-bit row mask, clamping to 64." << std::endl;
+        m_cols = 64;
+    }
+
+    // 初始化占用状态数组
+    m_cells.assign(static_cast<size_t>(m_rows * m_cols), EntityId());
+    m_rowMasks.assign(static_cast<size_t>(m_rows), 0);
+}
+
 void Grid::initialize()
 {
     createGridLines();
@@ -20,44 +55,34 @@ void Grid::initialize()
 
 void Grid::createGridLines()
 {
+    const sf::Color lineColor(GRID_LINE_COLOR_R, GRID_LINE_COLOR_G,
+                              GRID_LINE_COLOR_B, GRID_LINE_COLOR_A);
+    auto appendLine = [this, &lineColor](float x, float y, float width, float height)
+    {
+        m_lineVertices.append(sf::Vertex(sf::Vector2f(x, y), lineColor));
+        m_lineVertices.append(sf::Vertex(sf::Vector2f(x + width, y), lineColor));
+        m_lineVertices.append(sf::Vertex(sf::Vector2f(x + width, y + height), lineColor));
+        m_lineVertices.append(sf::Vertex(sf::Vector2f(x, y + height), lineColor));
+    };
+
+    m_lineVertices.clear();
     // 创建水平线
-    m_horizontalLines.clear();
     for (int i = 0; i <= m_rows; ++i)
     {
-        sf::RectangleShape line;
-        line.setSize(sf::Vector2f(m_cols * m_cellWidth, 1));
-        line.setPosition(m_startPosition.x, m_startPosition.y + i * m_cellHeight);
-        line.setFillColor(sf::Color(GRID_LINE_COLOR_R, GRID_LINE_COLOR_G,
-                                    GRID_LINE_COLOR_B, GRID_LINE_COLOR_A));
-        m_horizontalLines.push_back(line);
+        appendLine(m_startPosition.x, m_startPosition.y + i * m_cellHeight, m_cols * m_cellWidth, 1.f);
     }
 
     // 创建垂直线
-    m_verticalLines.clear();
     for (int i = 0; i <= m_cols; ++i)
     {
-        sf::RectangleShape line;
-        line.setSize(sf::Vector2f(1, m_rows * m_cellHeight));
-        line.setPosition(m_startPosition.x + i * m_cellWidth, m_startPosition.y);
-        line.setFillColor(sf::Color(GRID_LINE_COLOR_R, GRID_LINE_COLOR_G,
-                                    GRID_LINE_COLOR_B, GRID_LINE_COLOR_A));
-        m_verticalLines.push_back(line);
+        appendLine(m_startPosition.x + i * m_cellWidth, m_startPosition.y, 1.f, m_rows * m_cellHeight);
     }
+    ++m_layoutVersion;
 }
 
-void Grid::render(sf::RenderWindow &window)
+void Grid::render(sf::RenderTarget &target) const
 {
-    // 渲染水平线
-    for (const auto &line : m_horizontalLines)
-    {
-        window.draw(line);
-    }
-
-    // 渲染垂直线
-    for (const auto &line : m_verticalLines)
-    {
-        window.draw(line);
-    }
+    target.draw(m_lineVertices);
 }
 
 sf::Vector2f Grid::getWorldPosition(int row, int col) const
@@ -113,14 +138,108 @@ bool Grid::isCellOccupied(int row, int col) const
     {
         return true; // 无效位置视为被占用
     }
-    return m_occupiedCells[row][col];
+    return (m_rowMasks[row] >> col) & 1u;
+}
+
+EntityId Grid::getPlantAt(int row, int col) const
+{
+    if (!isValidGridPosition(row, col))
+    {
+        return EntityId();
+    }
+    return m_cells[cellIndex(row, col)];
 }
 
-void Grid::setCellOccupied(int row, int col, bool occupied)
+bool Grid::occupyCells(int row, int col, EntityId plant, int rowSpan, int colSpan)
 {
-    if (isValidGridPosition(row, col))
+    if (!plant.isValid() || !isAreaFree(row, col, rowSpan, colSpan))
+    {
+        return false;
+    }
+    for (int r = row; r < row + rowSpan; ++r)
     {
-        m_occupiedCells[row][col] = occupied;
+        for (int c = col; c < col + colSpan; ++c)
+        {
+            m_cells[cellIndex(r, c)] = plant;
+            m_rowMasks[r] |= (std::uint64_t(1) << c);
+        }
+    }
+    return true;
+}
+
+void Grid::releaseCells(int row, int col, int rowSpan, int colSpan)
+{
+    for (int r = row; r < row + rowSpan; ++r)
+    {
+        for (int c = col; c < col + colSpan; ++c)
+        {
+            if (isValidGridPosition(r, c))
+            {
+                m_cells[cellIndex(r, c)] = EntityId();
+                m_rowMasks[r] &= ~(std::uint64_t(1) << c);
+            }
+        }
+    }
+}
+
+void Grid::clearCells()
+{
+    std::fill(m_cells.begin(), m_cells.end(), EntityId());
+    std::fill(m_rowMasks.begin(), m_rowMasks.end(), 0);
+}
+
+std::uint64_t Grid::getRowOccupancyMask(int row) const
+{
+    if (row < 0 || row >= m_rows)
+    {
+        return 0;
+    }
+    return m_rowMasks[row];
+}
+
+bool Grid::isAreaFree(int row, int col, int rowSpan, int colSpan) const
+{
+    if (rowSpan <= 0 || colSpan <= 0 ||
+        !isValidGridPosition(row, col) ||
+        !isValidGridPosition(row + rowSpan - 1, col + colSpan - 1))
+    {
+        return false;
+    }
+    // 用位掩码一次检查一整行的 colSpan 列
+    std::uint64_t spanBits = (colSpan >= 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << colSpan) - 1);
+    std::uint64_t spanMask = spanBits << col;
+    for (int r = row; r < row + rowSpan; ++r)
+    {
+        if (m_rowMasks[r] & spanMask)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Grid::getPlantsInNeighbourhood(int row, int col, int radius, std::vector<EntityId> &outPlants) const
+{
+    outPlants.clear();
+    int rowBegin = std::max(0, row - radius);
+    int rowEnd = std::min(m_rows - 1, row + radius);
+    int colBegin = std::max(0, col - radius);
+    int colEnd = std::min(m_cols - 1, col + radius);
+    for (int r = rowBegin; r <= rowEnd; ++r)
+    {
+        if (m_rowMasks[r] == 0)
+        {
+            continue;
+        }
+        for (int c = colBegin; c <= colEnd; ++c)
+        {
+            EntityId plant = m_cells[cellIndex(r, c)];
+            // 多格植物会占据多个格子, 去重
+            if (plant.isValid() && std::find(outPlants.begin(), outPlants.end(), plant) == outPlants.end())
+            {
+                outPlants.push_back(plant);
+            }
+        }
     }
 }
 
@@ -142,4 +261,13 @@ sf::Vector2f Grid::getCellSize() const
 sf::Vector2f Grid::getGridStartPosition() const
 {
     return m_startPosition;
+}
+
+sf::FloatRect Grid::getWorldBounds() const
+{
+    float width = m_startPosition.x + m_cols * m_cellWidth + BOARD_RIGHT_MARGIN;
+    float height = m_startPosition.y + m_rows * m_cellHeight + BOARD_BOTTOM_MARGIN;
+    return sf::FloatRect(0.f, 0.f,
+                         std::max(width, static_cast<float>(WINDOW_WIDTH)),
+                         std::max(height, static_cast<float>(WINDOW_HEIGHT)));
 }
\ No newline at end of file
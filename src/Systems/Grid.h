@@ -1,18 +1,35 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <cstdint>
+#include <string>
+#include "../Ecs/EntityId.h"
+
+// 棋盘尺寸, 运行时可配置 (压力测试可用 20x60 这样的大棋盘)
+struct BoardConfig
+{
+    int rows;
+    int cols;
+
+    static BoardConfig standard();
+    // 解析 "20x60" 形式的字符串, 失败返回 false
+    static bool parse(const std::string &text, BoardConfig &outConfig);
+};
 
 class Grid
 {
 public:
-    Grid();
+    explicit Grid(const BoardConfig &config = BoardConfig::standard());
     ~Grid() = default;
 
     // 初始化网格
     void initialize();
 
-    // 渲染网格线
-    void render(sf::RenderWindow &window);
+    // 渲染网格线 (一次 draw 调用)
+    void render(sf::RenderTarget &target) const;
+
+    // 网格布局版本号, 线条/尺寸变化时递增, 供静态图层判断是否需要重建
+    unsigned getLayoutVersion() const { return m_layoutVersion; }
 
     // 坐标转换
     sf::Vector2f getWorldPosition(int row, int col) const;
@@ -23,22 +40,35 @@ public:
     bool isValidGridPosition(int row, int col) const;
     bool isValidGridPosition(const sf::Vector2i &gridPos) const;
 
-    // 网格状态
+    // 网格状态: 格子 -> 植物 的权威映射, 所有查询 O(1)
     bool isCellOccupied(int row, int col) const;
-    void setCellOccupied(int row, int col, bool occupied);
+    EntityId getPlantAt(int row, int col) const;
+    bool occupyCells(int row, int col, EntityId plant, int rowSpan = 1, int colSpan = 1);
+    void releaseCells(int row, int col, int rowSpan = 1, int colSpan = 1);
+    void clearCells();
+
+    // 每行的占用位掩码, 第 col 位为 1 表示该列有植物 (每行最多 64 列)
+    std::uint64_t getRowOccupancyMask(int row) const;
+    bool isAreaFree(int row, int col, int rowSpan, int colSpan) const;
+    // 以 (row, col) 为中心、半径 radius 内的植物 (同一植物只出现一次)
+    void getPlantsInNeighbourhood(int row, int col, int radius, std::vector<EntityId> &outPlants) const;
 
     // 获取网格信息
     int getRows() const;
     int getCols() const;
     sf::Vector2f getCellSize() const;
     sf::Vector2f getGridStartPosition() const;
+    // 整个关卡世界的范围 (棋盘 + 左侧房子区域 + 右侧僵尸出生区域)
+    sf::FloatRect getWorldBounds() const;
 
 private:
     void createGridLines();
+    int cellIndex(int row, int col) const { return row * m_cols + col; }
 
-    std::vector<sf::RectangleShape> m_horizontalLines;
-    std::vector<sf::RectangleShape> m_verticalLines;
-    std::vector<std::vector<bool>> m_occupiedCells;
+    sf::VertexArray m_lineVertices; // 所有网格线合并为一个四边形数组
+    unsigned m_layoutVersion;
+    std::vector<EntityId> m_cells;         // 行主序的扁平数组
+    std::vector<std::uint64_t> m_rowMasks; // 每行一个占用位掩码
 
     int m_rows;
     int m_cols;
@@ -0,0 +1,289 @@
+#include "ParticleSystem.h"
+#include "../Core/ResourceManager.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <ostream>
+
+namespace
+{
+    const float PI = 3.14159265f;
+
+    sf::Uint8 lerpChannel(sf::Uint8 a, sf::Uint8 b, float t)
+    {
+        return static_cast<sf::Uint8>(a + (static_cast<float>(b) - a) * t);
+    }
+}
+
+const ParticleEmitterPreset &ParticleSystem::getPreset(ParticleEffect effect)
+{
+    // 数量, 速度, 角度, 寿命, 大小, 颜色, 重力, 阻力, 发射半径, 纹理
+    static const ParticleEmitterPreset hitPreset{
+        10, 60.f, 160.f, 120.f, 240.f, 0.2f, 0.4f, 6.f, 1.f,
+        sf::Color(140, 230, 90, 255), sf::Color(60, 150, 40, 0), 300.f, 0.2f, 4.f, ResourceId()};
+    static const ParticleEmitterPreset deathPreset{
+        40, 30.f, 140.f, 180.f, 360.f, 0.6f, 1.2f, 10.f, 3.f,
+        sf::Color(120, 110, 90, 230), sf::Color(60, 55, 45, 0), -40.f, 0.3f, 20.f, ResourceId()};
+    static const ParticleEmitterPreset slowPreset{
+        16, 20.f, 70.f, 0.f, 360.f, 0.5f, 0.9f, 5.f, 2.f,
+        sf::Color(170, 220, 255, 255), sf::Color(90, 160, 255, 0), 60.f, 0.4f, 12.f, ResourceId()};
+    static const ParticleEmitterPreset sunPickupPreset{
+        8, 80.f, 180.f, 0.f, 360.f, 0.3f, 0.5f, 22.f, 4.f,
+        sf::Color(255, 255, 200, 255), sf::Color(255, 220, 80, 0), 0.f, 0.1f, 6.f, SUN_TEXTURE_KEY};
+
+    switch (effect)
+    {
+    case ParticleEffect::HIT:
+        return hitPreset;
+    case ParticleEffect::DEATH:
+        return deathPreset;
+    case ParticleEffect::SLOW:
+        return slowPreset;
+    case ParticleEffect::SUN_PICKUP:
+    default:
+        return sunPickupPreset;
+    }
+}
+
+ParticleSystem::ParticleSystem(ResourceManager &resManager, size_t capacityPerPool)
+    : m_resourceManagerRef(resManager),
+      m_capacityPerPool(capacityPerPool),
+      m_rng(static_cast<unsigned>(std::chrono::system_clock::now().time_since_epoch().count())),
+      m_droppedCount(0),
+      m_lastUpdateTime(sf::Time::Zero),
+      m_lastDrawTime(sf::Time::Zero),
+      m_lastVisibleCount(0),
+      m_lastDrawCalls(0)
+{
+    // 纯色粒子池总是存在, 纹理池在第一次发射时创建
+    m_pools.reserve(4);
+    getPool(ResourceId());
+}
+
+ParticleSystem::Pool &ParticleSystem::getPool(ResourceId textureKey)
+{
+    for (Pool &pool : m_pools)
+    {
+        if (pool.textureKey == textureKey)
+        {
+            // 纹理可能在池创建之后才加载
+            if (!pool.texture && textureKey.isValid() && m_resourceManagerRef.hasTexture(textureKey))
+            {
+                pool.texture = &m_resourceManagerRef.getTexture(textureKey);
+            }
+            return pool;
+        }
+    }
+
+    // 一次性分配整个池, 之后不再扩容
+    m_pools.emplace_back();
+    Pool &pool = m_pools.back();
+    pool.textureKey = textureKey;
+    pool.texture = nullptr;
+    if (textureKey.isValid() && m_resourceManagerRef.hasTexture(textureKey))
+    {
+        pool.texture = &m_resourceManagerRef.getTexture(textureKey);
+    }
+    pool.count = 0;
+    for (std::vector<float> *field : {&pool.posX, &pool.posY, &pool.velX, &pool.velY, &pool.age, &pool.life,
+                                      &pool.sizeStart, &pool.sizeEnd, &pool.gravity, &pool.drag})
+    {
+        field->resize(m_capacityPerPool);
+    }
+    pool.colorStart.resize(m_capacityPerPool);
+    pool.colorEnd.resize(m_capacityPerPool);
+    // 先按满容量分配顶点, 再清空保留容量, 每帧 append 不会重新分配
+    pool.vertices = sf::VertexArray(sf::Quads, m_capacityPerPool * 4);
+    pool.vertices.clear();
+
+    std::cout << "ParticleSystem: Created pool '" << (textureKey.isValid() ? textureKey.name() : "<untextured>")
+              << "' with capacity " << m_capacityPerPool << std::endl;
+    return pool;
+}
+
+void ParticleSystem::emit(ParticleEffect effect, const sf::Vector2f &position)
+{
+    emit(getPreset(effect), position);
+}
+
+void ParticleSystem::emit(const ParticleEmitterPreset &preset, const sf::Vector2f &position, int countOverride)
+{
+    Pool &pool = getPool(preset.textureKey);
+    int count = countOverride >= 0 ? countOverride : preset.count;
+
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for (int n = 0; n < count; ++n)
+    {
+        if (pool.count >= m_capacityPerPool)
+        {
+            m_droppedCount += static_cast<size_t>(count - n);
+            break;
+        }
+
+        size_t i = pool.count++;
+        float angle = (preset.angleMinDeg + (preset.angleMaxDeg - preset.angleMinDeg) * unit(m_rng)) * PI / 180.f;
+        float speed = preset.speedMin + (preset.speedMax - preset.speedMin) * unit(m_rng);
+        float offsetAngle = unit(m_rng) * 2.f * PI;
+        float offsetRadius = preset.spawnRadius * unit(m_rng);
+
+        pool.posX[i] = position.x + std::cos(offsetAngle) * offsetRadius;
+        pool.posY[i] = position.y + std::sin(offsetAngle) * offsetRadius;
+        pool.velX[i] = std::cos(angle) * speed;
+        pool.velY[i] = std::sin(angle) * speed;
+        pool.age[i] = 0.f;
+        pool.life[i] = preset.lifeMin + (preset.lifeMax - preset.lifeMin) * unit(m_rng);
+        pool.sizeStart[i] = preset.sizeStart;
+        pool.sizeEnd[i] = preset.sizeEnd;
+        pool.gravity[i] = preset.gravity;
+        pool.drag[i] = preset.drag;
+        pool.colorStart[i] = preset.colorStart;
+        pool.colorEnd[i] = preset.colorEnd;
+    }
+}
+
+void ParticleSystem::update(float dt)
+{
+    sf::Clock clock;
+    for (Pool &pool : m_pools)
+    {
+        updatePool(pool, dt);
+    }
+    m_lastUpdateTime = clock.getElapsedTime();
+}
+
+void ParticleSystem::updatePool(Pool &pool, float dt)
+{
+    size_t i = 0;
+    while (i < pool.count)
+    {
+        pool.age[i] += dt;
+        if (pool.age[i] >= pool.life[i])
+        {
+            // 与末尾交换后缩短, 保持活跃粒子连续存放
+            size_t last = --pool.count;
+            pool.posX[i] = pool.posX[last];
+            pool.posY[i] = pool.posY[last];
+            pool.velX[i] = pool.velX[last];
+            pool.velY[i] = pool.velY[last];
+            pool.age[i] = pool.age[last];
+            pool.life[i] = pool.life[last];
+            pool.sizeStart[i] = pool.sizeStart[last];
+            pool.sizeEnd[i] = pool.sizeEnd[last];
+            pool.gravity[i] = pool.gravity[last];
+            pool.drag[i] = pool.drag[last];
+            pool.colorStart[i] = pool.colorStart[last];
+            pool.colorEnd[i] = pool.colorEnd[last];
+            continue;
+        }
+
+        float damping = std::pow(pool.drag[i], dt);
+        pool.velY[i] += pool.gravity[i] * dt;
+        pool.velX[i] *= damping;
+        pool.velY[i] *= damping;
+        pool.posX[i] += pool.velX[i] * dt;
+        pool.posY[i] += pool.velY[i] * dt;
+        ++i;
+    }
+}
+
+void ParticleSystem::buildVertices(Pool &pool, const sf::FloatRect &visibleArea)
+{
+    pool.vertices.clear();
+
+    sf::Vector2f texSize(0.f, 0.f);
+    if (pool.texture)
+    {
+        texSize = sf::Vector2f(static_cast<float>(pool.texture->getSize().x), static_cast<float>(pool.texture->getSize().y));
+    }
+
+    float visibleRight = visibleArea.left + visibleArea.width;
+    float visibleBottom = visibleArea.top + visibleArea.height;
+    for (size_t i = 0; i < pool.count; ++i)
+    {
+        float t = pool.age[i] / pool.life[i];
+        float half = (pool.sizeStart[i] + (pool.sizeEnd[i] - pool.sizeStart[i]) * t) * 0.5f;
+        float x = pool.posX[i];
+        float y = pool.posY[i];
+        if (x + half < visibleArea.left || x - half > visibleRight ||
+            y + half < visibleArea.top || y - half > visibleBottom)
+        {
+            continue;
+        }
+
+        const sf::Color &a = pool.colorStart[i];
+        const sf::Color &b = pool.colorEnd[i];
+        sf::Color color(lerpChannel(a.r, b.r, t), lerpChannel(a.g, b.g, t),
+                        lerpChannel(a.b, b.b, t), lerpChannel(a.a, b.a, t));
+
+        pool.vertices.append(sf::Vertex(sf::Vector2f(x - half, y - half), color, sf::Vector2f(0.f, 0.f)));
+        pool.vertices.append(sf::Vertex(sf::Vector2f(x + half, y - half), color, sf::Vector2f(texSize.x, 0.f)));
+        pool.vertices.append(sf::Vertex(sf::Vector2f(x + half, y + half), color, texSize));
+        pool.vertices.append(sf::Vertex(sf::Vector2f(x - half, y + half), color, sf::Vector2f(0.f, texSize.y)));
+    }
+}
+
+void ParticleSystem::draw(sf::RenderWindow &window, const sf::FloatRect &visibleArea)
+{
+    sf::Clock clock;
+    m_lastVisibleCount = 0;
+    m_lastDrawCalls = 0;
+    for (Pool &pool : m_pools)
+    {
+        if (pool.count == 0)
+        {
+            continue;
+        }
+        buildVertices(pool, visibleArea);
+        if (pool.vertices.getVertexCount() == 0)
+        {
+            continue;
+        }
+        // 每个纹理一次 draw 调用
+        sf::RenderStates states;
+        states.texture = pool.texture;
+        window.draw(pool.vertices, states);
+        m_lastVisibleCount += pool.vertices.getVertexCount() / 4;
+        ++m_lastDrawCalls;
+    }
+    m_lastDrawTime = clock.getElapsedTime();
+}
+
+void ParticleSystem::clear()
+{
+    for (Pool &pool : m_pools)
+    {
+        pool.count = 0;
+        pool.vertices.clear();
+    }
+    m_droppedCount = 0;
+}
+
+size_t ParticleSystem::getActiveCount() const
+{
+    size_t total = 0;
+    for (const Pool &pool : m_pools)
+    {
+        total += pool.count;
+    }
+    return total;
+}
+
+size_t ParticleSystem::getCapacity() const
+{
+    return m_pools.size() * m_capacityPerPool;
+}
+
+void ParticleSystem::writeStatsText(std::ostream &out) const
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(2);
+    out << std::fixed;
+    out << "Particles: " << getActiveCount() << "/" << getCapacity()
+        << " (visible " << m_lastVisibleCount << ", dropped " << m_droppedCount << ")"
+        << " | upd " << m_lastUpdateTime.asMicroseconds() / 1000.f << "ms"
+        << " | draw " << m_lastDrawTime.asMicroseconds() / 1000.f << "ms in " << m_lastDrawCalls << " calls";
+    out.flags(flags);
+    out.precision(precision);
+}
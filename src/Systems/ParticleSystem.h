@@ -0,0 +1,93 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <ostream>
+#include <string>
+#include <random>
+#include "../Utils/ResourceId.h"
+
+class ResourceManager;
+
+// 粒子效果类型, 每种对应一个发射器预设
+enum class ParticleEffect
+{
+    HIT,       // 豌豆击中
+    DEATH,     // 僵尸死亡
+    SLOW,      // 寒冰减速
+    SUN_PICKUP // 收集阳光
+};
+
+// 发射器预设: 一次爆发的粒子数量以及运动/外观的随机范围
+struct ParticleEmitterPreset
+{
+    int count;
+    float speedMin;
+    float speedMax;
+    float angleMinDeg; // 0 度向右, 90 度向下
+    float angleMaxDeg;
+    float lifeMin;
+    float lifeMax;
+    float sizeStart;
+    float sizeEnd;
+    sf::Color colorStart;
+    sf::Color colorEnd;
+    float gravity;     // 像素/秒^2
+    float drag;        // 每秒保留的速度比例
+    float spawnRadius;
+    ResourceId textureKey; // 无效键表示纯色方块
+};
+
+// 粒子系统: 每种纹理一个固定容量的 SoA 粒子池, 每个池只用一个 VertexArray 一次绘制。
+// 运行中不做逐粒子分配, 池满时丢弃新粒子。
+class ParticleSystem
+{
+public:
+    ParticleSystem(ResourceManager &resManager, size_t capacityPerPool);
+
+    void emit(ParticleEffect effect, const sf::Vector2f &position);
+    void emit(const ParticleEmitterPreset &preset, const sf::Vector2f &position, int countOverride = -1);
+    void update(float dt);
+    // 只为可见区域内的粒子生成顶点
+    void draw(sf::RenderWindow &window, const sf::FloatRect &visibleArea);
+    void clear();
+
+    size_t getActiveCount() const;
+    size_t getCapacity() const;
+    // 调试信息: 粒子数量与本帧更新/绘制耗时
+    // 写进调用方的流, 不生成临时字符串; 浮点格式用完即恢复
+    void writeStatsText(std::ostream &out) const;
+
+    static const ParticleEmitterPreset &getPreset(ParticleEffect effect);
+
+private:
+    struct Pool
+    {
+        ResourceId textureKey;
+        const sf::Texture *texture;
+        size_t count;
+        // SoA 存储, 容量固定
+        std::vector<float> posX, posY;
+        std::vector<float> velX, velY;
+        std::vector<float> age, life;
+        std::vector<float> sizeStart, sizeEnd;
+        std::vector<float> gravity, drag;
+        std::vector<sf::Color> colorStart, colorEnd;
+        sf::VertexArray vertices;
+    };
+
+    Pool &getPool(ResourceId textureKey);
+    void updatePool(Pool &pool, float dt);
+    void buildVertices(Pool &pool, const sf::FloatRect &visibleArea);
+
+    ResourceManager &m_resourceManagerRef;
+    size_t m_capacityPerPool;
+    std::vector<Pool> m_pools;
+    std::mt19937 m_rng;
+
+    size_t m_droppedCount;
+    sf::Time m_lastUpdateTime;
+    sf::Time m_lastDrawTime;
+    size_t m_lastVisibleCount;
+    unsigned m_lastDrawCalls;
+};
@@ -0,0 +1,82 @@
+#include "PlantBehaviorSystem.h"
+#include "Grid.h"
+#include "ZombieBehaviorSystem.h"
+#include <iostream>
+
+void PlantBehaviorSystem::computeLaneFronts(GameWorld &world, const Grid &grid)
+{
+    m_laneFrontX.assign(static_cast<size_t>(grid.getRows()), Fixed());
+    m_laneHasZombie.assign(static_cast<size_t>(grid.getRows()), false);
+
+    world.archetype<ZombieArchetype>().each<Transform, ZombieBrain>(
+        [&](EntityId, const Transform &transform, const ZombieBrain &brain)
+        {
+            if (brain.state == ZombieState::DEAD)
+                return;
+            int lane = ZombieBehaviorSystem::getLane(grid, transform.position);
+            if (lane < 0)
+                return;
+            if (!m_laneHasZombie[lane] || transform.position.x > m_laneFrontX[lane])
+            {
+                m_laneFrontX[lane] = transform.position.x;
+                m_laneHasZombie[lane] = true;
+            }
+        });
+}
+
+void PlantBehaviorSystem::update(GameWorld &world, const Grid &grid, Fixed dt,
+                                 std::vector<ProjectileSpawnRequest> &projectileRequests,
+                                 std::vector<PlantSunSpawnRequest> &sunRequests)
+{
+    computeLaneFronts(world, grid);
+
+    world.archetype<SunflowerArchetype>().each<Transform, Visual, PlantInfo, SunProducer>(
+        [&](EntityId, const Transform &transform, Visual &visual, const PlantInfo &info, SunProducer &producer)
+        {
+            visual.animator.update(visual.sprite);
+            const Fixed interval = getPlantDescriptor(info.type).actionInterval;
+            producer.timer += dt;
+            if (producer.timer >= interval)
+            {
+                producer.timer -= interval;
+                sunRequests.push_back(PlantSunSpawnRequest{transform.position, visual.getBounds(transform.position).height});
+            }
+        });
+
+    world.archetype<ShooterPlantArchetype>().each<Transform, Visual, PlantInfo, Shooter>(
+        [&](EntityId, const Transform &transform, Visual &visual, const PlantInfo &info, Shooter &shooter)
+        {
+            visual.animator.update(visual.sprite);
+            const PlantDescriptor &descriptor = getPlantDescriptor(info.type);
+
+            // 按模拟时间累计, 暂停期间不计时
+            shooter.timer += dt;
+            if (shooter.timer < descriptor.actionInterval)
+                return;
+            if (!descriptor.holdUntilTarget)
+            {
+                shooter.timer -= descriptor.actionInterval;
+            }
+
+            int row = info.gridPos.x;
+            bool hasTarget = row >= 0 && row < static_cast<int>(m_laneHasZombie.size()) &&
+                             m_laneHasZombie[row] && m_laneFrontX[row] > transform.position.x;
+            if (!hasTarget)
+                return;
+
+            FixedRect plantBounds = visual.getBounds(transform.position);
+            FixedVector2 muzzle = transform.position;
+            muzzle.x += plantBounds.width * Fixed::fromFloat(0.35f);
+            muzzle.y -= plantBounds.height * descriptor.muzzleHeightFactor;
+            projectileRequests.push_back(ProjectileSpawnRequest{descriptor.projectile, muzzle, FixedVector2(1, 0)});
+
+            shooter.timer = 0;
+            visual.play(AnimationState::SHOOT, true);
+            std::cout << "Shooter at (" << info.gridPos.x << "," << info.gridPos.y << ") fired." << std::endl;
+        });
+
+    // 坚果墙只有动画
+    world.archetype<WallNutArchetype>().each<Visual>(
+        [](EntityId, Visual &visual)
+        { visual.animator.update(visual.sprite); });
+}
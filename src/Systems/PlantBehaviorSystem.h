@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
+#include <vector>
+
+class Grid;
+
+// 植物发射子弹的请求 (遍历结束后由 PlantManager 交给 ProjectileManager 生成)
+struct ProjectileSpawnRequest
+{
+    ProjectileType type;
+    FixedVector2 position;
+    FixedVector2 direction;
+};
+
+// 向日葵产阳光的请求
+struct PlantSunSpawnRequest
+{
+    FixedVector2 plantPosition;
+    Fixed plantHeight;
+};
+
+// 植物行为: 动画、向日葵产阳光、射手开火
+// 生成实体的请求先记下来, 不在遍历原型时改动注册表
+class PlantBehaviorSystem
+{
+public:
+    void update(GameWorld &world, const Grid &grid, Fixed dt,
+                std::vector<ProjectileSpawnRequest> &projectileRequests,
+                std::vector<PlantSunSpawnRequest> &sunRequests);
+
+private:
+    // 每行最靠右的存活僵尸的 x, 一帧只算一次, 射手据此判断前方有没有目标
+    void computeLaneFronts(GameWorld &world, const Grid &grid);
+
+    std::vector<Fixed> m_laneFrontX;
+    std::vector<bool> m_laneHasZombie;
+};
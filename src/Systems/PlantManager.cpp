@@ -1,72 +1,81 @@
 #include "PlantManager.h"
-#include "../Entities/Plant.h"
-#include "../Plants/Sunflower.h"
-#include "../Plants/Peashooter.h"
-#include "../Plants/WallNut.h"
-#include "../Plants/IcePeashooter.h"
 #include "../Core/ResourceManager.h"
 #include "../Systems/Grid.h"
 #include "../States/GamePlayState.h"
 #include "../Systems/ProjectileManager.h"
-#include "../Systems/ZombieManager.h"
-#include "../Entities/Zombie.h"
-#include <SFML/Graphics/RenderWindow.hpp>
-#include <algorithm>
+#include "../Utils/Constants.h"
+#include "../Utils/BinaryStream.h"
+#include <array>
 #include <iostream>
+#include <utility>
 
-PlantManager::PlantManager(ResourceManager &resManager, Grid &gridSystem,
-                           GamePlayState &gameState, ProjectileManager &projectileManager, ZombieManager &zombieManager)
+PlantManager::PlantManager(ResourceManager &resManager, Grid &gridSystem, GameWorld &world,
+                           GamePlayState &gameState, ProjectileManager &projectileManager)
     : m_resourceManagerRef(resManager),
       m_gridRef(gridSystem),
+      m_worldRef(world),
       m_gameStateRef(gameState),
-      m_projectileManagerRef_forPlants(projectileManager),
-      m_zombieManagerRef(zombieManager)
+      m_projectileManagerRef(projectileManager)
 {
 }
 
 PlantManager::~PlantManager() = default;
 
-// sunflower
-std::unique_ptr<Plant> PlantManager::createSunflower(const sf::Vector2i &gridPosition)
+Fixed PlantManager::getStaggeredStartTime(const sf::Vector2i &gridPosition, Fixed interval)
 {
-    return std::make_unique<Sunflower>(m_resourceManagerRef, gridPosition, m_gridRef, *this);
+    if (interval <= 0)
+        return 0;
+    unsigned hash = static_cast<unsigned>(gridPosition.x) * 73856093u ^ static_cast<unsigned>(gridPosition.y) * 19349663u;
+    return interval * Fixed::fromRatio(static_cast<std::int32_t>(hash % 1000u), 1000);
 }
 
-// peashooter
-std::unique_ptr<Plant> PlantManager::createPeashooter(const sf::Vector2i &gridPosition)
+Fixed PlantManager::getInitialTimer(const PlantDescriptor &descriptor, const sf::Vector2i &gridPosition)
 {
-    return std::make_unique<Peashooter>(m_resourceManagerRef, gridPosition, m_gridRef, *this, m_projectileManagerRef_forPlants);
+    return descriptor.staggerStart ? getStaggeredStartTime(gridPosition, descriptor.actionInterval) : Fixed(0);
 }
 
-// wallnut
-std::unique_ptr<Plant> PlantManager::createWallNut(const sf::Vector2i &gridPosition)
+template <PlantType T>
+EntityId PlantManager::createPlantOf(const sf::Vector2i &gridPosition)
 {
-    return std::make_unique<WallNut>(m_resourceManagerRef, gridPosition, m_gridRef);
-}
+    using A = PlantArchetypeOf<T>;
+    constexpr const PlantDescriptor &descriptor = getPlantDescriptor(T);
 
-// icepeashooter
-std::unique_ptr<Plant> PlantManager::createIcePeashooter(const sf::Vector2i &gridPosition)
-{
+    EntityId id = m_worldRef.create<A>();
+    if constexpr (A::template has<SunProducer>)
+    {
+        m_worldRef.get<SunProducer>(id).timer = getInitialTimer(descriptor, gridPosition);
+    }
+    if constexpr (A::template has<Shooter>)
+    {
+        m_worldRef.get<Shooter>(id).timer = getInitialTimer(descriptor, gridPosition);
+    }
 
-    return std::make_unique<IcePeashooter>(m_resourceManagerRef, gridPosition, m_gridRef, *this, m_projectileManagerRef_forPlants);
+    Visual &visual = m_worldRef.get<Visual>(id);
+    visual.setTexture(m_resourceManagerRef.getTexture(descriptor.textureKey));
+    visual.bindAnimation(descriptor.textureKey, id);
+    visual.play(AnimationState::IDLE);
+    visual.centerOrigin();
+    m_worldRef.get<Transform>(id).position = FixedVector2::fromVector(m_gridRef.getWorldPosition(gridPosition.x, gridPosition.y));
+    m_worldRef.get<Health>(id).current = descriptor.health;
+    m_worldRef.get<PlantInfo>(id) = PlantInfo{T, gridPosition};
+    return id;
 }
 
-std::vector<Zombie *> PlantManager::getZombiesInLane(int lane) const
+EntityId PlantManager::createPlant(PlantType type, const sf::Vector2i &gridPosition)
 {
-
-    std::vector<Zombie *> zombiesInSpecifiedLane;
-    for (Zombie *zombie : m_zombieManagerRef.getActiveZombies())
+    if (!isValidPlantType(type))
     {
-        if (zombie && zombie->isAlive())
-        {
-            int zombieCurrentLane = zombie->getLane();
-            if (zombieCurrentLane == lane)
-            {
-                zombiesInSpecifiedLane.push_back(zombie);
-            }
-        }
+        std::cerr << "PlantManager: undefined error, plant is " << static_cast<int>(type) << std::endl;
+        return EntityId();
     }
-    return zombiesInSpecifiedLane;
+
+    // 每种植物类型实例化一个工厂, 按枚举值下标分派
+    static constexpr auto factories = []<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        return std::array<EntityId (PlantManager::*)(const sf::Vector2i &), PLANT_TYPE_COUNT>{
+            &PlantManager::createPlantOf<static_cast<PlantType>(Is)>...};
+    }(std::make_index_sequence<PLANT_TYPE_COUNT>{});
+    return (this->*factories[static_cast<std::size_t>(type)])(gridPosition);
 }
 
 bool PlantManager::tryAddPlant(PlantType type, const sf::Vector2i &gridPosition)
@@ -76,155 +85,148 @@ bool PlantManager::tryAddPlant(PlantType type, const sf::Vector2i &gridPosition)
         return false;
     }
 
-    std::unique_ptr<Plant> newPlant = nullptr;
-    switch (type)
+    EntityId plant = createPlant(type, gridPosition);
+    if (plant.isValid())
     {
-    case PlantType::SUNFLOWER:
-        newPlant = createSunflower(gridPosition);
-        break;
-    case PlantType::PEASHOOTER:
-        newPlant = createPeashooter(gridPosition);
-        break;
-    case PlantType::WALLNUT:
-        newPlant = createWallNut(gridPosition);
-        break;
-    case PlantType::ICEPEASHOOTER:
-        newPlant = createIcePeashooter(gridPosition);
-        break;
-    default:
-        std::cerr << "PlantManager: undefined error, plant is " << static_cast<int>(type) << std::endl;
-        return false;
-    }
-
-    if (newPlant)
-    {
-        m_plants.push_back(std::move(newPlant));
+        m_gridRef.occupyCells(gridPosition.x, gridPosition.y, plant);
         std::cout << "PlantManager: planted " << static_cast<int>(type) << " in  (" << gridPosition.x << ", " << gridPosition.y << ")" << std::endl;
-
         return true;
     }
     return false;
 }
 
-void PlantManager::update(float dt)
+void PlantManager::update(Fixed dt)
 {
-    for (auto &plant : m_plants)
+    m_projectileRequests.clear();
+    m_sunRequests.clear();
+    m_behaviorSystem.update(m_worldRef, m_gridRef, dt, m_projectileRequests, m_sunRequests);
+
+    for (const ProjectileSpawnRequest &request : m_projectileRequests)
     {
-        plant->update(dt);
+        m_projectileManagerRef.spawnProjectile(request.type, request.position, request.direction);
+    }
+    for (const PlantSunSpawnRequest &request : m_sunRequests)
+    {
+        m_gameStateRef.spawnSunFromPlant(request.plantPosition, request.plantHeight);
     }
-    m_plants.erase(
-        std::remove_if(m_plants.begin(), m_plants.end(),
-                       [](const std::unique_ptr<Plant> &p)
-                       { return !p->isAlive(); }),
-        m_plants.end());
-}
 
-void PlantManager::draw(sf::RenderWindow &window)
-{
-    for (const auto &plant : m_plants)
+    // 死亡的植物同步释放格子
+    m_deadScratch.clear();
+    m_worldRef.each<Health, PlantInfo>(
+        [this](EntityId id, const Health &health, const PlantInfo &info)
+        {
+            if (health.current > 0)
+                return;
+            m_gridRef.releaseCells(info.gridPos.x, info.gridPos.y);
+            m_deadScratch.push_back(id);
+        });
+    for (EntityId id : m_deadScratch)
     {
-        plant->draw(window);
+        m_worldRef.destroy(id);
     }
 }
 
+void PlantManager::collectRenderSprites(std::vector<RenderSprite> &sprites) const
+{
+    m_worldRef.each<Transform, Visual, PlantInfo>(
+        [&sprites](EntityId, const Transform &transform, const Visual &visual, const PlantInfo &)
+        { sprites.push_back(visual.toRenderSprite(transform.position, RenderLayer::PLANTS)); });
+}
+
 void PlantManager::clear()
 {
-    m_plants.clear();
+    m_worldRef.destroyAll<SunflowerArchetype, ShooterPlantArchetype, WallNutArchetype>();
+    m_gridRef.clearCells();
 }
 
 bool PlantManager::isCellOccupied(const sf::Vector2i &gridPosition) const
 {
-    for (const auto &plant : m_plants)
-    {
-        if (plant->getGridPosition() == gridPosition)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_gridRef.isCellOccupied(gridPosition.x, gridPosition.y);
 }
 
-const std::vector<std::unique_ptr<Plant>> &PlantManager::getAllPlants() const
+size_t PlantManager::getPlantCount() const
 {
-    return m_plants;
+    return m_worldRef.count<PlantInfo>();
 }
 
-std::vector<Plant *> PlantManager::getPlantsInRow(int gridRow)
+EntityId PlantManager::getPlantAt(const sf::Vector2i &gridPosition) const
 {
-    std::vector<Plant *> plantsInRow;
-    for (const auto &plantPtr : m_plants)
+    EntityId plant = m_gridRef.getPlantAt(gridPosition.x, gridPosition.y);
+    const Health *health = m_worldRef.tryGet<Health>(plant);
+    if (health && health->current > 0)
     {
-        if (plantPtr->isAlive() && plantPtr->getRow() == gridRow)
-        {
-            plantsInRow.push_back(plantPtr.get());
-        }
+        return plant;
     }
-    return plantsInRow;
+    return EntityId();
 }
 
-std::vector<Plant *> PlantManager::getAllActivePlants()
+bool PlantManager::removePlant(EntityId plant)
 {
-    std::vector<Plant *> activePlants;
-    for (const auto &plant_ptr : m_plants)
+    const PlantInfo *info = m_worldRef.tryGet<PlantInfo>(plant);
+    if (!info)
+        return false;
+
+    sf::Vector2i gridPos = info->gridPos;
+    m_worldRef.destroy(plant);
+    if (m_gridRef.isValidGridPosition(gridPos))
     {
-        if (plant_ptr && plant_ptr->isAlive())
-        {
-            activePlants.push_back(plant_ptr.get());
-        }
+        m_gridRef.releaseCells(gridPos.x, gridPos.y);
+        std::cout << "PlantManager: Plant removed from grid (" << gridPos.x << "," << gridPos.y
+                  << "), cell now unoccupied in Grid." << std::endl;
     }
-    return activePlants;
+    return true;
 }
 
-void PlantManager::requestSunSpawnFromPlant(Plant *requestingPlant)
+bool PlantManager::removePlantAt(const sf::Vector2i &gridPosition)
 {
-    if (requestingPlant)
-    {
-        m_gameStateRef.spawnSunFromPlant(requestingPlant);
-    }
+    return removePlant(getPlantAt(gridPosition));
 }
 
-Plant *PlantManager::getPlantAt(const sf::Vector2i &gridPosition)
+void PlantManager::saveState(BinaryWriter &writer) const
 {
-    for (auto &plant_ptr : m_plants)
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(getPlantCount()));
+    m_worldRef.each<Health, PlantInfo>(
+        [this, &writer](EntityId id, const Health &health, const PlantInfo &info)
+        {
+            writer.write<std::uint8_t>(static_cast<std::uint8_t>(info.type));
+            writer.write<std::int32_t>(info.gridPos.x);
+            writer.write<std::int32_t>(info.gridPos.y);
+            writer.write<std::int32_t>(health.current);
+            if (const SunProducer *producer = m_worldRef.tryGet<SunProducer>(id))
+                writer.writeFixed(producer->timer);
+            else if (const Shooter *shooter = m_worldRef.tryGet<Shooter>(id))
+                writer.writeFixed(shooter->timer);
+        });
+}
+
+bool PlantManager::loadState(BinaryReader &reader)
+{
+    clear();
+    std::uint32_t count = reader.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count && reader.isOk(); ++i)
     {
-        if (plant_ptr && plant_ptr->getGridPosition() == gridPosition && plant_ptr->isAlive())
+        PlantType type = static_cast<PlantType>(reader.read<std::uint8_t>());
+        sf::Vector2i gridPosition;
+        gridPosition.x = reader.read<std::int32_t>();
+        gridPosition.y = reader.read<std::int32_t>();
+        if (!m_gridRef.isValidGridPosition(gridPosition) || isCellOccupied(gridPosition))
         {
-            return plant_ptr.get();
+            reader.fail();
+            break;
         }
-    }
-    return nullptr;
-}
-
-bool PlantManager::removePlant(Plant *plantToRemove)
-{
-    if (!plantToRemove)
-        return false;
 
-    auto it = std::find_if(m_plants.begin(), m_plants.end(),
-                           [&](const std::unique_ptr<Plant> &p)
-                           { return p.get() == plantToRemove; });
-
-    if (it != m_plants.end())
-    {
-        sf::Vector2i gridPos = (*it)->getGridPosition();
-        m_plants.erase(it);
-        if (m_gridRef.isValidGridPosition(gridPos))
+        EntityId plant = createPlant(type, gridPosition);
+        if (!plant.isValid())
         {
-            m_gridRef.setCellOccupied(gridPos.x, gridPos.y, false);
-            std::cout << "PlantManager: Plant removed from grid (" << gridPos.x << "," << gridPos.y
-                      << "), cell now unoccupied in Grid." << std::endl;
+            reader.fail();
+            break;
         }
-        return true;
+        m_worldRef.get<Health>(plant).current = reader.read<std::int32_t>();
+        if (SunProducer *producer = m_worldRef.tryGet<SunProducer>(plant))
+            producer->timer = reader.readFixed();
+        else if (Shooter *shooter = m_worldRef.tryGet<Shooter>(plant))
+            shooter->timer = reader.readFixed();
+        m_gridRef.occupyCells(gridPosition.x, gridPosition.y, plant);
     }
-    return false;
+    return reader.isOk();
 }
-
-bool PlantManager::removePlantAt(const sf::Vector2i &gridPosition)
-{
-    Plant *plant = getPlantAt(gridPosition);
-    if (plant)
-    {
-        return removePlant(plant);
-    }
-    return false;
-}
\ No newline at end of file
@@ -1,64 +1,64 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 #include <SFML/System.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "RenderSprite.h"
+#include "PlantBehaviorSystem.h"
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
 
-namespace sf
-{
-    class RenderWindow;
-}
-class Plant;
 class ResourceManager;
 class Grid;
 class GamePlayState;
 class ProjectileManager;
-class ZombieManager;
-class Zombie;
-
-enum class PlantType
-{
-    SUNFLOWER,
-    PEASHOOTER,
-    WALLNUT,
-    ICEPEASHOOTER
-};
+class BinaryWriter;
+class BinaryReader;
 
+// 植物的外观: 种植/铲除/读档都在这里, 行为由 PlantBehaviorSystem 处理
 class PlantManager
 {
 public:
-    PlantManager(ResourceManager &resManager, Grid &gridSystem,
-                 GamePlayState &gameState, ProjectileManager &projectileManager, ZombieManager &zombieManager);
+    PlantManager(ResourceManager &resManager, Grid &gridSystem, GameWorld &world,
+                 GamePlayState &gameState, ProjectileManager &projectileManager);
     ~PlantManager();
 
     // 尝试在指定网格位置种植植物
     bool tryAddPlant(PlantType type, const sf::Vector2i &gridPosition);
-    void update(float dt);
-    void draw(sf::RenderWindow &window);
+    void update(Fixed dt);
+    // 上一次 update 中射手发射的子弹数
+    std::size_t getShotsFiredLastUpdate() const { return m_projectileRequests.size(); }
+    // 把所有植物的绘制数据追加到渲染快照, 视口裁剪由渲染线程做
+    void collectRenderSprites(std::vector<RenderSprite> &sprites) const;
     void clear();
     bool isCellOccupied(const sf::Vector2i &gridPosition) const;
-    const std::vector<std::unique_ptr<Plant>> &getAllPlants() const;
-    std::vector<Plant *> getPlantsInRow(int gridRow);
-    std::vector<Plant *> getAllActivePlants();
-
-    // 供植物（如向日葵）调用以请求在其位置产生阳光
-    void requestSunSpawnFromPlant(Plant *requestingPlant);
-    std::vector<Zombie *> getZombiesInLane(int lane) const;
+    size_t getPlantCount() const;
 
-    Plant *getPlantAt(const sf::Vector2i &gridPosition);
-    bool removePlant(Plant *plantToRemove);
+    // 格子上的存活植物, 没有时返回无效句柄
+    EntityId getPlantAt(const sf::Vector2i &gridPosition) const;
+    bool removePlant(EntityId plant);
     bool removePlantAt(const sf::Vector2i &gridPosition);
 
+    // 存档/快照: 读档时清空后按类型和格子重建, 网格占用随之恢复
+    void saveState(BinaryWriter &writer) const;
+    bool loadState(BinaryReader &reader);
+
 private:
-    std::unique_ptr<Plant> createSunflower(const sf::Vector2i &gridPosition);
-    std::unique_ptr<Plant> createPeashooter(const sf::Vector2i &gridPosition);
-    std::unique_ptr<Plant> createWallNut(const sf::Vector2i &gridPosition);
-    std::unique_ptr<Plant> createIcePeashooter(const sf::Vector2i &gridPosition);
+    EntityId createPlant(PlantType type, const sf::Vector2i &gridPosition);
+    // 按类型在编译期选定原型和要初始化的组件
+    template <PlantType T>
+    EntityId createPlantOf(const sf::Vector2i &gridPosition);
+    static Fixed getInitialTimer(const PlantDescriptor &descriptor, const sf::Vector2i &gridPosition);
+    // 按格子位置错开初始计时, 避免同类植物同时行动 (结果可复现)
+    static Fixed getStaggeredStartTime(const sf::Vector2i &gridPosition, Fixed interval);
 
-    std::vector<std::unique_ptr<Plant>> m_plants;
     ResourceManager &m_resourceManagerRef;
     Grid &m_gridRef;
+    GameWorld &m_worldRef;
     GamePlayState &m_gameStateRef;
-    ProjectileManager &m_projectileManagerRef_forPlants;
-    ZombieManager &m_zombieManagerRef;
+    ProjectileManager &m_projectileManagerRef;
+    PlantBehaviorSystem m_behaviorSystem;
+    std::vector<ProjectileSpawnRequest> m_projectileRequests;
+    std::vector<PlantSunSpawnRequest> m_sunRequests;
+    std::vector<EntityId> m_deadScratch;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+
+enum class PlantType;
+
+// 玩家对模拟状态的操作: 按生效的 tick 记录, 供回溯重放和联机锁步同步
+enum class PlayerCommandType : std::uint8_t
+{
+    PLANT,
+    SHOVEL,
+    COLLECT_SUN,
+    ADD_SUN
+};
+
+struct PlayerCommand
+{
+    std::uint32_t tick;
+    PlayerCommandType type;
+    std::uint8_t player; // 0 = 主机/单人, 1 = 联机的第二位玩家
+    PlantType plantType;
+    int amount; // 调试加的阳光 (种植花费由模拟按植物类型查表)
+    sf::Vector2i gridPos;
+    sf::Vector2f worldPos;
+};
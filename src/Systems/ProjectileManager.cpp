@@ -1,82 +1,105 @@
 #include "ProjectileManager.h"
-#include "../Entities/Projectile.h" // 包含 Projectile.h
-#include "../Projectiles/Pea.h"     // 包含 Pea.h，因为我们要创建 Pea 实例
 #include "../Core/ResourceManager.h"
 #include "../Utils/Constants.h"
-#include <SFML/Graphics.hpp>
-#include <algorithm>
+#include "../Utils/BinaryStream.h"
 #include <iostream>
 
-ProjectileManager::ProjectileManager(ResourceManager &resManager)
-    : m_resourceManagerRef(resManager)
+ProjectileManager::ProjectileManager(ResourceManager &resManager, GameWorld &world)
+    : m_resourceManagerRef(resManager),
+      m_worldRef(world)
 {
 }
 
 ProjectileManager::~ProjectileManager() = default;
 
-void ProjectileManager::addProjectile(std::unique_ptr<Projectile> projectile)
+EntityId ProjectileManager::spawnProjectile(ProjectileType type, const FixedVector2 &startPosition, const FixedVector2 &direction)
 {
-    if (projectile)
+    EntityId id;
+    switch (type)
     {
-        m_projectiles.emplace_back(std::move(projectile));
-        std::cout << "ProjectileManager: Added a projectile. Total: " << m_projectiles.size() << std::endl;
-    }
-}
-
-void ProjectileManager::update(float dt, const sf::RenderWindow &window)
-{
-
-    for (size_t i = 0; i < m_projectiles.size(); ++i)
+    case ProjectileType::PEA:
     {
-        if (m_projectiles[i])
-        {
-            m_projectiles[i]->update(dt);
-        }
+        id = m_worldRef.create<PeaArchetype>();
+        Visual &visual = m_worldRef.get<Visual>(id);
+        visual.setTexture(m_resourceManagerRef.getTexture(PEA_TEXTURE_KEY));
+        m_worldRef.get<ProjectileInfo>(id) = ProjectileInfo{type, PEA_DAMAGE, false};
+        m_worldRef.get<Velocity>(id) = Velocity{direction, Fixed::fromFloat(PEA_SPEED)};
+        m_worldRef.get<Lifespan>(id).remaining = Fixed::fromFloat(-1.f);
+        break;
     }
-
-    auto it = std::remove_if(m_projectiles.begin(), m_projectiles.end(),
-                             [&window](const std::unique_ptr<Projectile> &proj_ptr)
-                             {
-                                 if (!proj_ptr)
-                                 {
-                                     std::cerr << "[ProjectileManager] CRITICAL: Encountered nullptr in m_projectiles during removal check!" << std::endl;
-                                     return true;
-                                 }
-                                 return proj_ptr->isOutOfValidArea(window);
-                             });
-
-    if (it != m_projectiles.end())
+    case ProjectileType::ICE_PEA:
     {
-        m_projectiles.erase(it, m_projectiles.end());
+        id = m_worldRef.create<IcePeaArchetype>();
+        Visual &visual = m_worldRef.get<Visual>(id);
+        visual.setTexture(m_resourceManagerRef.getTexture(ICE_PEA_TEXTURE_KEY));
+        visual.centerOrigin();
+        m_worldRef.get<ProjectileInfo>(id) = ProjectileInfo{type, ICE_PEA_DAMAGE, false};
+        m_worldRef.get<Velocity>(id) = Velocity{direction, Fixed::fromFloat(ICE_PEA_SPEED)};
+        m_worldRef.get<Lifespan>(id).remaining = Fixed::fromFloat(ICE_PEA_LIFESPAN_SECONDS);
+        m_worldRef.get<SlowOnHit>(id) = SlowOnHit{Fixed::fromFloat(ZOMBIE_SLOW_DURATION), Fixed::fromFloat(ZOMBIE_SLOW_FACTOR)};
+        break;
+    }
+    default:
+        std::cerr << "ProjectileManager: undefined projectile type " << static_cast<int>(type) << std::endl;
+        return id;
     }
+    m_worldRef.get<Transform>(id).position = startPosition;
+    return id;
 }
-void ProjectileManager::draw(sf::RenderWindow &window)
+
+void ProjectileManager::update(Fixed dt, const FixedRect &worldBounds)
 {
-    for (const auto &projectile : m_projectiles)
-    {
-        projectile->draw(window);
-    }
+    m_motionSystem.update(m_worldRef, dt, worldBounds);
+}
+
+void ProjectileManager::collectRenderSprites(std::vector<RenderSprite> &sprites) const
+{
+    m_worldRef.each<Transform, Visual, ProjectileInfo>(
+        [&sprites](EntityId, const Transform &transform, const Visual &visual, const ProjectileInfo &)
+        { sprites.push_back(visual.toRenderSprite(transform.position, RenderLayer::PROJECTILES)); });
 }
 
 void ProjectileManager::clear()
 {
-    m_projectiles.clear();
+    m_worldRef.destroyAll<PeaArchetype, IcePeaArchetype>();
 }
 
-const std::vector<std::unique_ptr<Projectile>> &ProjectileManager::getAllProjectiles() const
+size_t ProjectileManager::getProjectileCount() const
 {
-    return m_projectiles;
+    return m_worldRef.count<ProjectileInfo>();
+}
+
+void ProjectileManager::saveState(BinaryWriter &writer) const
+{
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(getProjectileCount()));
+    m_worldRef.each<Transform, ProjectileInfo, Velocity, Lifespan>(
+        [&writer](EntityId, const Transform &transform, const ProjectileInfo &info, const Velocity &velocity, const Lifespan &lifespan)
+        {
+            writer.write<std::uint8_t>(static_cast<std::uint8_t>(info.type));
+            writer.writeFixedVector(transform.position);
+            writer.writeFixedVector(velocity.direction);
+            writer.writeFixed(lifespan.remaining);
+            writer.writeBool(info.hasHit);
+        });
 }
 
-std::vector<Projectile *> ProjectileManager::getAllActiveProjectiles()
+bool ProjectileManager::loadState(BinaryReader &reader)
 {
-    std::vector<Projectile *> activeProjectiles;
-    for (const auto &proj_ptr : m_projectiles)
+    clear();
+    std::uint32_t count = reader.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count && reader.isOk(); ++i)
     {
-        if (proj_ptr && !proj_ptr->hasHit())
+        ProjectileType type = static_cast<ProjectileType>(reader.read<std::uint8_t>());
+        if (type != ProjectileType::PEA && type != ProjectileType::ICE_PEA)
         {
-            activeProjectiles.push_back(proj_ptr.get());
+            reader.fail();
+            return false;
         }
+        FixedVector2 position = reader.readFixedVector();
+        FixedVector2 direction = reader.readFixedVector();
+        EntityId id = spawnProjectile(type, position, direction);
+        m_worldRef.get<Lifespan>(id).remaining = reader.readFixed();
+        m_worldRef.get<ProjectileInfo>(id).hasHit = reader.readBool();
     }
-    return activeProjectiles;
+    return reader.isOk();
 }
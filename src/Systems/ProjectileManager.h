@@ -1,30 +1,37 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 #include <SFML/System.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "RenderSprite.h"
+#include "ProjectileMotionSystem.h"
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
 
-namespace sf
-{
-    class RenderWindow;
-}
-class Projectile;
 class ResourceManager;
+class BinaryWriter;
+class BinaryReader;
 
+// 子弹的外观: 生成/读档/清理都在这里, 运动由 ProjectileMotionSystem 处理
 class ProjectileManager
 {
 public:
-    ProjectileManager(ResourceManager &resManager);
+    ProjectileManager(ResourceManager &resManager, GameWorld &world);
     ~ProjectileManager();
-    void addProjectile(std::unique_ptr<Projectile> projectile);
-    void update(float dt, const sf::RenderWindow &window);
-    void draw(sf::RenderWindow &window);
+    EntityId spawnProjectile(ProjectileType type, const FixedVector2 &startPosition,
+                             const FixedVector2 &direction = FixedVector2(1, 0));
+    void update(Fixed dt, const FixedRect &worldBounds);
+    // 把所有子弹的绘制数据追加到渲染快照, 视口裁剪由渲染线程做
+    void collectRenderSprites(std::vector<RenderSprite> &sprites) const;
     void clear();
-    std::vector<Projectile *> getAllActiveProjectiles();
+    size_t getProjectileCount() const;
 
-    const std::vector<std::unique_ptr<Projectile>> &getAllProjectiles() const;
+    // 存档/快照
+    void saveState(BinaryWriter &writer) const;
+    bool loadState(BinaryReader &reader);
 
 private:
-    std::vector<std::unique_ptr<Projectile>> m_projectiles;
     ResourceManager &m_resourceManagerRef;
+    GameWorld &m_worldRef;
+    ProjectileMotionSystem m_motionSystem;
 };
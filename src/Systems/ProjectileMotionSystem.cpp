@@ -0,0 +1,41 @@
+#include "ProjectileMotionSystem.h"
+
+void ProjectileMotionSystem::update(GameWorld &world, Fixed dt, const FixedRect &worldBounds)
+{
+    m_expired.clear();
+    world.each<Transform, Visual, ProjectileInfo, Velocity, Lifespan>(
+        [&](EntityId id, Transform &transform, const Visual &visual, ProjectileInfo &info, const Velocity &velocity, Lifespan &lifespan)
+        {
+            if (!info.hasHit)
+            {
+                // 直线移动
+                transform.position += velocity.direction * (velocity.speed * dt);
+                if (lifespan.remaining > 0)
+                {
+                    lifespan.remaining -= dt;
+                    if (lifespan.remaining <= 0)
+                    {
+                        info.hasHit = true;
+                    }
+                }
+            }
+            if (info.hasHit || isOutOfValidArea(visual.getBounds(transform.position), worldBounds))
+            {
+                m_expired.push_back(id);
+            }
+        });
+
+    for (EntityId id : m_expired)
+    {
+        world.destroy(id);
+    }
+}
+
+bool ProjectileMotionSystem::isOutOfValidArea(const FixedRect &bounds, const FixedRect &worldBounds)
+{
+    // 完全飞出关卡世界的任一边界
+    return bounds.left > worldBounds.getRight() ||
+           bounds.getRight() < worldBounds.left ||
+           bounds.top > worldBounds.getBottom() ||
+           bounds.getBottom() < worldBounds.top;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
+#include <vector>
+
+// 子弹运动: 直线移动、寿命倒计时, 命中或飞出关卡世界的子弹在遍历结束后统一销毁
+class ProjectileMotionSystem
+{
+public:
+    void update(GameWorld &world, Fixed dt, const FixedRect &worldBounds);
+
+private:
+    static bool isOutOfValidArea(const FixedRect &bounds, const FixedRect &worldBounds);
+
+    std::vector<EntityId> m_expired;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ParticleSystem.h"
+#include "WaveManager.h"
+#include "RenderSprite.h"
+#include "../Ecs/EntityDescriptors.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 模拟线程发给渲染线程的粒子请求; clear 为 true 时清空全部粒子 (读档/回溯后)
+struct ParticleRequest
+{
+    ParticleEffect effect;
+    sf::Vector2f position;
+    bool clear;
+};
+
+// 模拟线程发给主线程的音效请求就是音效的 ResourceId, 由主线程交给 SoundManager (混音器只接受一个线程的命令)
+
+// HUD 显示的数值
+struct HudValues
+{
+    int sun[2] = {0, 0}; // 按玩家编号
+    float waveProgress = 0.f;
+    std::string waveLabel;
+    std::string waveStatusText;
+    SpawnState waveState = SpawnState::IDLE;
+    // 本地玩家每种植物的种植请求累计数: 模拟线程已处理的 / 其中种植成功的
+    // 用累计数而不是单帧事件, 主线程跳过中间快照也不会漏掉
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> plantRequestsResolved{};
+    std::array<std::uint32_t, PLANT_TYPE_COUNT> plantsPlaced{};
+};
+
+// 模拟线程每个 tick 发布一份, 渲染线程只读; 三份缓冲轮流复用, 精灵数组容量稳定后不再分配
+struct RenderSnapshot
+{
+    std::uint32_t tick = 0;
+    float gameTime = 0.f;
+    std::vector<RenderSprite> sprites;
+    // 棋盘每行的占用位掩码 (同 Grid), 种植/铲除前的本地预判用
+    std::vector<std::uint64_t> rowOccupancyMasks;
+    HudValues hud;
+    // 模拟侧的调试统计 (实体数量、回溯/联机/观战状态)
+    std::string statsText;
+
+    bool isCellOccupied(const sf::Vector2i &gridPos) const
+    {
+        // gridPos.x 为行, gridPos.y 为列
+        if (gridPos.x < 0 || gridPos.y < 0 || gridPos.x >= static_cast<int>(rowOccupancyMasks.size()) || gridPos.y >= 64)
+            return false;
+        return (rowOccupancyMasks[static_cast<size_t>(gridPos.x)] >> gridPos.y) & 1u;
+    }
+
+    bool hasSunAt(const sf::Vector2f &worldPos) const
+    {
+        for (const RenderSprite &sprite : sprites)
+        {
+            if (sprite.layer == RenderLayer::SUNS && sprite.bounds.contains(worldPos))
+                return true;
+        }
+        return false;
+    }
+};
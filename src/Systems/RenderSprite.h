@@ -0,0 +1,23 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <cstdint>
+
+// 实体所在的绘制层, 按此顺序从下往上画
+enum class RenderLayer : std::uint8_t
+{
+    PLANTS,
+    SUNS,
+    PROJECTILES,
+    ZOMBIES
+};
+
+// 一个实体在某一 tick 的绘制数据: 精灵 (纹理、帧矩形、原点、颜色) 加上转换好的浮点位置
+struct RenderSprite
+{
+    sf::Sprite sprite;
+    sf::Vector2f position;
+    sf::FloatRect bounds; // 世界坐标包围盒, 用于视口裁剪和阳光点击预判
+    RenderLayer layer;
+};
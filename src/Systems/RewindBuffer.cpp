@@ -0,0 +1,145 @@
+#include "RewindBuffer.h"
+#include "../Utils/DeltaCodec.h"
+#include "../Utils/Constants.h"
+#include <ostream>
+
+RewindBuffer::RewindBuffer() : m_totalBytes(0), m_capturesSinceKeyframe(0)
+{
+}
+
+void RewindBuffer::clear()
+{
+    m_entries.clear();
+    m_totalBytes = 0;
+    m_capturesSinceKeyframe = 0;
+}
+
+void RewindBuffer::capture(std::uint32_t tick, const std::vector<std::uint8_t> &snapshot)
+{
+    const Entry *keyframe = findLastKeyframe();
+    Entry entry;
+    entry.tick = tick;
+    if (!keyframe || m_capturesSinceKeyframe >= REWIND_KEYFRAME_INTERVAL - 1)
+    {
+        entry.isKeyframe = true;
+        entry.data = snapshot;
+        m_capturesSinceKeyframe = 0;
+    }
+    else
+    {
+        m_scratch.clear();
+        DeltaCodec::encode(keyframe->data, snapshot, m_scratch);
+        entry.isKeyframe = false;
+        entry.data.assign(m_scratch.begin(), m_scratch.end());
+        m_capturesSinceKeyframe++;
+    }
+    m_totalBytes += entry.data.size();
+    m_entries.push_back(std::move(entry));
+    trim();
+}
+
+bool RewindBuffer::restore(std::uint32_t targetTick, std::vector<std::uint8_t> &outSnapshot, std::uint32_t &outTick) const
+{
+    for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it)
+    {
+        if (it->tick > targetTick)
+            continue;
+
+        if (it->isKeyframe)
+        {
+            outSnapshot = it->data;
+            outTick = it->tick;
+            return true;
+        }
+        // 增量记录: 向前找到它依赖的关键帧
+        for (auto keyIt = it; keyIt != m_entries.rend(); ++keyIt)
+        {
+            if (keyIt->isKeyframe)
+            {
+                if (!DeltaCodec::decode(keyIt->data, it->data, outSnapshot))
+                    return false;
+                outTick = it->tick;
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+void RewindBuffer::truncateAfter(std::uint32_t tick)
+{
+    while (!m_entries.empty() && m_entries.back().tick > tick)
+    {
+        m_totalBytes -= m_entries.back().data.size();
+        m_entries.pop_back();
+    }
+    // 重新计算当前关键帧之后已有的增量数
+    m_capturesSinceKeyframe = 0;
+    for (auto it = m_entries.rbegin(); it != m_entries.rend() && !it->isKeyframe; ++it)
+    {
+        m_capturesSinceKeyframe++;
+    }
+}
+
+std::uint32_t RewindBuffer::getOldestTick() const
+{
+    return m_entries.empty() ? 0 : m_entries.front().tick;
+}
+
+void RewindBuffer::writeStatsText(std::ostream &out) const
+{
+    size_t keyframes = 0;
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.isKeyframe)
+            keyframes++;
+    }
+    float seconds = 0.f;
+    if (!m_entries.empty())
+    {
+        seconds = (m_entries.back().tick - m_entries.front().tick) * TIME_PER_FRAME.asSeconds();
+    }
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(1);
+    out << std::fixed;
+    out << "Rewind: " << seconds << "s | " << m_entries.size() << " captures (" << keyframes << " key) | "
+        << (m_totalBytes / 1024.f) << " KB";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+const RewindBuffer::Entry *RewindBuffer::findLastKeyframe() const
+{
+    for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it)
+    {
+        if (it->isKeyframe)
+            return &(*it);
+    }
+    return nullptr;
+}
+
+void RewindBuffer::trim()
+{
+    const std::uint32_t maxTicks = static_cast<std::uint32_t>(REWIND_MAX_SECONDS / TIME_PER_FRAME.asSeconds());
+    // 以关键帧组为单位从最旧处裁剪, 至少保留当前组
+    while (m_entries.size() > 1)
+    {
+        bool overTime = m_entries.back().tick - m_entries.front().tick > maxTicks;
+        bool overBudget = m_totalBytes > REWIND_MEMORY_BUDGET_BYTES;
+        if (!overTime && !overBudget)
+            break;
+        if (&m_entries.front() == findLastKeyframe())
+            break;
+        popFrontGroup();
+    }
+}
+
+void RewindBuffer::popFrontGroup()
+{
+    do
+    {
+        m_totalBytes -= m_entries.front().data.size();
+        m_entries.pop_front();
+    } while (!m_entries.empty() && !m_entries.front().isKeyframe);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// 回溯缓冲: 环形保存最近一段时间的模拟快照
+// 每隔 REWIND_KEYFRAME_INTERVAL 次记录存一个完整关键帧, 其余记录只存与该关键帧的差分 (见 DeltaCodec)
+class RewindBuffer
+{
+public:
+    RewindBuffer();
+
+    void clear();
+    // 记录 tick 时刻的完整快照, 内部决定存关键帧还是增量, 并按时间/内存上限裁剪最旧的关键帧组
+    void capture(std::uint32_t tick, const std::vector<std::uint8_t> &snapshot);
+    // 找到 tick <= targetTick 的最近记录并解码, 没有可用记录时返回 false
+    bool restore(std::uint32_t targetTick, std::vector<std::uint8_t> &outSnapshot, std::uint32_t &outTick) const;
+    // 丢弃 tick 之后的记录 (回溯后时间线从这里重新分叉)
+    void truncateAfter(std::uint32_t tick);
+
+    bool isEmpty() const { return m_entries.empty(); }
+    std::uint32_t getOldestTick() const;
+    size_t getMemoryUsage() const { return m_totalBytes; }
+    // 写进调用方的流, 不生成临时字符串; 浮点格式用完即恢复
+    void writeStatsText(std::ostream &out) const;
+
+private:
+    struct Entry
+    {
+        std::uint32_t tick;
+        bool isKeyframe;
+        std::vector<std::uint8_t> data;
+    };
+
+    const Entry *findLastKeyframe() const;
+    void trim();
+    void popFrontGroup();
+
+    std::deque<Entry> m_entries;
+    size_t m_totalBytes;
+    int m_capturesSinceKeyframe;
+    // 复用的编码缓冲, 避免每次记录都重新分配
+    std::vector<std::uint8_t> m_scratch;
+};
@@ -0,0 +1,92 @@
+#include "SpriteBatch.h"
+#include <cmath>
+
+SpriteBatch::SpriteBatch()
+    : m_batchCount(0), m_lastVisibleCount(0), m_lastDrawCalls(0)
+{
+}
+
+void SpriteBatch::build(const std::vector<RenderSprite> &sprites, const sf::FloatRect &visibleArea)
+{
+    for (size_t i = 0; i < m_batchCount; ++i)
+    {
+        m_batches[i].vertices.clear();
+    }
+    m_batchCount = 0;
+    m_lastVisibleCount = 0;
+
+    size_t layerBegin = 0;
+    for (const RenderSprite &renderSprite : sprites)
+    {
+        if (!renderSprite.bounds.intersects(visibleArea))
+        {
+            continue;
+        }
+        if (m_batchCount > 0 && m_batches[m_batchCount - 1].layer != renderSprite.layer)
+        {
+            layerBegin = m_batchCount;
+        }
+        Batch &batch = getBatch(renderSprite.layer, renderSprite.sprite.getTexture(), layerBegin);
+        appendQuad(batch.vertices, renderSprite);
+        ++m_lastVisibleCount;
+    }
+}
+
+SpriteBatch::Batch &SpriteBatch::getBatch(RenderLayer layer, const sf::Texture *texture, size_t layerBegin)
+{
+    for (size_t i = layerBegin; i < m_batchCount; ++i)
+    {
+        if (m_batches[i].texture == texture)
+        {
+            return m_batches[i];
+        }
+    }
+    if (m_batchCount == m_batches.size())
+    {
+        m_batches.push_back(Batch{layer, texture, sf::VertexArray(sf::Quads)});
+    }
+    Batch &batch = m_batches[m_batchCount++];
+    batch.layer = layer;
+    batch.texture = texture;
+    return batch;
+}
+
+void SpriteBatch::appendQuad(sf::VertexArray &vertices, const RenderSprite &renderSprite)
+{
+    // 与 sf::Sprite 的绘制结果一致: 本地矩形 -> 精灵变换 (原点/缩放/旋转) -> 平移到快照位置
+    const sf::Sprite &sprite = renderSprite.sprite;
+    const sf::IntRect &rect = sprite.getTextureRect();
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    sf::Transform transform;
+    transform.translate(renderSprite.position);
+    transform.combine(sprite.getTransform());
+
+    float left = static_cast<float>(rect.left);
+    float right = left + static_cast<float>(rect.width);
+    float top = static_cast<float>(rect.top);
+    float bottom = top + static_cast<float>(rect.height);
+    const sf::Color &color = sprite.getColor();
+    vertices.append(sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)));
+    vertices.append(sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)));
+    vertices.append(sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)));
+    vertices.append(sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom)));
+}
+
+void SpriteBatch::draw(sf::RenderTarget &target)
+{
+    m_lastDrawCalls = 0;
+    for (size_t i = 0; i < m_batchCount; ++i)
+    {
+        // 每层每种纹理一次 draw 调用
+        sf::RenderStates states;
+        states.texture = m_batches[i].texture;
+        target.draw(m_batches[i].vertices, states);
+        ++m_lastDrawCalls;
+    }
+}
+
+void SpriteBatch::writeStatsText(std::ostream &out) const
+{
+    out << "Sprites: " << m_lastVisibleCount << " visible in " << m_lastDrawCalls << " calls";
+}
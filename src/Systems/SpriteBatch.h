@@ -0,0 +1,37 @@
+#pragma once
+
+#include "RenderSprite.h"
+#include <SFML/Graphics.hpp>
+#include <ostream>
+#include <vector>
+
+// 实体精灵批量绘制: 按快照把同一层、同一纹理的精灵合并进一个 VertexArray, 每批一次 draw 调用。
+// 帧动画只改变四边形的纹理坐标; 数组每帧清空重填, 容量稳定后不再分配。
+class SpriteBatch
+{
+public:
+    SpriteBatch();
+
+    // sprites 需按绘制层排好序 (快照的收集顺序); 视野外的精灵不进批次
+    void build(const std::vector<RenderSprite> &sprites, const sf::FloatRect &visibleArea);
+    void draw(sf::RenderTarget &target);
+
+    void writeStatsText(std::ostream &out) const;
+
+private:
+    struct Batch
+    {
+        RenderLayer layer;
+        const sf::Texture *texture;
+        sf::VertexArray vertices;
+    };
+
+    // 只在当前层已有的批次里找, 保证层与层之间的先后顺序
+    Batch &getBatch(RenderLayer layer, const sf::Texture *texture, size_t layerBegin);
+    static void appendQuad(sf::VertexArray &vertices, const RenderSprite &renderSprite);
+
+    std::vector<Batch> m_batches; // 只增不减, 前 m_batchCount 个有效
+    size_t m_batchCount;
+    size_t m_lastVisibleCount;
+    unsigned m_lastDrawCalls;
+};
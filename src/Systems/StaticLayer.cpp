@@ -0,0 +1,63 @@
+#include "StaticLayer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+StaticLayer::StaticLayer()
+    : m_textureSize(0, 0), m_valid(false), m_creationFailed(false)
+{
+}
+
+void StaticLayer::invalidate()
+{
+    m_valid = false;
+}
+
+bool StaticLayer::rebuild(const sf::FloatRect &worldArea, float pixelsPerUnit, const std::function<void(sf::RenderTarget &)> &drawContent)
+{
+    if (m_creationFailed)
+    {
+        return false;
+    }
+
+    // 纹理按窗口像素密度覆盖整个世界, 超过显卡上限时降低分辨率
+    float maxSize = static_cast<float>(sf::Texture::getMaximumSize());
+    float scale = std::min(pixelsPerUnit, std::min(maxSize / worldArea.width, maxSize / worldArea.height));
+    sf::Vector2u textureSize(static_cast<unsigned>(std::ceil(worldArea.width * scale)),
+                             static_cast<unsigned>(std::ceil(worldArea.height * scale)));
+    if (textureSize != m_textureSize)
+    {
+        if (!m_renderTexture.create(textureSize.x, textureSize.y))
+        {
+            std::cerr << "StaticLayer: Failed to create " << textureSize.x << "x" << textureSize.y
+                      << " render texture, falling back to direct drawing." << std::endl;
+            m_creationFailed = true;
+            m_valid = false;
+            return false;
+        }
+        m_renderTexture.setSmooth(true);
+        m_textureSize = textureSize;
+    }
+
+    m_renderTexture.setView(sf::View(worldArea));
+    m_renderTexture.clear(sf::Color::Transparent);
+    drawContent(m_renderTexture);
+    m_renderTexture.display();
+
+    // 贴图时覆盖同一块世界区域, 由摄像机视图决定显示哪一部分
+    m_sprite.setTexture(m_renderTexture.getTexture(), true);
+    m_sprite.setOrigin(0.f, 0.f);
+    m_sprite.setPosition(worldArea.left, worldArea.top);
+    m_sprite.setScale(worldArea.width / m_textureSize.x, worldArea.height / m_textureSize.y);
+
+    m_valid = true;
+    return true;
+}
+
+void StaticLayer::draw(sf::RenderWindow &window) const
+{
+    if (m_valid)
+    {
+        window.draw(m_sprite);
+    }
+}
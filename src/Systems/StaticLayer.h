@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+
+// 静态图层: 把关卡内不会变化的内容 (背景、网格线等) 预先画进离屏纹理,
+// 之后每帧只需一次 draw 调用贴图。纹理覆盖整个世界范围, 摄像机平移/缩放不需要重建,
+// 只有窗口尺寸或网格布局变化时才需要。
+class StaticLayer
+{
+public:
+    StaticLayer();
+
+    void invalidate();
+    bool isValid() const { return m_valid; }
+    // 离屏纹理创建失败时为 false, 调用方应回退到直接绘制
+    bool isUsable() const { return !m_creationFailed; }
+
+    // 把 worldArea 范围内的内容画进离屏纹理, pixelsPerUnit 为每个世界单位对应的纹理像素数
+    bool rebuild(const sf::FloatRect &worldArea, float pixelsPerUnit, const std::function<void(sf::RenderTarget &)> &drawContent);
+    // 按窗口当前视图 (摄像机) 贴图
+    void draw(sf::RenderWindow &window) const;
+
+private:
+    sf::RenderTexture m_renderTexture;
+    sf::Sprite m_sprite;
+    sf::Vector2u m_textureSize;
+    bool m_valid;
+    bool m_creationFailed;
+};
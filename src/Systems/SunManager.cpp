@@ -32,3 +32,8 @@ void SunManager::reset()
 {
     m_currentSun = m_initialSunValue;
 }
+
+void SunManager::setCurrentSun(int amount)
+{
+    m_currentSun = amount;
+}
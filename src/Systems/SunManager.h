@@ -10,6 +10,8 @@ public:
     void addSun(int amount);
     bool trySpendSun(int amount);
     void reset();
+    // 读档时直接恢复阳光数
+    void setCurrentSun(int amount);
 
 private:
     int m_currentSun;
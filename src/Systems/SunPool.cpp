@@ -0,0 +1,354 @@
+#include "SunPool.h"
+#include "SunManager.h"
+#include "../Core/ResourceManager.h"
+#include "../Utils/Constants.h"
+#include "../Utils/BinaryStream.h"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <iostream>
+
+SunPool::SunPool(ResourceManager &resManager, SunManager &sunManager, GameWorld &world, const sf::Vector2f &worldSize)
+    : m_resourceManagerRef(resManager),
+      m_sunManagerRef(sunManager),
+      m_worldRef(world),
+      m_hashCols(std::max(1, static_cast<int>(std::ceil(worldSize.x / SUN_PICK_CELL_SIZE)))),
+      m_hashRows(std::max(1, static_cast<int>(std::ceil(worldSize.y / SUN_PICK_CELL_SIZE)))),
+      m_poolTime(0),
+      m_nextSpawnOrder(0),
+      m_rng(0x5eedULL)
+{
+    m_buckets.resize(static_cast<size_t>(m_hashCols * m_hashRows));
+}
+
+SunPool::~SunPool() = default;
+
+EntityId SunPool::spawn(const FixedVector2 &spawnPosition, SunSpawnType type, Fixed skySunTargetYGround)
+{
+    Fixed plantSunDrift = type == SunSpawnType::FROM_PLANT ? m_rng.nextFixed(Fixed(-1), Fixed(1)) : Fixed(0);
+    EntityId id = m_worldRef.create<SunArchetype>();
+    initSun(id, spawnPosition, type, skySunTargetYGround, plantSunDrift);
+
+    SunState &state = m_worldRef.get<SunState>(id);
+    // 植物阳光的寿命从产生时开始计算, 天空阳光落地后才开始
+    if (type == SunSpawnType::FROM_PLANT)
+    {
+        scheduleExpiry(id, state, state.lifespan);
+    }
+    insertIntoHash(id, computeCellRange(m_worldRef.get<Visual>(id).getBounds(m_worldRef.get<Transform>(id).position)));
+    return id;
+}
+
+void SunPool::initSun(EntityId id, const FixedVector2 &spawnPosition, SunSpawnType type,
+                      Fixed skySunTargetYGround, Fixed plantSunDrift)
+{
+    Visual &visual = m_worldRef.get<Visual>(id);
+    visual.setTexture(m_resourceManagerRef.getTexture(SUN_TEXTURE_KEY));
+    visual.centerOrigin();
+
+    FixedVector2 &position = m_worldRef.get<Transform>(id).position;
+    position = spawnPosition;
+
+    SunState &state = m_worldRef.get<SunState>(id);
+    state.spawnType = type;
+    state.value = SUN_VALUE_DEFAULT;
+    state.spawnOrder = m_nextSpawnOrder++;
+
+    if (type == SunSpawnType::FROM_SKY)
+    {
+        state.falling = true;
+        state.lifespan = Fixed::fromFloat(SKY_SUN_LIFESPAN_ON_GROUND);
+        state.skyTargetY = skySunTargetYGround != Fixed(-1) ? skySunTargetYGround : position.y + 300;
+        if (state.skyTargetY <= position.y)
+            state.skyTargetY = position.y + 50;
+        std::cout << "Skysun Y=" << position.y.toFloat() << ", targetY=" << state.skyTargetY.toFloat() << std::endl;
+    }
+    else
+    {
+        state.lifespan = Fixed::fromFloat(PLANT_SUN_LIFESPAN);
+        state.velocity.y = Fixed::fromFloat(PLANT_SUN_SPAWN_VELOCITY_Y);
+        state.velocity.x = plantSunDrift * Fixed::fromFloat(PLANT_SUN_SPAWN_VELOCITY_X_MAX_OFFSET);
+        state.plantTarget = FixedVector2(position.x + state.velocity.x / 2,
+                                         position.y + Fixed::fromFloat(PLANT_SUN_TARGET_Y_OFFSET));
+        state.reachedTarget = false;
+        std::cout << "Plantsun (" << position.x.toFloat() << "," << position.y.toFloat()
+                  << "), target (" << state.plantTarget.x.toFloat() << "," << state.plantTarget.y.toFloat() << ")" << std::endl;
+    }
+}
+
+void SunPool::scheduleExpiry(EntityId id, SunState &state, Fixed lifespan)
+{
+    state.expireTime = m_poolTime + lifespan;
+    m_expiryQueue.push(ExpiryEntry{state.expireTime, id});
+}
+
+void SunPool::release(EntityId id)
+{
+    if (!m_worldRef.isAlive(id))
+        return;
+    // 队列里残留的到期条目随句柄一起失效
+    removeFromHash(id);
+    m_worldRef.destroy(id);
+}
+
+void SunPool::update(Fixed dt)
+{
+    m_poolTime += dt;
+
+    const Fixed fallSpeed = Fixed::fromFloat(SKY_SUN_FALL_SPEED);
+    const Fixed gravity = Fixed::fromFloat(PLANT_SUN_GRAVITY);
+    m_worldRef.archetype<SunArchetype>().each<Transform, Visual, SunState, SunPickCells>(
+        [&](EntityId id, Transform &transform, const Visual &visual, SunState &state, SunPickCells &cells)
+        {
+            // 静止的阳光无需逐帧处理
+            if (!state.isMoving())
+                return;
+
+            if (state.spawnType == SunSpawnType::FROM_SKY)
+            {
+                transform.position.y += fallSpeed * dt;
+                if (transform.position.y >= state.skyTargetY)
+                {
+                    transform.position.y = state.skyTargetY;
+                    state.falling = false;
+                    state.lifespan = Fixed::fromFloat(SKY_SUN_LIFESPAN_ON_GROUND);
+                    std::cout << "Skysun fall。" << std::endl;
+                }
+            }
+            else
+            {
+                // 模拟抛物线运动 (定点数, 各机器轨迹逐位一致)
+                state.velocity.y += gravity * dt;
+                transform.position += state.velocity * dt;
+                if (state.velocity.y > 0 && transform.position.y >= state.plantTarget.y)
+                {
+                    transform.position = state.plantTarget;
+                    state.reachedTarget = true;
+                    state.velocity = FixedVector2();
+                    std::cout << "Plantsun arrived target site" << std::endl;
+                }
+            }
+
+            SunPickCells newRange = computeCellRange(visual.getBounds(transform.position));
+            if (!(newRange == cells))
+            {
+                removeFromHash(id);
+                insertIntoHash(id, newRange);
+            }
+
+            if (!state.isMoving() && state.spawnType == SunSpawnType::FROM_SKY)
+            {
+                scheduleExpiry(id, state, state.lifespan);
+            }
+        });
+
+    // 到期队列: 只处理已经到时间的条目
+    m_expiredScratch.clear();
+    while (!m_expiryQueue.empty() && m_expiryQueue.top().expireTime <= m_poolTime)
+    {
+        m_expiredScratch.push_back(m_expiryQueue.top().sun);
+        m_expiryQueue.pop();
+    }
+    for (EntityId id : m_expiredScratch)
+    {
+        release(id);
+    }
+}
+
+void SunPool::sortBySpawnOrder() const
+{
+    m_orderScratch.clear();
+    m_worldRef.archetype<SunArchetype>().each<SunState>(
+        [this](EntityId id, const SunState &state)
+        { m_orderScratch.emplace_back(state.spawnOrder, id); });
+    std::sort(m_orderScratch.begin(), m_orderScratch.end(),
+              [](const auto &a, const auto &b)
+              { return a.first < b.first; });
+}
+
+void SunPool::collectInSpawnOrder(std::vector<EntityId> &outSuns) const
+{
+    sortBySpawnOrder();
+    outSuns.clear();
+    for (const auto &entry : m_orderScratch)
+    {
+        outSuns.push_back(entry.second);
+    }
+}
+
+void SunPool::collectRenderSprites(std::vector<RenderSprite> &sprites) const
+{
+    // 按生成顺序输出, 越晚生成越在上层 (与 pickTopmost 一致)
+    // 每个 tick 都调用, 直接读排序缓冲, 不另建句柄数组
+    sortBySpawnOrder();
+    for (const auto &entry : m_orderScratch)
+    {
+        EntityId id = entry.second;
+        sprites.push_back(m_worldRef.get<Visual>(id).toRenderSprite(m_worldRef.get<Transform>(id).position, RenderLayer::SUNS));
+    }
+}
+
+void SunPool::clear()
+{
+    m_worldRef.destroyAll<SunArchetype>();
+    for (std::vector<EntityId> &bucket : m_buckets)
+    {
+        bucket.clear();
+    }
+    m_expiryQueue = decltype(m_expiryQueue)();
+    m_poolTime = 0;
+    m_nextSpawnOrder = 0;
+}
+
+EntityId SunPool::pickTopmost(const sf::Vector2f &mousePos) const
+{
+    // 拾取结果影响模拟 (阳光数), 与阳光包围盒一样在定点数下判断
+    FixedVector2 point = FixedVector2::fromVector(mousePos);
+    Fixed cellSize = Fixed::fromFloat(SUN_PICK_CELL_SIZE);
+    int cellX = (point.x / cellSize).floorToInt();
+    int cellY = (point.y / cellSize).floorToInt();
+    if (cellX < 0 || cellY < 0 || cellX >= m_hashCols || cellY >= m_hashRows)
+    {
+        return EntityId();
+    }
+
+    EntityId best;
+    std::uint32_t bestOrder = 0;
+    for (EntityId id : m_buckets[bucketIndex(cellX, cellY)])
+    {
+        const SunState &state = m_worldRef.get<SunState>(id);
+        if ((!best.isValid() || state.spawnOrder > bestOrder) &&
+            m_worldRef.get<Visual>(id).getBounds(m_worldRef.get<Transform>(id).position).contains(point))
+        {
+            best = id;
+            bestOrder = state.spawnOrder;
+        }
+    }
+    return best;
+}
+
+bool SunPool::tryCollectAt(const sf::Vector2f &mousePos)
+{
+    return tryCollectAt(mousePos, m_sunManagerRef);
+}
+
+bool SunPool::tryCollectAt(const sf::Vector2f &mousePos, SunManager &collector)
+{
+    EntityId id = pickTopmost(mousePos);
+    if (!id.isValid())
+    {
+        return false;
+    }
+    int value = m_worldRef.get<SunState>(id).value;
+    collector.addSun(value);
+    std::cout << "sun (" << value << ") total suns: " << collector.getCurrentSun() << std::endl;
+    release(id);
+    return true;
+}
+
+SunPickCells SunPool::computeCellRange(const FixedRect &bounds) const
+{
+    Fixed cellSize = Fixed::fromFloat(SUN_PICK_CELL_SIZE);
+    SunPickCells range;
+    range.minX = std::max(0, (bounds.left / cellSize).floorToInt());
+    range.minY = std::max(0, (bounds.top / cellSize).floorToInt());
+    range.maxX = std::min(m_hashCols - 1, (bounds.getRight() / cellSize).floorToInt());
+    range.maxY = std::min(m_hashRows - 1, (bounds.getBottom() / cellSize).floorToInt());
+    return range;
+}
+
+void SunPool::insertIntoHash(EntityId id, const SunPickCells &range)
+{
+    m_worldRef.get<SunPickCells>(id) = range;
+    for (int y = range.minY; y <= range.maxY; ++y)
+    {
+        for (int x = range.minX; x <= range.maxX; ++x)
+        {
+            m_buckets[bucketIndex(x, y)].push_back(id);
+        }
+    }
+}
+
+void SunPool::removeFromHash(EntityId id)
+{
+    SunPickCells &range = m_worldRef.get<SunPickCells>(id);
+    for (int y = range.minY; y <= range.maxY; ++y)
+    {
+        for (int x = range.minX; x <= range.maxX; ++x)
+        {
+            std::vector<EntityId> &bucket = m_buckets[bucketIndex(x, y)];
+            auto it = std::find(bucket.begin(), bucket.end(), id);
+            if (it != bucket.end())
+            {
+                *it = bucket.back();
+                bucket.pop_back();
+            }
+        }
+    }
+    range = SunPickCells();
+}
+
+void SunPool::saveState(BinaryWriter &writer) const
+{
+    writer.writeFixed(m_poolTime);
+    writer.write(m_rng.getState());
+    writer.write(m_rng.getIncrement());
+
+    std::vector<EntityId> suns;
+    collectInSpawnOrder(suns);
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(suns.size()));
+    for (EntityId id : suns)
+    {
+        const SunState &state = m_worldRef.get<SunState>(id);
+        writer.writeFixed(state.expireTime);
+        writer.writeFixedVector(m_worldRef.get<Transform>(id).position);
+        writer.write<std::uint8_t>(static_cast<std::uint8_t>(state.spawnType));
+        writer.write<std::int32_t>(state.value);
+        writer.writeFixed(state.lifespan);
+        writer.writeBool(state.falling);
+        writer.writeFixed(state.skyTargetY);
+        writer.writeFixedVector(state.velocity);
+        writer.writeFixedVector(state.plantTarget);
+        writer.writeBool(state.reachedTarget);
+    }
+}
+
+bool SunPool::loadState(BinaryReader &reader)
+{
+    clear();
+    m_poolTime = reader.readFixed();
+    std::uint64_t rngState = reader.read<std::uint64_t>();
+    std::uint64_t rngIncrement = reader.read<std::uint64_t>();
+    m_rng.setState(rngState, rngIncrement);
+
+    std::uint32_t count = reader.read<std::uint32_t>();
+    for (std::uint32_t n = 0; n < count && reader.isOk(); ++n)
+    {
+        Fixed expireTime = reader.readFixed();
+        EntityId id = m_worldRef.create<SunArchetype>();
+        Visual &visual = m_worldRef.get<Visual>(id);
+        visual.setTexture(m_resourceManagerRef.getTexture(SUN_TEXTURE_KEY));
+        visual.centerOrigin();
+
+        FixedVector2 &position = m_worldRef.get<Transform>(id).position;
+        position = reader.readFixedVector();
+        SunState &state = m_worldRef.get<SunState>(id);
+        state.spawnType = static_cast<SunSpawnType>(reader.read<std::uint8_t>());
+        state.value = reader.read<std::int32_t>();
+        state.lifespan = reader.readFixed();
+        state.falling = reader.readBool();
+        state.skyTargetY = reader.readFixed();
+        state.velocity = reader.readFixedVector();
+        state.plantTarget = reader.readFixedVector();
+        state.reachedTarget = reader.readBool();
+        state.spawnOrder = m_nextSpawnOrder++;
+
+        if (expireTime >= 0)
+        {
+            state.expireTime = expireTime;
+            m_expiryQueue.push(ExpiryEntry{expireTime, id});
+        }
+        insertIntoHash(id, computeCellRange(visual.getBounds(position)));
+    }
+    return reader.isOk();
+}
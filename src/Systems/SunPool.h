@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../Ecs/GameWorld.h"
+#include "../Utils/GameRandom.h"
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "RenderSprite.h"
+#include <vector>
+#include <queue>
+#include <utility>
+
+class ResourceManager;
+class SunManager;
+class BinaryWriter;
+class BinaryReader;
+
+// 阳光: 实体存放在阳光原型的块里 (块只增不减, 反复生成不再分配),
+// 这里负责下落/抛物线运动, 用世界空间哈希做点击拾取, 用到期队列处理消失
+class SunPool
+{
+public:
+    // worldSize 为关卡世界大小, 决定空间哈希覆盖的范围
+    SunPool(ResourceManager &resManager, SunManager &sunManager, GameWorld &world, const sf::Vector2f &worldSize);
+    ~SunPool();
+
+    EntityId spawn(const FixedVector2 &spawnPosition, SunSpawnType type, Fixed skySunTargetYGround = Fixed(-1));
+    void update(Fixed dt);
+    // 把所有阳光的绘制数据追加到渲染快照, 视口裁剪由渲染线程做
+    void collectRenderSprites(std::vector<RenderSprite> &sprites) const;
+    void clear();
+
+    // 收集光标下最上层的阳光, 成功返回 true (光标坐标在这里转成定点数)
+    bool tryCollectAt(const sf::Vector2f &mousePos);
+    bool tryCollectAt(const sf::Vector2f &mousePos, SunManager &collector);
+    // 只检查光标处是否有可收集的阳光, 不收集 (联机时本地预判用)
+    bool hasSunAt(const sf::Vector2f &mousePos) const { return pickTopmost(mousePos).isValid(); }
+    EntityId pickTopmost(const sf::Vector2f &mousePos) const;
+
+    size_t getActiveCount() const { return m_worldRef.archetype<SunArchetype>().size(); }
+
+    // 存档/快照: 按生成顺序保存活跃阳光及其到期时间, 读档后生成序号重新编排但相对顺序不变
+    void saveState(BinaryWriter &writer) const;
+    bool loadState(BinaryReader &reader);
+
+private:
+    struct ExpiryEntry
+    {
+        Fixed expireTime;
+        EntityId sun;
+        bool operator>(const ExpiryEntry &other) const { return expireTime > other.expireTime; }
+    };
+
+    void initSun(EntityId id, const FixedVector2 &spawnPosition, SunSpawnType type,
+                 Fixed skySunTargetYGround, Fixed plantSunDrift);
+    void release(EntityId id);
+    void scheduleExpiry(EntityId id, SunState &state, Fixed lifespan);
+    // 按生成序号排列的活跃阳光 (绘制和存档顺序); sortBySpawnOrder 只排到 m_orderScratch 里
+    void sortBySpawnOrder() const;
+    void collectInSpawnOrder(std::vector<EntityId> &outSuns) const;
+
+    SunPickCells computeCellRange(const FixedRect &bounds) const;
+    void insertIntoHash(EntityId id, const SunPickCells &range);
+    void removeFromHash(EntityId id);
+    int bucketIndex(int cellX, int cellY) const { return cellY * m_hashCols + cellX; }
+
+    ResourceManager &m_resourceManagerRef;
+    SunManager &m_sunManagerRef;
+    GameWorld &m_worldRef;
+
+    // 空间哈希: 每个格子存放覆盖它的阳光
+    std::vector<std::vector<EntityId>> m_buckets;
+    int m_hashCols;
+    int m_hashRows;
+
+    // 到期队列 (最小堆), 已被收集的阳光句柄失效, 出队时跳过
+    std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>, std::greater<ExpiryEntry>> m_expiryQueue;
+    Fixed m_poolTime;
+    std::uint32_t m_nextSpawnOrder;
+    std::vector<EntityId> m_expiredScratch;
+    mutable std::vector<std::pair<std::uint32_t, EntityId>> m_orderScratch;
+
+    // 植物阳光抛出方向的随机数, 随快照一起保存
+    GameRandom m_rng;
+};
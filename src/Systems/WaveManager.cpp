@@ -2,57 +2,37 @@
 #include "ZombieManager.h"
 #include "../Core/Game.h"
 #include "../Utils/Constants.h"
+#include "../Utils/BinaryStream.h"
 #include <iostream>
-#include <cstdlib>
 #include <algorithm>
 #include <vector>
-#include <sstream>
-#include <iomanip>
-
-namespace
-{
-    float randomFloat(float min, float max)
-    {
-        if (min >= max)
-            return min;
-        if ((max - min) < 0.00001f && (max - min) > -0.00001f)
-            return min;
-        return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
-    }
-
-    int randomInt(int min, int max)
-    {
-        if (min > max)
-            std::swap(min, max);
-        if (min == max)
-            return min;
-        return min + (rand() % (max - min + 1));
-    }
-}
+#include <ostream>
 
 WaveManager::WaveManager(ZombieManager &zombieManager, Game &game)
     : m_zombieManagerRef(zombieManager),
       m_gameRef(game),
       m_currentSpawnState(SpawnState::IDLE),
       m_currentWaveNumber(0),
-      m_nextNormalSpawnTime(0.0f),
-      m_initialPeaceDuration(20.0f),
-      m_wavePrepareDuration(3.0f),
-      m_hugeWaveAnnounceDuration(5.0f),
+      m_stateTime(0),
+      m_spawnIntervalTime(0),
+      m_nextNormalSpawnTime(0),
+      m_initialPeaceDuration(20),
+      m_wavePrepareDuration(3),
+      m_hugeWaveAnnounceDuration(5),
       m_normalWave_targetZombiesToSpawn(0),
       m_normalWave_zombiesSpawnedThisWave(0),
       m_normalWave_minLanes(1),
-      m_normalWave_maxLanes(GRID_ROWS / 2 > 1 ? GRID_ROWS / 2 : 1),
+      m_normalWave_maxLanes(zombieManager.getLaneCount() / 2 > 1 ? zombieManager.getLaneCount() / 2 : 1),
       m_normalWave_minZombiesPerSpawnEvent(1),
       m_normalWave_maxZombiesPerSpawnEvent(2),
-      m_normalWave_spawnIntervalMin(7.0f),
-      m_normalWave_spawnIntervalMax(12.0f),
+      m_normalWave_spawnIntervalMin(7),
+      m_normalWave_spawnIntervalMax(12),
       m_hugeWave_zombiesPerLaneMin(3),
       m_hugeWave_zombiesPerLaneMax(5),
       m_hugeWave_spawnedThisCycle(false),
       m_hugeWaveFrequency(4),
       m_wavesSinceLastHugeWave(0),
-      m_waveCooldownDuration(15.0f),
+      m_waveCooldownDuration(15),
       m_minZombiesOnScreenToEndCooldown(3)
 {
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -63,7 +43,12 @@ WaveManager::WaveManager(ZombieManager &zombieManager, Game &game)
 void WaveManager::start()
 {
     reset();
-    std::cout << "WaveManager: Started. Initial peace period for " << m_initialPeaceDuration << "s." << std::endl;
+    std::cout << "WaveManager: Started. Initial peace period for " << m_initialPeaceDuration.toFloat() << "s." << std::endl;
+}
+
+void WaveManager::seed(std::uint64_t seed)
+{
+    m_rng.seed(seed);
 }
 
 void WaveManager::reset()
@@ -73,13 +58,15 @@ void WaveManager::reset()
     m_wavesSinceLastHugeWave = 0;
     m_normalWave_zombiesSpawnedThisWave = 0;
     m_hugeWave_spawnedThisCycle = false;
-    m_stateTimer.restart();
-    m_spawnIntervalTimer.restart();
+    m_stateTime = 0;
+    m_spawnIntervalTime = 0;
     std::cout << "WaveManager: Reset to initial state." << std::endl;
 }
 
-void WaveManager::update(float dt)
+void WaveManager::update(Fixed dt)
 {
+    m_stateTime += dt;
+    m_spawnIntervalTime += dt;
 
     if (m_currentSpawnState == SpawnState::ALL_WAVES_COMPLETED)
     {
@@ -127,12 +114,12 @@ void WaveManager::transitionToState(SpawnState newState)
               << " to " << static_cast<int>(newState) << std::endl;
 
     m_currentSpawnState = newState;
-    m_stateTimer.restart();
+    m_stateTime = 0;
 
     if (newState == SpawnState::NORMAL_SPAWN)
     {
-        m_spawnIntervalTimer.restart();
-        m_nextNormalSpawnTime = randomFloat(m_normalWave_spawnIntervalMin, m_normalWave_spawnIntervalMax);
+        m_spawnIntervalTime = 0;
+        m_nextNormalSpawnTime = m_rng.nextFixed(m_normalWave_spawnIntervalMin, m_normalWave_spawnIntervalMax);
         m_normalWave_zombiesSpawnedThisWave = 0;
     }
     else if (newState == SpawnState::HUGE_WAVE_SPAWN)
@@ -141,10 +128,10 @@ void WaveManager::transitionToState(SpawnState newState)
     }
 }
 
-void WaveManager::updateIdleState(float dt)
+void WaveManager::updateIdleState(Fixed dt)
 {
 
-    if (m_currentWaveNumber == 0 && m_stateTimer.getElapsedTime().asSeconds() >= m_initialPeaceDuration)
+    if (m_currentWaveNumber == 0 && m_stateTime >= m_initialPeaceDuration)
     {
         prepareNextWaveLogic();
     }
@@ -168,9 +155,9 @@ void WaveManager::prepareNextWaveLogic()
     transitionToState(SpawnState::PREPARING_WAVE);
 }
 
-void WaveManager::updatePreparingWaveState(float dt)
+void WaveManager::updatePreparingWaveState(Fixed dt)
 {
-    if (m_stateTimer.getElapsedTime().asSeconds() >= m_wavePrepareDuration)
+    if (m_stateTime >= m_wavePrepareDuration)
     {
         if (m_wavesSinceLastHugeWave >= m_hugeWaveFrequency && m_currentWaveNumber <= TOTAL_WAVES_TO_WIN)
         {
@@ -183,7 +170,7 @@ void WaveManager::updatePreparingWaveState(float dt)
     }
 }
 
-void WaveManager::updateNormalSpawnState(float dt)
+void WaveManager::updateNormalSpawnState(Fixed dt)
 {
     if (m_normalWave_zombiesSpawnedThisWave >= m_normalWave_targetZombiesToSpawn)
     {
@@ -194,16 +181,16 @@ void WaveManager::updateNormalSpawnState(float dt)
         return;
     }
 
-    if (m_spawnIntervalTimer.getElapsedTime().asSeconds() >= m_nextNormalSpawnTime)
+    if (m_spawnIntervalTime >= m_nextNormalSpawnTime)
     {
         spawnZombiesForNormalWave();
-        m_spawnIntervalTimer.restart();
-        m_nextNormalSpawnTime = randomFloat(m_normalWave_spawnIntervalMin, m_normalWave_spawnIntervalMax);
+        m_spawnIntervalTime = 0;
+        m_nextNormalSpawnTime = m_rng.nextFixed(m_normalWave_spawnIntervalMin, m_normalWave_spawnIntervalMax);
     }
 }
-ZombieType WaveManager::getRandomZombieTypeForCurrentWave() const
+ZombieType WaveManager::getRandomZombieTypeForCurrentWave()
 {
-    int RandomNum = randomInt(1, 4);
+    int RandomNum = m_rng.nextInt(1, 4);
     ZombieType selectedType;
     switch (RandomNum)
     {
@@ -227,13 +214,16 @@ ZombieType WaveManager::getRandomZombieTypeForCurrentWave() const
 
 void WaveManager::spawnZombiesForNormalWave()
 {
-    int lanesToSpawnIn = randomInt(m_normalWave_minLanes, m_normalWave_maxLanes);
-    lanesToSpawnIn = std::min(lanesToSpawnIn, GRID_ROWS);
+    int lanesToSpawnIn = m_rng.nextInt(m_normalWave_minLanes, m_normalWave_maxLanes);
+    int laneCount = m_zombieManagerRef.getLaneCount();
+    lanesToSpawnIn = std::min(lanesToSpawnIn, laneCount);
 
-    std::vector<int> availableLanes(GRID_ROWS);
-    for (int i = 0; i < GRID_ROWS; ++i)
-        availableLanes[i] = i;
-    std::shuffle(availableLanes.begin(), availableLanes.end(), m_rng);
+    // 手写 Fisher-Yates: std::shuffle 的置换方式由标准库实现决定, 不同平台结果不同, 会破坏锁步/回溯的确定性
+    m_laneScratch.resize(static_cast<std::size_t>(laneCount));
+    for (int i = 0; i < laneCount; ++i)
+        m_laneScratch[i] = i;
+    for (int i = laneCount - 1; i > 0; --i)
+        std::swap(m_laneScratch[i], m_laneScratch[m_rng.nextInt(0, i)]);
 
     int zombiesActuallySpawnedThisEvent = 0;
     for (int i = 0; i < lanesToSpawnIn; ++i)
@@ -241,8 +231,8 @@ void WaveManager::spawnZombiesForNormalWave()
         if (m_normalWave_zombiesSpawnedThisWave >= m_normalWave_targetZombiesToSpawn)
             break;
 
-        int lane = availableLanes[i];
-        int zombiesInThisLane = randomInt(m_normalWave_minZombiesPerSpawnEvent, m_normalWave_maxZombiesPerSpawnEvent);
+        int lane = m_laneScratch[i];
+        int zombiesInThisLane = m_rng.nextInt(m_normalWave_minZombiesPerSpawnEvent, m_normalWave_maxZombiesPerSpawnEvent);
 
         for (int z = 0; z < zombiesInThisLane; ++z)
         {
@@ -262,16 +252,16 @@ void WaveManager::spawnZombiesForNormalWave()
     }
 }
 
-void WaveManager::updateHugeWaveAnnounceState(float dt)
+void WaveManager::updateHugeWaveAnnounceState(Fixed dt)
 {
     std::cout << "WaveManager: ANNOUNCING HUGE WAVE for Wave " << m_currentWaveNumber << "!" << std::endl;
-    if (m_stateTimer.getElapsedTime().asSeconds() >= m_hugeWaveAnnounceDuration)
+    if (m_stateTime >= m_hugeWaveAnnounceDuration)
     {
         transitionToState(SpawnState::HUGE_WAVE_SPAWN);
     }
 }
 
-void WaveManager::updateHugeWaveSpawnState(float dt)
+void WaveManager::updateHugeWaveSpawnState(Fixed dt)
 {
     if (!m_hugeWave_spawnedThisCycle)
     {
@@ -291,9 +281,10 @@ void WaveManager::spawnZombiesForHugeWave()
 {
     std::cout << "WaveManager: Spawning HUGE WAVE zombies for Wave " << m_currentWaveNumber << std::endl;
     int totalSpawned = 0;
-    for (int lane = 0; lane < GRID_ROWS; ++lane)
+    int laneCount = m_zombieManagerRef.getLaneCount();
+    for (int lane = 0; lane < laneCount; ++lane)
     {
-        int numZombiesInLane = randomInt(m_hugeWave_zombiesPerLaneMin, m_hugeWave_zombiesPerLaneMax);
+        int numZombiesInLane = m_rng.nextInt(m_hugeWave_zombiesPerLaneMin, m_hugeWave_zombiesPerLaneMax);
         for (int j = 0; j < numZombiesInLane; ++j)
         {
             m_zombieManagerRef.spawnZombie(lane, ZombieType::BASIC);
@@ -303,10 +294,10 @@ void WaveManager::spawnZombiesForHugeWave()
     std::cout << "WaveManager: Spawned " << totalSpawned << " zombies for the huge wave." << std::endl;
 }
 
-void WaveManager::updateWaveCooldownState(float dt)
+void WaveManager::updateWaveCooldownState(Fixed dt)
 {
-    bool canEndCooldownEarly = (m_zombieManagerRef.getActiveZombies().size() <= m_minZombiesOnScreenToEndCooldown);
-    bool cooldownTimeElapsed = (m_stateTimer.getElapsedTime().asSeconds() >= m_waveCooldownDuration);
+    bool canEndCooldownEarly = (m_zombieManagerRef.getActiveZombieCount() <= m_minZombiesOnScreenToEndCooldown);
+    bool cooldownTimeElapsed = (m_stateTime >= m_waveCooldownDuration);
 
     if (cooldownTimeElapsed || canEndCooldownEarly)
     {
@@ -331,7 +322,7 @@ void WaveManager::updateWaveCooldownState(float dt)
     }
 }
 
-void WaveManager::updateAllWavesCompletedState(float dt)
+void WaveManager::updateAllWavesCompletedState(Fixed dt)
 {
 }
 
@@ -350,20 +341,21 @@ bool WaveManager::isGameInPeacefulPeriod() const
 {
     return m_currentSpawnState == SpawnState::IDLE ||
            m_currentSpawnState == SpawnState::ALL_WAVES_COMPLETED ||
-           (m_currentSpawnState == SpawnState::WAVE_COOLDOWN && m_zombieManagerRef.getActiveZombies().empty());
+           (m_currentSpawnState == SpawnState::WAVE_COOLDOWN && m_zombieManagerRef.getActiveZombieCount() == 0);
 }
 
 float WaveManager::getCurrentWaveProgress() const
 {
     float progress = 0.0f;
-    float elapsedTime = m_stateTimer.getElapsedTime().asSeconds();
+    // 只用于 HUD 进度条, 转成 float 即可
+    float elapsedTime = m_stateTime.toFloat();
 
     switch (m_currentSpawnState)
     {
     case SpawnState::IDLE:
         if (m_currentWaveNumber == 0 && m_initialPeaceDuration > 0)
         {
-            progress = elapsedTime / m_initialPeaceDuration;
+            progress = elapsedTime / m_initialPeaceDuration.toFloat();
         }
         else
         {
@@ -373,7 +365,7 @@ float WaveManager::getCurrentWaveProgress() const
     case SpawnState::PREPARING_WAVE:
         if (m_wavePrepareDuration > 0)
         {
-            progress = elapsedTime / m_wavePrepareDuration;
+            progress = elapsedTime / m_wavePrepareDuration.toFloat();
         }
         break;
     case SpawnState::NORMAL_SPAWN:
@@ -385,7 +377,7 @@ float WaveManager::getCurrentWaveProgress() const
     case SpawnState::HUGE_WAVE_ANNOUNCE:
         if (m_hugeWaveAnnounceDuration > 0)
         {
-            progress = elapsedTime / m_hugeWaveAnnounceDuration;
+            progress = elapsedTime / m_hugeWaveAnnounceDuration.toFloat();
         }
         break;
     case SpawnState::HUGE_WAVE_SPAWN:
@@ -394,7 +386,7 @@ float WaveManager::getCurrentWaveProgress() const
     case SpawnState::WAVE_COOLDOWN:
         if (m_waveCooldownDuration > 0)
         {
-            progress = elapsedTime / m_waveCooldownDuration;
+            progress = elapsedTime / m_waveCooldownDuration.toFloat();
         }
         break;
     case SpawnState::ALL_WAVES_COMPLETED:
@@ -411,79 +403,114 @@ float WaveManager::getCurrentWaveProgress() const
 #endif
 }
 
-std::string WaveManager::getWaveProgressLabel() const
+void WaveManager::writeWaveProgressLabel(std::ostream &out) const
 {
-    std::string waveNumStr = std::to_string(m_currentWaveNumber) + "/" + std::to_string(TOTAL_WAVES_TO_WIN);
-    std::string baseStatus = "Wave: " + waveNumStr;
-
     if (m_currentSpawnState == SpawnState::ALL_WAVES_COMPLETED)
-        return "All Waves Processed!";
-
+    {
+        out << "All Waves Processed!";
+        return;
+    }
     if (m_currentWaveNumber == 0 && m_currentSpawnState == SpawnState::IDLE)
-        return "Starting Soon...";
+    {
+        out << "Starting Soon...";
+        return;
+    }
+
+    out << "Wave: " << m_currentWaveNumber << "/" << TOTAL_WAVES_TO_WIN;
     switch (m_currentSpawnState)
     {
     case SpawnState::IDLE:
-        return baseStatus + (m_currentWaveNumber == 0 ? " (Starting)" : " (Peace)");
+        out << (m_currentWaveNumber == 0 ? " (Starting)" : " (Peace)");
+        break;
     case SpawnState::PREPARING_WAVE:
-        return baseStatus + " (Get Ready!)";
+        out << " (Get Ready!)";
+        break;
     case SpawnState::NORMAL_SPAWN:
-        return baseStatus + " (" + std::to_string(m_normalWave_zombiesSpawnedThisWave) + "/" + std::to_string(m_normalWave_targetZombiesToSpawn) + ")";
+        out << " (" << m_normalWave_zombiesSpawnedThisWave << "/" << m_normalWave_targetZombiesToSpawn << ")";
+        break;
     case SpawnState::HUGE_WAVE_ANNOUNCE:
-        return baseStatus + " (HUGE WAVE!)";
+        out << " (HUGE WAVE!)";
+        break;
     case SpawnState::HUGE_WAVE_SPAWN:
-        return baseStatus + " (ATTACK!)";
+        out << " (ATTACK!)";
+        break;
     case SpawnState::WAVE_COOLDOWN:
-        return baseStatus + " (Clearing...)";
-    case SpawnState::ALL_WAVES_COMPLETED:
-        return "All Waves Done!";
+        out << " (Clearing...)";
+        break;
     default:
-        return baseStatus;
+        break;
     }
 }
 
-std::string WaveManager::getCurrentWaveStatusText() const
+void WaveManager::writeCurrentWaveStatusText(std::ostream &out) const
 {
-    std::string status = "Wave: " + std::to_string(m_currentWaveNumber) + "/" + std::to_string(TOTAL_WAVES_TO_WIN);
+    out << "Wave: " << m_currentWaveNumber << "/" << TOTAL_WAVES_TO_WIN;
 
     if (m_currentSpawnState == SpawnState::ALL_WAVES_COMPLETED)
     {
-        status += " (ALL WAVES COMPLETED)";
-    }
-    else
-    {
-        switch (m_currentSpawnState)
-        {
-        case SpawnState::IDLE:
-            status += (m_currentWaveNumber == 0 ? " (Starting Soon)" : " (Peace Time)");
-            break;
-        case SpawnState::PREPARING_WAVE:
-            status += " (Get Ready!)";
-            break;
-        case SpawnState::NORMAL_SPAWN:
-            status += " (Incoming)";
-            break;
-        case SpawnState::HUGE_WAVE_ANNOUNCE:
-            status += " (HUGE WAVE INCOMING!)";
-            break;
-        case SpawnState::HUGE_WAVE_SPAWN:
-            status += " (THEY ARE HERE!)";
-            break;
-        case SpawnState::WAVE_COOLDOWN:
-            status += " (Clearing...)";
-            break;
-        default:
-            break;
-        }
+        out << " (ALL WAVES COMPLETED)";
+        return;
     }
 
-    if (m_currentSpawnState != SpawnState::ALL_WAVES_COMPLETED)
+    switch (m_currentSpawnState)
     {
-        float timeInState = m_stateTimer.getElapsedTime().asSeconds();
-        std::stringstream ssTime;
-        ssTime.precision(1);
-        ssTime << std::fixed << timeInState;
-        status += " T-" + ssTime.str() + "s";
+    case SpawnState::IDLE:
+        out << (m_currentWaveNumber == 0 ? " (Starting Soon)" : " (Peace Time)");
+        break;
+    case SpawnState::PREPARING_WAVE:
+        out << " (Get Ready!)";
+        break;
+    case SpawnState::NORMAL_SPAWN:
+        out << " (Incoming)";
+        break;
+    case SpawnState::HUGE_WAVE_ANNOUNCE:
+        out << " (HUGE WAVE INCOMING!)";
+        break;
+    case SpawnState::HUGE_WAVE_SPAWN:
+        out << " (THEY ARE HERE!)";
+        break;
+    case SpawnState::WAVE_COOLDOWN:
+        out << " (Clearing...)";
+        break;
+    default:
+        break;
     }
-    return status;
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(1);
+    out << " T-" << std::fixed << m_stateTime.toFloat() << "s";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void WaveManager::saveState(BinaryWriter &writer) const
+{
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(m_currentSpawnState));
+    writer.write<std::int32_t>(m_currentWaveNumber);
+    writer.writeFixed(m_stateTime);
+    writer.writeFixed(m_spawnIntervalTime);
+    writer.writeFixed(m_nextNormalSpawnTime);
+    writer.write<std::int32_t>(m_normalWave_targetZombiesToSpawn);
+    writer.write<std::int32_t>(m_normalWave_zombiesSpawnedThisWave);
+    writer.writeBool(m_hugeWave_spawnedThisCycle);
+    writer.write<std::int32_t>(m_wavesSinceLastHugeWave);
+    writer.write(m_rng.getState());
+    writer.write(m_rng.getIncrement());
+}
+
+bool WaveManager::loadState(BinaryReader &reader)
+{
+    m_currentSpawnState = static_cast<SpawnState>(reader.read<std::uint8_t>());
+    m_currentWaveNumber = reader.read<std::int32_t>();
+    m_stateTime = reader.readFixed();
+    m_spawnIntervalTime = reader.readFixed();
+    m_nextNormalSpawnTime = reader.readFixed();
+    m_normalWave_targetZombiesToSpawn = reader.read<std::int32_t>();
+    m_normalWave_zombiesSpawnedThisWave = reader.read<std::int32_t>();
+    m_hugeWave_spawnedThisCycle = reader.readBool();
+    m_wavesSinceLastHugeWave = reader.read<std::int32_t>();
+    std::uint64_t rngState = reader.read<std::uint64_t>();
+    std::uint64_t rngIncrement = reader.read<std::uint64_t>();
+    m_rng.setState(rngState, rngIncrement);
+    return reader.isOk();
 }
@@ -1,14 +1,16 @@
 #pragma once
 
 #include "ZombieManager.h"
-#include <SFML/System/Clock.hpp>
+#include "../Utils/GameRandom.h"
+#include <ostream>
 #include <string>
 #include <vector>
-#include <random>
 #include <chrono>
 
 class ZombieManager;
 class Game;
+class BinaryWriter;
+class BinaryReader;
 
 enum class SpawnState
 {
@@ -26,26 +28,33 @@ class WaveManager
 public:
     WaveManager(ZombieManager &zombieManager, Game &game);
 
-    void update(float dt);
+    void update(Fixed dt);
     void start();
     void reset();
+    // 固定随机种子 (确定性校验用), 默认按系统时间播种
+    void seed(std::uint64_t seed);
 
     int getCurrentWaveNumber() const;
     SpawnState getCurrentSpawnState() const;
-    std::string getCurrentWaveStatusText() const;
+    // 状态文本直接写进调用方的流 (每 tick 发布一次, 不生成临时字符串)
+    void writeCurrentWaveStatusText(std::ostream &out) const;
     bool isGameInPeacefulPeriod() const;
     float getCurrentWaveProgress() const;
-    std::string getWaveProgressLabel() const;
+    void writeWaveProgressLabel(std::ostream &out) const;
+
+    // 存档/快照: 状态机、计时器和随机数状态
+    void saveState(BinaryWriter &writer) const;
+    bool loadState(BinaryReader &reader);
 
 private:
     void transitionToState(SpawnState newState);
-    void updateIdleState(float dt);
-    void updatePreparingWaveState(float dt);
-    void updateNormalSpawnState(float dt);
-    void updateHugeWaveAnnounceState(float dt);
-    void updateHugeWaveSpawnState(float dt);
-    void updateWaveCooldownState(float dt);
-    void updateAllWavesCompletedState(float dt);
+    void updateIdleState(Fixed dt);
+    void updatePreparingWaveState(Fixed dt);
+    void updateNormalSpawnState(Fixed dt);
+    void updateHugeWaveAnnounceState(Fixed dt);
+    void updateHugeWaveSpawnState(Fixed dt);
+    void updateWaveCooldownState(Fixed dt);
+    void updateAllWavesCompletedState(Fixed dt);
 
     void prepareNextWaveLogic();
     void spawnZombiesForNormalWave();
@@ -57,16 +66,17 @@ private:
     SpawnState m_currentSpawnState;
     int m_currentWaveNumber;
 
-    sf::Clock m_stateTimer;
-    sf::Clock m_spawnIntervalTimer;
-    float m_nextNormalSpawnTime;
+    // 按模拟时间累计 (暂停时不走), 可随快照保存
+    Fixed m_stateTime;
+    Fixed m_spawnIntervalTime;
+    Fixed m_nextNormalSpawnTime;
 
     // 初始和平期
-    float m_initialPeaceDuration;
+    Fixed m_initialPeaceDuration;
 
     // 波次准备期/宣告期
-    float m_wavePrepareDuration;
-    float m_hugeWaveAnnounceDuration;
+    Fixed m_wavePrepareDuration;
+    Fixed m_hugeWaveAnnounceDuration;
 
     // 普通波次
     int m_normalWave_targetZombiesToSpawn;
@@ -75,8 +85,8 @@ private:
     int m_normalWave_maxLanes;
     int m_normalWave_minZombiesPerSpawnEvent;
     int m_normalWave_maxZombiesPerSpawnEvent;
-    float m_normalWave_spawnIntervalMin;
-    float m_normalWave_spawnIntervalMax;
+    Fixed m_normalWave_spawnIntervalMin;
+    Fixed m_normalWave_spawnIntervalMax;
 
     // 大规模波次
     int m_hugeWave_zombiesPerLaneMin;
@@ -86,10 +96,12 @@ private:
     int m_wavesSinceLastHugeWave;
 
     // 波次冷却/间歇期
-    float m_waveCooldownDuration;
+    Fixed m_waveCooldownDuration;
     float m_minZombiesOnScreenToEndCooldown;
 
     // 随机数
-    ZombieType getRandomZombieTypeForCurrentWave() const;
-    std::mt19937 m_rng;
+    ZombieType getRandomZombieTypeForCurrentWave();
+    GameRandom m_rng;
+    // 普通波次选行用的洗牌缓冲
+    std::vector<int> m_laneScratch;
 };
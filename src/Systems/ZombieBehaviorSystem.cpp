@@ -0,0 +1,206 @@
+#include "ZombieBehaviorSystem.h"
+#include "Grid.h"
+#include "../Utils/Constants.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+void ZombieBehaviorSystem::update(GameWorld &world, const Grid &grid, Fixed dt)
+{
+    const Fixed halfRange = Fixed::fromFloat(ZOMBIE_ATTACK_RANGE) / 2;
+
+    world.archetype<ZombieArchetype>().each<Transform, Visual, ZombieInfo, ZombieBrain, Slow>(
+        [&](EntityId id, Transform &transform, Visual &visual, const ZombieInfo &info, ZombieBrain &brain, Slow &slow)
+        {
+            if (brain.state == ZombieState::DEAD)
+                return;
+            const ZombieDescriptor &stats = getZombieDescriptor(info.type);
+
+            brain.stateTimer += dt;
+            visual.animator.update(visual.sprite);
+
+            if (slow.active)
+            {
+                slow.remaining -= dt;
+                if (slow.remaining <= 0)
+                {
+                    slow.active = false;
+                    slow.remaining = 0;
+                    brain.currentSpeed = stats.speed;
+                    visual.sprite.setColor(sf::Color::White);
+                    std::cout << "Zombie #" << id.index << " slow effect wore off." << std::endl;
+                }
+            }
+
+            switch (brain.state)
+            {
+            case ZombieState::WALKING:
+            {
+                int lane = getLane(grid, transform.position);
+                brain.target = lane != -1 ? findTargetPlant(world, grid, lane, visual.getBounds(transform.position)) : EntityId();
+                if (brain.target.isValid())
+                {
+                    changeState(brain, visual, ZombieState::ATTACKING);
+                    const FixedVector2 &plantPosition = world.get<Transform>(brain.target).position;
+                    std::cout << "[Zombie] DEBUG: #" << id.index << " at (X:" << transform.position.x.toFloat()
+                              << ", Y:" << transform.position.y.toFloat() << ") found target Plant #" << brain.target.index
+                              << " (X:" << plantPosition.x.toFloat() << ", Y:" << plantPosition.y.toFloat()
+                              << "), switching to ATTACKING." << std::endl;
+                }
+                else
+                {
+                    transform.position.x += -brain.currentSpeed * dt;
+                }
+                break;
+            }
+
+            case ZombieState::ATTACKING:
+            {
+                // 目标被吃掉或铲除后句柄失效, tryGet 返回空
+                Health *targetHealth = world.tryGet<Health>(brain.target);
+                if (!targetHealth || targetHealth->current <= 0)
+                {
+                    brain.target = EntityId();
+                    changeState(brain, visual, ZombieState::WALKING);
+                    break;
+                }
+
+                FixedRect zombieBounds = visual.getBounds(transform.position);
+                FixedRect plantBounds = world.get<Visual>(brain.target).getBounds(world.get<Transform>(brain.target).position);
+                bool stillInAttackPosition =
+                    (zombieBounds.left <= plantBounds.getRight() + halfRange) &&
+                    (zombieBounds.left >= plantBounds.left - halfRange);
+                if (!stillInAttackPosition)
+                {
+                    brain.target = EntityId();
+                    changeState(brain, visual, ZombieState::WALKING);
+                    break;
+                }
+
+                if (brain.stateTimer >= stats.attackInterval)
+                {
+                    targetHealth->current = std::max(0, targetHealth->current - stats.damagePerAttack);
+                    brain.stateTimer = 0;
+                }
+                break;
+            }
+
+            case ZombieState::DYING:
+                if (brain.stateTimer >= Fixed::fromRatio(1, 2))
+                {
+                    changeState(brain, visual, ZombieState::DEAD);
+                }
+                break;
+            case ZombieState::DEAD:
+                break;
+            }
+        });
+}
+
+EntityId ZombieBehaviorSystem::findTargetPlant(GameWorld &world, const Grid &grid, int lane, const FixedRect &zombieBounds) const
+{
+    EntityId target;
+    Fixed maxPlantXInReach = Fixed::fromRaw(INT32_MIN);
+    Fixed zombieAttackPointX = zombieBounds.left;
+    const Fixed attackRange = Fixed::fromFloat(ZOMBIE_ATTACK_RANGE);
+
+    // 只遍历该行位掩码中被占用的列
+    std::uint64_t mask = grid.getRowOccupancyMask(lane);
+    EntityId previous;
+    for (int col = 0; mask != 0; ++col, mask >>= 1)
+    {
+        if (!(mask & 1u))
+            continue;
+        EntityId plant = grid.getPlantAt(lane, col);
+        const Health *health = world.tryGet<Health>(plant);
+        if (plant == previous || !health || health->current <= 0)
+            continue;
+        previous = plant;
+
+        FixedRect plantBounds = world.get<Visual>(plant).getBounds(world.get<Transform>(plant).position);
+        bool isPlantInFrontAndReachable =
+            (zombieAttackPointX <= plantBounds.getRight() + attackRange / 2) &&
+            (plantBounds.left < zombieAttackPointX + attackRange);
+        if (isPlantInFrontAndReachable && plantBounds.left > maxPlantXInReach)
+        {
+            maxPlantXInReach = plantBounds.left;
+            target = plant;
+        }
+    }
+    return target;
+}
+
+int ZombieBehaviorSystem::getLane(const Grid &grid, const FixedVector2 &feetPosition)
+{
+    const Fixed cellHeight = Fixed::fromFloat(grid.getCellSize().y);
+    const Fixed gridStartY = Fixed::fromFloat(grid.getGridStartPosition().y);
+
+    if (cellHeight <= 0)
+        return -1;
+
+    if (feetPosition.y < gridStartY)
+        return -1;
+
+    int lane = ((feetPosition.y - gridStartY - cellHeight / 10) / cellHeight).truncToInt();
+    if (lane >= 0 && lane < grid.getRows())
+    {
+        return lane;
+    }
+    return -1;
+}
+
+void ZombieBehaviorSystem::changeState(ZombieBrain &brain, Visual &visual, ZombieState newState)
+{
+    if (brain.state == newState)
+        return;
+
+    brain.state = newState;
+    brain.stateTimer = 0;
+    playAnimationForState(visual, newState);
+}
+
+void ZombieBehaviorSystem::playAnimationForState(Visual &visual, ZombieState state)
+{
+    switch (state)
+    {
+    case ZombieState::WALKING:
+        visual.play(AnimationState::WALK);
+        break;
+    case ZombieState::ATTACKING:
+        visual.play(AnimationState::ATTACK);
+        break;
+    case ZombieState::DYING:
+        visual.play(AnimationState::DIE, true);
+        break;
+    case ZombieState::DEAD:
+        break;
+    }
+}
+
+void ZombieBehaviorSystem::takeDamage(Health &health, ZombieBrain &brain, Visual &visual, int amount)
+{
+    if (brain.state == ZombieState::DYING || brain.state == ZombieState::DEAD)
+        return;
+
+    health.current -= amount;
+    if (health.current <= 0)
+    {
+        health.current = 0;
+        changeState(brain, visual, ZombieState::DYING);
+    }
+}
+
+void ZombieBehaviorSystem::applySlow(Slow &slow, ZombieBrain &brain, const ZombieInfo &info, Visual &visual,
+                                     Fixed duration, Fixed slowFactor)
+{
+    if (brain.state == ZombieState::DEAD)
+        return;
+
+    slow.active = true;
+    slow.remaining = Fixed::max(slow.remaining, duration);
+    brain.currentSpeed = getZombieDescriptor(info.type).speed * slowFactor;
+    visual.sprite.setColor(sf::Color(100, 100, 255, 200));
+
+    std::cout << "Zombie slowed. New speed: " << brain.currentSpeed.toFloat()
+              << ", Duration: " << slow.remaining.toFloat() << "s" << std::endl;
+}
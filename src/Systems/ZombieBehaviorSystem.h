@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
+
+class Grid;
+
+// 僵尸行为: 行走、索敌、啃咬、死亡倒计时和减速计时, 直接遍历僵尸原型的组件数组
+class ZombieBehaviorSystem
+{
+public:
+    void update(GameWorld &world, const Grid &grid, Fixed dt);
+
+    // 脚底所在的行, 不在棋盘内返回 -1
+    static int getLane(const Grid &grid, const FixedVector2 &feetPosition);
+    // 以下供碰撞系统和读档调用
+    static void changeState(ZombieBrain &brain, Visual &visual, ZombieState newState);
+    static void playAnimationForState(Visual &visual, ZombieState state);
+    static void takeDamage(Health &health, ZombieBrain &brain, Visual &visual, int amount);
+    static void applySlow(Slow &slow, ZombieBrain &brain, const ZombieInfo &info, Visual &visual,
+                          Fixed duration, Fixed slowFactor);
+
+private:
+    EntityId findTargetPlant(GameWorld &world, const Grid &grid, int lane, const FixedRect &zombieBounds) const;
+};
@@ -1,99 +1,178 @@
 #include "ZombieManager.h"
-#include "../Entities/Zombie.h"
-#include "../Zombies/BasicZombie.h"
-#include "../Zombies/BigZombie.h"
-#include "../Zombies/BossZombie.h"
-#include "../Zombies/QuickZombie.h"
 #include "../Core/ResourceManager.h"
 #include "../Systems/Grid.h"
 #include "../Utils/Constants.h"
-#include <SFML/Graphics/RenderWindow.hpp>
-#include <algorithm>
+#include "../Utils/BinaryStream.h"
 #include <iostream>
 
-ZombieManager::ZombieManager(ResourceManager &resManager, Grid &grid)
-    : m_resourceManagerRef(resManager), m_gridRef(grid)
+ZombieManager::ZombieManager(ResourceManager &resManager, Grid &grid, GameWorld &world)
+    : m_resourceManagerRef(resManager), m_gridRef(grid), m_worldRef(world)
 {
 }
 
 ZombieManager::~ZombieManager() = default;
 
+EntityId ZombieManager::createZombie(ZombieType type, const FixedVector2 &position)
+{
+    if (!isValidZombieType(type))
+    {
+        std::cerr << "ZombieManager: undefined type zombie!" << std::endl;
+        return EntityId();
+    }
+    const ZombieDescriptor &descriptor = getZombieDescriptor(type);
+
+    EntityId id = m_worldRef.create<ZombieArchetype>();
+    m_worldRef.get<Transform>(id).position = position;
+    Visual &visual = m_worldRef.get<Visual>(id);
+    visual.setTexture(m_resourceManagerRef.getTexture(descriptor.textureKey));
+    visual.bindAnimation(descriptor.textureKey, id);
+    visual.play(AnimationState::WALK);
+    visual.bottomCenterOrigin();
+
+    m_worldRef.get<Health>(id).current = descriptor.health;
+    m_worldRef.get<ZombieInfo>(id).type = type;
+    m_worldRef.get<ZombieBrain>(id).currentSpeed = descriptor.speed;
+    return id;
+}
+
 void ZombieManager::spawnZombie(int row, ZombieType type)
 {
     // 生成位置
     // Y ,大致在行的中间
-    float spawnY = m_gridRef.getGridStartPosition().y + (static_cast<float>(row) + 0.5f) * m_gridRef.getCellSize().y + 15;
-    // X ,在屏幕右侧之外一点
-    float spawnX = static_cast<float>(WINDOW_WIDTH) + ZOMBIE_SPAWN_START_X_OFFSET;
-
-    sf::Vector2f spawnPosition(spawnX, spawnY);
+    Fixed cellHeight = Fixed::fromFloat(m_gridRef.getCellSize().y);
+    Fixed spawnY = Fixed::fromFloat(m_gridRef.getGridStartPosition().y) + cellHeight * row + cellHeight / 2 + 15;
+    // X ,在关卡世界右边界之外一点
+    FixedRect worldBounds = FixedRect::fromRect(m_gridRef.getWorldBounds());
+    Fixed spawnX = worldBounds.getRight() + Fixed::fromFloat(ZOMBIE_SPAWN_START_X_OFFSET);
 
     // 创建僵尸
-    std::unique_ptr<Zombie> newZombie = nullptr;
-    switch (type)
+    if (createZombie(type, FixedVector2(spawnX, spawnY)).isValid())
     {
-    case ZombieType::BASIC:
-        newZombie = std::make_unique<BasicZombie>(m_resourceManagerRef, spawnPosition, m_gridRef);
-        break;
-    case ZombieType::BIG:
-        newZombie = std::make_unique<BigZombie>(m_resourceManagerRef, spawnPosition, m_gridRef);
-        break;
-    case ZombieType::BOSS:
-        newZombie = std::make_unique<BossZombie>(m_resourceManagerRef, spawnPosition, m_gridRef);
-        break;
-    case ZombieType::QUICK:
-        newZombie = std::make_unique<QuickZombie>(m_resourceManagerRef, spawnPosition, m_gridRef);
-        break;
-    default:
-        std::cerr << "ZombieManager: undefined type zombie!" << std::endl;
-        return;
+        std::cout << "ZombieManager: Spawned a zombie of type " << static_cast<int>(type)
+                  << " in row " << row << std::endl;
     }
+}
+
+void ZombieManager::update(Fixed dt)
+{
+    m_behaviorSystem.update(m_worldRef, m_gridRef, dt);
 
-    if (newZombie)
+    m_deadScratch.clear();
+    m_worldRef.archetype<ZombieArchetype>().each<ZombieBrain>(
+        [this](EntityId id, const ZombieBrain &brain)
+        {
+            if (brain.state == ZombieState::DEAD)
+                m_deadScratch.push_back(id);
+        });
+    for (EntityId id : m_deadScratch)
     {
-        m_zombies.push_back(std::move(newZombie));
-        std::cout << "ZombieManager: Spawned a zombie of type " << static_cast<int>(type)
-                  << " in row " << row << std::endl;
+        m_worldRef.destroy(id);
     }
 }
-void ZombieManager::update(float dt, const sf::RenderWindow &window)
+
+void ZombieManager::collectRenderSprites(std::vector<RenderSprite> &sprites) const
 {
-    m_zombies.erase(
-        std::remove_if(m_zombies.begin(), m_zombies.end(),
-                       [](const std::unique_ptr<Zombie> &z_ptr)
-                       {
-                           if (!z_ptr)
-                               return true;
-                           return z_ptr->isReadyToBeRemoved();
-                       }),
-        m_zombies.end());
+    m_worldRef.archetype<ZombieArchetype>().each<Transform, Visual>(
+        [&sprites](EntityId, const Transform &transform, const Visual &visual)
+        { sprites.push_back(visual.toRenderSprite(transform.position, RenderLayer::ZOMBIES)); });
 }
 
-void ZombieManager::draw(sf::RenderWindow &window)
+int ZombieManager::getLaneCount() const
 {
-    for (const auto &zombie : m_zombies)
-    {
-        if (zombie)
-        {
-            zombie->draw(window);
-        }
-    }
+    return m_gridRef.getRows();
 }
 
 void ZombieManager::clear()
 {
-    m_zombies.clear();
+    m_worldRef.destroyAll<ZombieArchetype>();
+}
+
+size_t ZombieManager::getActiveZombieCount() const
+{
+    size_t count = 0;
+    m_worldRef.archetype<ZombieArchetype>().each<ZombieBrain>(
+        [&count](EntityId, const ZombieBrain &brain)
+        {
+            if (brain.state != ZombieState::DEAD)
+                ++count;
+        });
+    return count;
+}
+
+bool ZombieManager::hasZombieReached(Fixed x) const
+{
+    bool reached = false;
+    m_worldRef.archetype<ZombieArchetype>().each<Transform, ZombieBrain>(
+        [&reached, x](EntityId, const Transform &transform, const ZombieBrain &brain)
+        {
+            if (brain.state != ZombieState::DEAD && transform.position.x < x)
+                reached = true;
+        });
+    return reached;
+}
+
+void ZombieManager::saveState(BinaryWriter &writer) const
+{
+    writer.write<std::uint32_t>(static_cast<std::uint32_t>(m_worldRef.archetype<ZombieArchetype>().size()));
+    m_worldRef.archetype<ZombieArchetype>().each<Transform, Health, ZombieInfo, ZombieBrain, Slow>(
+        [this, &writer](EntityId, const Transform &transform, const Health &health, const ZombieInfo &info,
+                        const ZombieBrain &brain, const Slow &slow)
+        {
+            writer.write<std::uint8_t>(static_cast<std::uint8_t>(info.type));
+            writer.writeFixedVector(transform.position);
+            writer.write<std::int32_t>(health.current);
+            writer.writeFixed(brain.currentSpeed);
+            writer.write<std::uint8_t>(static_cast<std::uint8_t>(brain.state));
+            writer.writeFixed(brain.stateTimer);
+            writer.writeBool(slow.active);
+            writer.writeFixed(slow.remaining);
+
+            // 攻击目标按格子坐标保存, 读档时从网格重新取回
+            std::int32_t targetRow = -1;
+            std::int32_t targetCol = -1;
+            if (const PlantInfo *target = m_worldRef.tryGet<PlantInfo>(brain.target))
+            {
+                targetRow = target->gridPos.x;
+                targetCol = target->gridPos.y;
+            }
+            writer.write(targetRow);
+            writer.write(targetCol);
+        });
 }
 
-std::vector<Zombie *> ZombieManager::getActiveZombies()
+bool ZombieManager::loadState(BinaryReader &reader)
 {
-    std::vector<Zombie *> activeZombies;
-    for (const auto &zombie_ptr : m_zombies)
+    clear();
+    std::uint32_t count = reader.read<std::uint32_t>();
+    for (std::uint32_t i = 0; i < count && reader.isOk(); ++i)
     {
-        if (zombie_ptr && zombie_ptr->isAlive())
-        { // 只返回逻辑上存活的僵尸
-            activeZombies.push_back(zombie_ptr.get());
+        ZombieType type = static_cast<ZombieType>(reader.read<std::uint8_t>());
+        EntityId id = createZombie(type, FixedVector2());
+        if (!id.isValid())
+        {
+            reader.fail();
+            break;
+        }
+        m_worldRef.get<Transform>(id).position = reader.readFixedVector();
+        m_worldRef.get<Health>(id).current = reader.read<std::int32_t>();
+        ZombieBrain &brain = m_worldRef.get<ZombieBrain>(id);
+        brain.currentSpeed = reader.readFixed();
+        brain.state = static_cast<ZombieState>(reader.read<std::uint8_t>());
+        brain.stateTimer = reader.readFixed();
+        Slow &slow = m_worldRef.get<Slow>(id);
+        slow.active = reader.readBool();
+        slow.remaining = reader.readFixed();
+        std::int32_t targetRow = reader.read<std::int32_t>();
+        std::int32_t targetCol = reader.read<std::int32_t>();
+
+        brain.target = EntityId();
+        if (targetRow >= 0 && targetCol >= 0)
+        {
+            brain.target = m_gridRef.getPlantAt(targetRow, targetCol);
         }
+        Visual &visual = m_worldRef.get<Visual>(id);
+        visual.sprite.setColor(slow.active ? sf::Color(100, 100, 255, 200) : sf::Color::White);
+        ZombieBehaviorSystem::playAnimationForState(visual, brain.state);
     }
-    return activeZombies;
+    return reader.isOk();
 }
@@ -1,40 +1,47 @@
 #pragma once
 
 #include <vector>
-#include <memory>
 #include <SFML/System.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "RenderSprite.h"
+#include "ZombieBehaviorSystem.h"
+#include "../Ecs/GameWorld.h"
+#include "../Utils/Fixed.h"
 
-namespace sf
-{
-    class RenderWindow;
-}
-class Zombie;
 class ResourceManager;
 class Grid;
+class BinaryWriter;
+class BinaryReader;
 
-// 僵尸类型
-enum class ZombieType
-{
-    BASIC,
-    BIG,
-    BOSS,
-    QUICK
-};
-
+// 僵尸的外观: 生成/读档/清理都在这里, 行为由 ZombieBehaviorSystem 处理
 class ZombieManager
 {
 public:
-    ZombieManager(ResourceManager &resManager, Grid &grid);
+    ZombieManager(ResourceManager &resManager, Grid &grid, GameWorld &world);
     ~ZombieManager();
     void spawnZombie(int row, ZombieType type = ZombieType::BASIC);
-    void update(float dt, const sf::RenderWindow &window);
-    void draw(sf::RenderWindow &window);
+    // 行为更新后移除已死亡的僵尸
+    void update(Fixed dt);
+    // 把所有僵尸的绘制数据追加到渲染快照, 视口裁剪由渲染线程做
+    void collectRenderSprites(std::vector<RenderSprite> &sprites) const;
     void clear();
-    std::vector<Zombie *> getActiveZombies();
+    // 逻辑上存活 (未进入 DEAD) 的僵尸数
+    size_t getActiveZombieCount() const;
+    // 是否有存活僵尸走到了 x 左侧 (进屋)
+    bool hasZombieReached(Fixed x) const;
+    // 当前棋盘的行数, 波次生成据此选择行
+    int getLaneCount() const;
+
+    // 存档/快照 (需在植物恢复之后读取, 以便找回攻击目标)
+    void saveState(BinaryWriter &writer) const;
+    bool loadState(BinaryReader &reader);
 
 private:
-    std::vector<std::unique_ptr<Zombie>> m_zombies;
+    EntityId createZombie(ZombieType type, const FixedVector2 &position);
 
     ResourceManager &m_resourceManagerRef;
     Grid &m_gridRef;
+    GameWorld &m_worldRef;
+    ZombieBehaviorSystem m_behaviorSystem;
+    std::vector<EntityId> m_deadScratch;
 };
@@ -1,4 +1,5 @@
 #include "Button.h"
+#include "../Utils/Constants.h"
 
 const sf::Color Button::NORMAL_COLOR = sf::Color(100, 150, 100);
 const sf::Color Button::HOVER_COLOR = sf::Color(120, 170, 120);
@@ -18,7 +19,7 @@ Button::Button(const sf::Vector2f &position, const sf::Vector2f &size,
     m_buttonShape.setOutlineColor(sf::Color(50, 100, 50));
 
     // 设置文本样式
-    m_text.setCharacterSize(24);
+    m_text.setCharacterSize(BUTTON_FONT_SIZE);
 
     // 文本居中对齐
     sf::FloatRect textBounds = m_text.getLocalBounds();
@@ -1,18 +1,16 @@
 #include "HUD.h"
 #include "../Core/ResourceManager.h"
 #include "../Systems/SunManager.h"
-#include "../Systems/WaveManager.h"
+#include "../Systems/RenderSnapshot.h"
 #include "../Utils/Constants.h"
 #include <SFML/Window/Event.hpp>
-#include <sstream>
-#include <iomanip>
 #include <iostream>
+#include <string>
 
-HUD::HUD(ResourceManager &resManager, SunManager &sunManager, WaveManager &waveManager,
-         sf::Font &primaryFont, sf::Font &secondaryFont)
+HUD::HUD(ResourceManager &resManager, SunManager &sunManager,
+         const sf::Font &primaryFont, const sf::Font &secondaryFont)
     : m_seedManager(resManager, sunManager, primaryFont, secondaryFont),
       m_sunManagerRef(sunManager),
-      m_waveManagerRef(waveManager),
       m_resourceManagerRef_forHUD(resManager),
       m_primaryFontRef(primaryFont),
       m_waveProgressBar(
@@ -20,6 +18,8 @@ HUD::HUD(ResourceManager &resManager, SunManager &sunManager, WaveManager &waveM
           sf::Vector2f(200.f, 20.f),
           sf::Color(70, 70, 70, 200),
           sf::Color(200, 50, 50, 220)),
+      m_displayedSun(-1),
+      m_allWavesDoneShown(false),
       m_currentMode(HUDInteractionMode::NORMAL)
 {
     std::cout << "HUD constructing..." << std::endl;
@@ -29,17 +29,17 @@ HUD::HUD(ResourceManager &resManager, SunManager &sunManager, WaveManager &waveM
     m_sunDisplayText.setCharacterSize(SUN_DISPLAY_FONT_SIZE);
     m_sunDisplayText.setFillColor(sf::Color::Yellow);
     m_sunDisplayText.setOutlineColor(sf::Color::Black);
-    m_sunDisplayText.setOutlineThickness(1.f);
+    m_sunDisplayText.setOutlineThickness(SUN_DISPLAY_OUTLINE_THICKNESS);
     m_sunDisplayText.setPosition(SUN_DISPLAY_X, SUN_DISPLAY_Y);
 
     // 2. 初始化进度条的文本属性
     m_waveProgressBar.setFont(m_primaryFontRef);
-    m_waveProgressBar.setCharacterSize(12);
+    m_waveProgressBar.setCharacterSize(WAVE_PROGRESS_FONT_SIZE);
     m_waveProgressBar.setTextColor(sf::Color::White);
 
     // 3. 初始化总波数显示文本
     m_totalWavesText.setFont(m_primaryFontRef);
-    m_totalWavesText.setCharacterSize(14);
+    m_totalWavesText.setCharacterSize(TOTAL_WAVES_FONT_SIZE);
     m_totalWavesText.setFillColor(sf::Color(220, 220, 220));
     m_totalWavesText.setString("Total: " + std::to_string(TOTAL_WAVES_TO_WIN));
 
@@ -77,9 +77,10 @@ void HUD::setupShovelUI()
     m_shovelButtonArea.setSize(sf::Vector2f(shovelBounds.width, shovelBounds.height));
 
     // 加载铲子鼠标光标纹理
+    // 光标纹理属于 Game 的全局资源, HUD 只引用不持有
     if (!m_resourceManagerRef_forHUD.hasTexture(SHOVEL_CURSOR_TEXTURE_KEY))
     {
-        m_resourceManagerRef_forHUD.loadTexture(SHOVEL_CURSOR_TEXTURE_KEY, "../../assets/images/shovel.png");
+        std::cerr << "HUD: Shovel cursor texture '" << SHOVEL_CURSOR_TEXTURE_KEY << "' is not loaded." << std::endl;
     }
     m_mouseCursorShovel.setTexture(m_resourceManagerRef_forHUD.getTexture(SHOVEL_CURSOR_TEXTURE_KEY));
     // 将光标原点设为其“尖端”
@@ -131,21 +132,22 @@ bool HUD::handleEvent(const sf::Event &event, const sf::Vector2f &mousePosInView
     return false;
 }
 
-void HUD::update(float dt)
+void HUD::update(float dt, const HudValues &values)
 {
     m_seedManager.update(dt);
 
-    std::stringstream ssSun;
-    ssSun << m_sunManagerRef.getCurrentSun();
-    m_sunDisplayText.setString(ssSun.str());
-
-    float progress = m_waveManagerRef.getCurrentWaveProgress();
-    std::string progressLabel = m_waveManagerRef.getWaveProgressLabel();
+    // 文本只在数值变化时重建: setString 会分配并重建字形顶点
+    int currentSun = m_sunManagerRef.getCurrentSun();
+    if (currentSun != m_displayedSun)
+    {
+        m_displayedSun = currentSun;
+        m_sunDisplayText.setString(std::to_string(currentSun));
+    }
 
-    m_waveProgressBar.setProgress(progress);
-    m_waveProgressBar.setText(progressLabel);
+    m_waveProgressBar.setProgress(values.waveProgress);
+    m_waveProgressBar.setText(values.waveLabel);
 
-    SpawnState currentState = m_waveManagerRef.getCurrentSpawnState();
+    SpawnState currentState = values.waveState;
     sf::Color barFillColor = sf::Color(200, 50, 50, 220);
     switch (currentState)
     {
@@ -166,19 +168,14 @@ void HUD::update(float dt)
     }
     m_waveProgressBar.setFillColor(barFillColor);
 
-    if (m_waveManagerRef.getCurrentSpawnState() == SpawnState::ALL_WAVES_COMPLETED)
-    {
-
-        m_totalWavesText.setString("All waves done!");
-    }
-    else
+    bool allWavesDone = currentState == SpawnState::ALL_WAVES_COMPLETED;
+    if (allWavesDone != m_allWavesDoneShown)
     {
-        m_totalWavesText.setString("Total: " + std::to_string(TOTAL_WAVES_TO_WIN));
-        const sf::Vector2f progressBarDefinedPos = sf::Vector2f(WINDOW_WIDTH - 220.f, SEED_PACKET_UI_START_Y + 10.f);
-        const sf::Vector2f progressBarDefinedSize = sf::Vector2f(200.f, 20.f);
-        float totalWavesTextX = progressBarDefinedPos.x;
-        float totalWavesTextY = progressBarDefinedPos.y + progressBarDefinedSize.y + 5.f;
-        m_totalWavesText.setPosition(totalWavesTextX, totalWavesTextY);
+        m_allWavesDoneShown = allWavesDone;
+        if (allWavesDone)
+            m_totalWavesText.setString("All waves done!");
+        else
+            m_totalWavesText.setString("Total: " + std::to_string(TOTAL_WAVES_TO_WIN));
     }
 
     // 铲子图标颜色更新
@@ -220,6 +217,11 @@ PlantType HUD::getSelectedPlantTypeFromSeedManager(bool &isValidSelection) const
     return m_seedManager.getSelectedPlantType(isValidSelection);
 }
 
+void HUD::notifyPlantRequestedToSeedManager()
+{
+    m_seedManager.deselectAllPackets();
+}
+
 void HUD::notifyPlantPlacedToSeedManager(PlantType plantType)
 {
     m_seedManager.notifyPlantPlaced(plantType);
@@ -6,7 +6,7 @@
 
 class ResourceManager;
 class SunManager;
-class WaveManager;
+struct HudValues;
 
 // HUD的交互模式
 enum class HUDInteractionMode
@@ -18,14 +18,17 @@ enum class HUDInteractionMode
 class HUD
 {
 public:
-    HUD(ResourceManager &resManager, SunManager &sunManager, WaveManager &waveManager,
-        sf::Font &primaryFont, sf::Font &secondaryFont);
+    // sunManager 只用于显示和选卡判断, 数值由调用方每帧从模拟结果同步
+    HUD(ResourceManager &resManager, SunManager &sunManager,
+        const sf::Font &primaryFont, const sf::Font &secondaryFont);
 
     bool handleEvent(const sf::Event &event, const sf::Vector2f &mousePosInView);
-    void update(float dt);
+    void update(float dt, const HudValues &values);
     void draw(sf::RenderWindow &window);
 
     PlantType getSelectedPlantTypeFromSeedManager(bool &isValidSelection) const;
+    // 种植请求已发出: 取消选中; 模拟确认种植成功: 开始冷却
+    void notifyPlantRequestedToSeedManager();
     void notifyPlantPlacedToSeedManager(PlantType plantType);
     int getSelectedPlantCostFromSeedManager() const;
 
@@ -39,6 +42,9 @@ private:
     sf::Text m_sunDisplayText;
     ProgressBar m_waveProgressBar;
     sf::Text m_totalWavesText;
+    // 当前文本对应的值, 变化时才更新文本
+    int m_displayedSun;
+    bool m_allWavesDoneShown;
 
     // 铲子相关
     sf::Sprite m_shovelSprite;
@@ -47,7 +53,6 @@ private:
     sf::Sprite m_mouseCursorShovel;
 
     SunManager &m_sunManagerRef;
-    WaveManager &m_waveManagerRef;
     ResourceManager &m_resourceManagerRef_forHUD;
-    sf::Font &m_primaryFontRef;
+    const sf::Font &m_primaryFontRef;
 };
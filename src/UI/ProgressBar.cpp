@@ -40,7 +40,11 @@ float ProgressBar::getProgress() const
 
 void ProgressBar::setText(const std::string &text)
 {
-    m_text.setString(text);
+    // 每帧都会被调用, 文本没变时不转换成 sf::String
+    if (text == m_label)
+        return;
+    m_label = text;
+    m_text.setString(m_label);
     updateTextPosition();
 }
 
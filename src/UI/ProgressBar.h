@@ -32,6 +32,7 @@ private:
     sf::RectangleShape m_backgroundBar;
     sf::RectangleShape m_fillBar;
     sf::Text m_text;
+    std::string m_label;
 
     sf::Vector2f m_size;
     float m_currentProgress;
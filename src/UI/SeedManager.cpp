@@ -2,12 +2,13 @@
 #include "SeedManager.h"
 #include "../Core/ResourceManager.h"
 #include "../Systems/SunManager.h"
+#include "../Ecs/EntityDescriptors.h"
 #include "../Utils/Constants.h"
 #include <SFML/Window/Event.hpp>
 #include <iostream>
 
 SeedManager::SeedManager(ResourceManager &resManager, SunManager &sunManager,
-                         sf::Font &primaryFont, sf::Font &secondaryFont)
+                         const sf::Font &primaryFont, const sf::Font &secondaryFont)
     : m_hasActiveSelection(false),
       m_resourceManagerRef(resManager),
       m_sunManagerRef(sunManager),
@@ -25,13 +26,14 @@ void SeedManager::initializeSeedPackets()
 {
     m_seedPackets.clear();
 
-    addSeedPacket(PlantType::SUNFLOWER, SUNFLOWER_ICON_TEXTURE_KEY, SUNFLOWER_COST, SUNFLOWER_COOLDOWN_TIME);
-    addSeedPacket(PlantType::PEASHOOTER, PEASHOOTER_ICON_TEXTURE_KEY, PEASHOOTER_COST, PEASHOOTER_COOLDOWN_TIME);
-    addSeedPacket(PlantType::WALLNUT, WALLNUT_ICON_TEXTURE_KEY, WALLNUT_COST, WALLNUT_COOLDOWN_TIME);
-    addSeedPacket(PlantType::ICEPEASHOOTER, ICE_PEASHOOTER_ICON_TEXTURE_KEY, ICE_PEASHOOTER_COST, ICE_PEASHOOTER_COOLDOWN_TIME);
+    // 种子包顺序即植物描述表的顺序
+    for (const PlantDescriptor &descriptor : PLANT_DESCRIPTORS)
+    {
+        addSeedPacket(descriptor.type, descriptor.iconTextureKey, descriptor.cost, descriptor.cooldownTime);
+    }
 }
 
-void SeedManager::addSeedPacket(PlantType type, const std::string &textureKey, int cost, float cooldownTime)
+void SeedManager::addSeedPacket(PlantType type, ResourceId textureKey, int cost, float cooldownTime)
 {
     sf::Vector2f packetPosition(
         m_uiPosition.x + m_seedPackets.size() * (m_packetSize.x + m_packetSpacing),
@@ -135,7 +137,6 @@ int SeedManager::getSelectedPlantCost() const
 
 void SeedManager::notifyPlantPlaced(PlantType plantType)
 {
-
     for (auto &packet : m_seedPackets)
     {
         if (packet.getPlantType() == plantType)
@@ -144,7 +145,6 @@ void SeedManager::notifyPlantPlaced(PlantType plantType)
             break;
         }
     }
-    deselectAllPackets();
 }
 
 void SeedManager::selectSeedPacket(PlantType type)
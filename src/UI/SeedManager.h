@@ -17,20 +17,21 @@ class SeedManager
 {
 public:
     SeedManager(ResourceManager &resManager, SunManager &sunManager,
-                sf::Font &primaryFont, sf::Font &secondaryFont);
+                const sf::Font &primaryFont, const sf::Font &secondaryFont);
 
     bool handleEvent(const sf::Event &event, const sf::Vector2f &mousePosInView);
     void update(float dt);
     void draw(sf::RenderWindow &window) const;
 
     PlantType getSelectedPlantType(bool &isValidSelection) const;
+    // 模拟线程确认种植成功后开始该种子包的冷却
     void notifyPlantPlaced(PlantType plantType);
     int getSelectedPlantCost() const;
     void deselectAllPackets();
 
 private:
     void initializeSeedPackets();
-    void addSeedPacket(PlantType type, const std::string &textureKey, int cost, float cooldownTime);
+    void addSeedPacket(PlantType type, ResourceId textureKey, int cost, float cooldownTime);
     void selectSeedPacket(PlantType type);
 
     std::vector<SeedPacket> m_seedPackets;
@@ -39,8 +40,8 @@ private:
 
     ResourceManager &m_resourceManagerRef;
     SunManager &m_sunManagerRef;
-    sf::Font &m_primaryFontRef;
-    sf::Font &m_secondaryFontRef;
+    const sf::Font &m_primaryFontRef;
+    const sf::Font &m_secondaryFontRef;
 
     sf::Vector2f m_uiPosition;
     sf::Vector2f m_packetSize;
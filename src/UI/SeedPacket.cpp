@@ -1,17 +1,17 @@
 #include "SeedPacket.h"
 #include "../Core/ResourceManager.h"
 #include "../Utils/Constants.h"
-#include <iomanip>
-#include <sstream>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 
 SeedPacket::SeedPacket(PlantType type, int cost, float cooldownTime,
                        ResourceManager &resManager,
-                       const std::string &plantIconTextureKey,
-                       sf::Font &primaryFont, sf::Font &secondaryFont,
+                       ResourceId plantIconTextureKey,
+                       const sf::Font &primaryFont, const sf::Font &secondaryFont,
                        const sf::Vector2f &position, const sf::Vector2f &size)
     : m_plantType(type), m_cost(cost), m_cooldownTimeTotal(cooldownTime), m_currentCooldown(0.0f),
-      m_isExternallySelected(false),
+      m_displayedCooldownTenths(-1), m_isExternallySelected(false),
       m_resManagerRef(resManager), m_primaryFontRef(primaryFont), m_secondaryFontRef(secondaryFont),
       m_position(position), m_size(size)
 {
@@ -72,20 +72,29 @@ void SeedPacket::update(float dt, int currentSun, bool isExternallySelected)
         m_cooldownOverlay.setSize(sf::Vector2f(m_size.x, m_size.y * heightRatio));
         m_cooldownOverlay.setPosition(m_position.x, m_position.y);
 
-        // Update cooldown text (optional)
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(1) << m_currentCooldown;
-        m_cooldownText.setString(ss.str());
-        sf::FloatRect cdTextBounds = m_cooldownText.getLocalBounds();
-        m_cooldownText.setOrigin(cdTextBounds.left + cdTextBounds.width / 2.f,
-                                 cdTextBounds.top + cdTextBounds.height / 2.f);
-        m_cooldownText.setPosition(m_position.x + m_size.x / 2.f,
-                                   m_position.y + m_size.y / 2.f);
+        // 冷却文本精确到 0.1 秒, 显示值变化时才重建 (setString 会分配并重建字形顶点)
+        int tenths = static_cast<int>(std::lround(m_currentCooldown * 10.f));
+        if (tenths != m_displayedCooldownTenths)
+        {
+            m_displayedCooldownTenths = tenths;
+            char buffer[16];
+            std::snprintf(buffer, sizeof(buffer), "%d.%d", tenths / 10, tenths % 10);
+            m_cooldownText.setString(buffer);
+            sf::FloatRect cdTextBounds = m_cooldownText.getLocalBounds();
+            m_cooldownText.setOrigin(cdTextBounds.left + cdTextBounds.width / 2.f,
+                                     cdTextBounds.top + cdTextBounds.height / 2.f);
+            m_cooldownText.setPosition(m_position.x + m_size.x / 2.f,
+                                       m_position.y + m_size.y / 2.f);
+        }
     }
     else
     {
         m_cooldownOverlay.setSize(sf::Vector2f(0, 0));
-        m_cooldownText.setString("");
+        if (m_displayedCooldownTenths != -1)
+        {
+            m_displayedCooldownTenths = -1;
+            m_cooldownText.setString("");
+        }
     }
 
     updateAppearance(currentSun);
@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include "../Utils/ResourceId.h"
 #include "../Systems/PlantManager.h"
 
 class ResourceManager;
@@ -11,9 +12,9 @@ class SeedPacket
 public:
     SeedPacket(PlantType type, int cost, float cooldownTime,
                ResourceManager &resManager,
-               const std::string &plantIconTextureKey,
-               sf::Font &primaryFont,
-               sf::Font &secondaryFont,
+               ResourceId plantIconTextureKey,
+               const sf::Font &primaryFont,
+               const sf::Font &secondaryFont,
                const sf::Vector2f &position,
                const sf::Vector2f &size);
 
@@ -36,6 +37,8 @@ private:
     int m_cost;
     float m_cooldownTimeTotal;
     float m_currentCooldown;
+    // 冷却文本当前显示的值 (0.1 秒为单位), -1 表示不显示
+    int m_displayedCooldownTenths;
 
     bool m_isExternallySelected;
 
@@ -46,8 +49,8 @@ private:
     sf::Text m_cooldownText;
 
     ResourceManager &m_resManagerRef;
-    sf::Font &m_primaryFontRef;
-    sf::Font &m_secondaryFontRef;
+    const sf::Font &m_primaryFontRef;
+    const sf::Font &m_secondaryFontRef;
 
     sf::Vector2f m_position;
     sf::Vector2f m_size;
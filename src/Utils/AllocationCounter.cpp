@@ -0,0 +1,174 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // 每块内存前的头: 用户指针仍按默认 new 对齐
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocationHeader
+    {
+        std::size_t size;
+        AllocationTag tag;
+    };
+
+    struct TagCounters
+    {
+        std::atomic<std::uint64_t> allocations{0};
+        std::atomic<std::uint64_t> liveBytes{0};
+        std::atomic<std::uint64_t> peakBytes{0};
+    };
+
+    std::atomic<std::uint64_t> g_allocationCount{0};
+    std::atomic<std::uint64_t> g_allocatedBytes{0};
+    // 静态零初始化, 早于任何动态初始化中的分配
+    TagCounters g_tagCounters[AllocationCounter::TAG_COUNT];
+    thread_local AllocationTag g_currentTag = AllocationTag::UNTAGGED;
+
+    void *recordAllocation(void *headerAddress, std::size_t size)
+    {
+        AllocationHeader *header = static_cast<AllocationHeader *>(headerAddress);
+        header->size = size;
+        header->tag = g_currentTag;
+
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        TagCounters &counters = g_tagCounters[static_cast<std::size_t>(header->tag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        std::uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        return header + 1;
+    }
+
+    // 返回头的地址; 释放方可能是别的线程, 按头里记录的标签扣除
+    AllocationHeader *releaseAllocation(void *ptr)
+    {
+        AllocationHeader *header = static_cast<AllocationHeader *>(ptr) - 1;
+        g_tagCounters[static_cast<std::size_t>(header->tag)].liveBytes.fetch_sub(header->size, std::memory_order_relaxed);
+        return header;
+    }
+
+    // 超对齐分配时头之前要留出的空间, 保证用户指针满足 alignment
+    std::size_t alignedOffset(std::size_t alignment)
+    {
+        return alignment > sizeof(AllocationHeader) ? alignment : sizeof(AllocationHeader);
+    }
+
+    [[noreturn]] void throwBadAlloc()
+    {
+        throw std::bad_alloc();
+    }
+}
+
+std::uint64_t AllocationCounter::getTotalAllocations()
+{
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getTotalBytes()
+{
+    return g_allocatedBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getAllocations(AllocationTag tag)
+{
+    return g_tagCounters[static_cast<std::size_t>(tag)].allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getLiveBytes(AllocationTag tag)
+{
+    return g_tagCounters[static_cast<std::size_t>(tag)].liveBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getPeakBytes(AllocationTag tag)
+{
+    return g_tagCounters[static_cast<std::size_t>(tag)].peakBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::getTotalLiveBytes()
+{
+    std::uint64_t total = 0;
+    for (const TagCounters &counters : g_tagCounters)
+    {
+        total += counters.liveBytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+AllocationTag AllocationCounter::getCurrentTag()
+{
+    return g_currentTag;
+}
+
+void AllocationCounter::setCurrentTag(AllocationTag tag)
+{
+    g_currentTag = tag;
+}
+
+const char *AllocationCounter::getTagName(AllocationTag tag)
+{
+    static const char *const names[TAG_COUNT] = {
+        "other", "resources", "audio", "plants", "zombies", "projectiles", "suns", "ui", "states"};
+    std::size_t index = static_cast<std::size_t>(tag);
+    return index < TAG_COUNT ? names[index] : "?";
+}
+
+// 标准规定 new[]、nothrow 版本和对应的 delete 的默认实现都转调下面这几个, 只替换它们即可计入全部
+void *operator new(std::size_t size)
+{
+    for (;;)
+    {
+        void *raw = std::malloc(sizeof(AllocationHeader) + size);
+        if (raw)
+            return recordAllocation(raw, size);
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throwBadAlloc();
+        handler();
+    }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t offset = alignedOffset(align);
+    // aligned_alloc 要求大小是对齐的整数倍
+    std::size_t total = (offset + size + align - 1) / align * align;
+    for (;;)
+    {
+        void *raw = std::aligned_alloc(align, total);
+        if (raw)
+            return recordAllocation(static_cast<char *>(raw) + offset - sizeof(AllocationHeader), size);
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throwBadAlloc();
+        handler();
+    }
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (ptr)
+        std::free(releaseAllocation(ptr));
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept
+{
+    if (!ptr)
+        return;
+    releaseAllocation(ptr);
+    std::free(static_cast<char *>(ptr) - alignedOffset(static_cast<std::size_t>(alignment)));
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(ptr, alignment);
+}
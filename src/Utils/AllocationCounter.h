@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 分配归属的子系统; 当前标签是线程局部的, 由 AllocationScope 在调用入口处设置
+enum class AllocationTag : std::uint8_t
+{
+    UNTAGGED,
+    RESOURCES,   // 纹理/字体文件与对象
+    AUDIO,       // 音效样本、解码、混音器
+    PLANTS,
+    ZOMBIES,
+    PROJECTILES,
+    SUNS,
+    UI,
+    STATES,      // 游戏状态自身 (快照、回溯、联机、调试文本等)
+    COUNT
+};
+
+// 堆分配统计: 替换全局 operator new/delete, 每块内存前加一个小头记录大小和标签,
+// 释放时据此从所属标签的存活字节里扣除; 开销是每次分配几个 relaxed 原子操作, 发布版常开
+class AllocationCounter
+{
+public:
+    static constexpr std::size_t TAG_COUNT = static_cast<std::size_t>(AllocationTag::COUNT);
+
+    static std::uint64_t getTotalAllocations();
+    static std::uint64_t getTotalBytes();
+
+    // 按标签: 累计分配次数 / 当前存活字节 / 存活字节峰值
+    static std::uint64_t getAllocations(AllocationTag tag);
+    static std::uint64_t getLiveBytes(AllocationTag tag);
+    static std::uint64_t getPeakBytes(AllocationTag tag);
+    static std::uint64_t getTotalLiveBytes();
+
+    static AllocationTag getCurrentTag();
+    static const char *getTagName(AllocationTag tag);
+
+private:
+    friend class AllocationScope;
+    static void setCurrentTag(AllocationTag tag);
+};
+
+// 作用域内本线程的分配计入 tag, 退出时恢复之前的标签 (可嵌套)
+class AllocationScope
+{
+public:
+    explicit AllocationScope(AllocationTag tag) : m_previous(AllocationCounter::getCurrentTag())
+    {
+        AllocationCounter::setCurrentTag(tag);
+    }
+    ~AllocationScope() { AllocationCounter::setCurrentTag(m_previous); }
+
+    AllocationScope(const AllocationScope &) = delete;
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+private:
+    AllocationTag m_previous;
+};
@@ -0,0 +1,272 @@
+#include "AudioMixer.h"
+#include <algorithm>
+
+AudioMixer::AudioMixer()
+    : m_voices(AUDIO_MIXER_MAX_VOICES),
+      m_mixBuffer(AUDIO_MIXER_CHUNK_FRAMES * 2, 0.f),
+      m_outputBuffer(AUDIO_MIXER_CHUNK_FRAMES * 2, 0),
+      m_masterGain(1.f),
+      m_nextStartOrder(0),
+      m_activeVoiceCount(0),
+      m_stolenVoices(0),
+      m_rejectedPlays(0)
+{
+    m_categoryGains.fill(1.f);
+    // 输出固定为立体声; 片段采样率不同时在混音时按比例步进
+    initialize(2, AUDIO_MIXER_SAMPLE_RATE);
+}
+
+AudioMixer::~AudioMixer()
+{
+    // 必须在成员析构前停掉音频线程
+    stop();
+}
+
+std::unique_ptr<AudioClip> AudioMixer::createClip(const sf::Int16 *samples, std::size_t frameCount,
+                                                  unsigned int channelCount, unsigned int sampleRate,
+                                                  const SoundClipConfig &config)
+{
+    if (!samples || frameCount == 0 || channelCount == 0 || sampleRate == 0)
+        return nullptr;
+
+    auto clip = std::make_unique<AudioClip>();
+    clip->sampleRate = AUDIO_MIXER_SAMPLE_RATE;
+    clip->frameCount = static_cast<std::size_t>(
+        (static_cast<std::uint64_t>(frameCount) * AUDIO_MIXER_SAMPLE_RATE + sampleRate - 1) / sampleRate);
+    clip->config = config;
+    clip->config.maxVoices = std::max(1, config.maxVoices);
+    clip->samples.resize(clip->frameCount * 2);
+
+    // 单声道复制到两个声道, 多于两个声道只取前两个; 采样率不同时线性插值重采样
+    const float scale = 1.f / 32768.f;
+    const double sourceStep = static_cast<double>(sampleRate) / AUDIO_MIXER_SAMPLE_RATE;
+    unsigned int rightChannel = channelCount > 1 ? 1 : 0;
+    for (std::size_t frame = 0; frame < clip->frameCount; ++frame)
+    {
+        double position = frame * sourceStep;
+        std::size_t i0 = std::min(static_cast<std::size_t>(position), frameCount - 1);
+        std::size_t i1 = std::min(i0 + 1, frameCount - 1);
+        float t = static_cast<float>(position - static_cast<double>(i0));
+        const sf::Int16 *a = samples + i0 * channelCount;
+        const sf::Int16 *b = samples + i1 * channelCount;
+        clip->samples[frame * 2] = (a[0] + (b[0] - a[0]) * t) * scale;
+        clip->samples[frame * 2 + 1] = (a[rightChannel] + (b[rightChannel] - a[rightChannel]) * t) * scale;
+    }
+    return clip;
+}
+
+bool AudioMixer::playClip(const AudioClip &clip, float gain, float pitch, bool loop)
+{
+    Command command;
+    command.type = Command::Type::PLAY;
+    command.clip = &clip;
+    command.gain = gain;
+    command.pitch = pitch;
+    command.loop = loop;
+    if (!m_commands.push(command))
+    {
+        m_rejectedPlays.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool AudioMixer::stopAll()
+{
+    Command command;
+    command.type = Command::Type::STOP_ALL;
+    return m_commands.push(command);
+}
+
+bool AudioMixer::setCategoryGain(SoundCategory category, float gain)
+{
+    Command command;
+    command.type = Command::Type::SET_CATEGORY_GAIN;
+    command.category = category;
+    command.gain = gain;
+    return m_commands.push(command);
+}
+
+bool AudioMixer::setMasterGain(float gain)
+{
+    Command command;
+    command.type = Command::Type::SET_MASTER_GAIN;
+    command.gain = gain;
+    return m_commands.push(command);
+}
+
+bool AudioMixer::onGetData(Chunk &data)
+{
+    processCommands();
+
+    std::fill(m_mixBuffer.begin(), m_mixBuffer.end(), 0.f);
+    std::size_t active = 0;
+    for (Voice &voice : m_voices)
+    {
+        if (!voice.clip)
+            continue;
+        float gain = voice.gain * m_categoryGains[static_cast<std::size_t>(voice.clip->config.category)] * m_masterGain;
+        if (mixVoice(voice, gain, AUDIO_MIXER_CHUNK_FRAMES))
+            ++active;
+        else
+            voice.clip = nullptr;
+    }
+    m_activeVoiceCount.store(active, std::memory_order_relaxed);
+
+    // 限幅后转 16 位; 没有分支, 可以向量化
+    for (std::size_t i = 0; i < m_mixBuffer.size(); ++i)
+    {
+        float sample = std::clamp(m_mixBuffer[i], -1.f, 1.f);
+        m_outputBuffer[i] = static_cast<sf::Int16>(sample * 32767.f);
+    }
+
+    data.samples = m_outputBuffer.data();
+    data.sampleCount = m_outputBuffer.size();
+    // 混音器是无限流, 没有声部时输出静音
+    return true;
+}
+
+void AudioMixer::onSeek(sf::Time)
+{
+}
+
+void AudioMixer::processCommands()
+{
+    Command command;
+    while (m_commands.pop(command))
+    {
+        switch (command.type)
+        {
+        case Command::Type::PLAY:
+            startVoice(command);
+            break;
+        case Command::Type::STOP_ALL:
+            for (Voice &voice : m_voices)
+                voice.clip = nullptr;
+            break;
+        case Command::Type::SET_CATEGORY_GAIN:
+            if (command.category < SoundCategory::COUNT)
+                m_categoryGains[static_cast<std::size_t>(command.category)] = command.gain;
+            break;
+        case Command::Type::SET_MASTER_GAIN:
+            m_masterGain = command.gain;
+            break;
+        }
+    }
+}
+
+void AudioMixer::startVoice(const Command &command)
+{
+    Voice *voice = allocateVoice(*command.clip);
+    if (!voice)
+        return;
+    voice->clip = command.clip;
+    voice->frame = 0;
+    voice->fraction = 0.f;
+    voice->step = command.pitch * static_cast<float>(command.clip->sampleRate) / static_cast<float>(AUDIO_MIXER_SAMPLE_RATE);
+    voice->gain = command.gain;
+    voice->loop = command.loop;
+    voice->startOrder = m_nextStartOrder++;
+}
+
+AudioMixer::Voice *AudioMixer::allocateVoice(const AudioClip &clip)
+{
+    Voice *freeVoice = nullptr;
+    Voice *oldestSameClip = nullptr;
+    Voice *victim = nullptr;
+    int sameClipCount = 0;
+    for (Voice &voice : m_voices)
+    {
+        if (!voice.clip)
+        {
+            if (!freeVoice)
+                freeVoice = &voice;
+            continue;
+        }
+        if (voice.clip == &clip)
+        {
+            ++sameClipCount;
+            if (!oldestSameClip || voice.startOrder < oldestSameClip->startOrder)
+                oldestSameClip = &voice;
+        }
+        // 抢占候选: 优先级最低的, 同优先级取最早开始的
+        int priority = voice.clip->config.priority;
+        if (!victim || priority < victim->clip->config.priority ||
+            (priority == victim->clip->config.priority && voice.startOrder < victim->startOrder))
+        {
+            victim = &voice;
+        }
+    }
+
+    // 同一音效达到并发上限: 重启它最老的那个声部, 不占用新声部
+    if (sameClipCount >= clip.config.maxVoices)
+    {
+        m_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+        return oldestSameClip;
+    }
+    if (freeVoice)
+        return freeVoice;
+    if (victim && victim->clip->config.priority <= clip.config.priority)
+    {
+        m_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+        return victim;
+    }
+    m_rejectedPlays.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+bool AudioMixer::mixVoice(Voice &voice, float gain, std::size_t frames)
+{
+    const AudioClip &clip = *voice.clip;
+    const float *source = clip.samples.data();
+    float *out = m_mixBuffer.data();
+    std::size_t written = 0;
+
+    if (voice.step == 1.f && voice.fraction == 0.f)
+    {
+        // 原速播放: 按连续区段做乘加, 内层循环没有分支
+        while (written < frames)
+        {
+            std::size_t run = std::min(frames - written, clip.frameCount - voice.frame);
+            const float *in = source + voice.frame * 2;
+            float *dst = out + written * 2;
+            for (std::size_t i = 0; i < run * 2; ++i)
+            {
+                dst[i] += in[i] * gain;
+            }
+            written += run;
+            voice.frame += run;
+            if (voice.frame >= clip.frameCount)
+            {
+                if (!voice.loop)
+                    return false;
+                voice.frame = 0;
+            }
+        }
+        return true;
+    }
+
+    // 变速播放: 相邻两帧线性插值
+    for (; written < frames; ++written)
+    {
+        std::size_t next = voice.frame + 1;
+        if (next >= clip.frameCount)
+            next = voice.loop ? 0 : voice.frame;
+        const float *a = source + voice.frame * 2;
+        const float *b = source + next * 2;
+        out[written * 2] += (a[0] + (b[0] - a[0]) * voice.fraction) * gain;
+        out[written * 2 + 1] += (a[1] + (b[1] - a[1]) * voice.fraction) * gain;
+
+        voice.fraction += voice.step;
+        std::size_t advance = static_cast<std::size_t>(voice.fraction);
+        voice.frame += advance;
+        voice.fraction -= static_cast<float>(advance);
+        if (voice.frame >= clip.frameCount)
+        {
+            if (!voice.loop)
+                return false;
+            voice.frame %= clip.frameCount;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <SFML/Audio/SoundStream.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SpscQueue.h"
+#include "Constants.h"
+#include "SoundAsset.h"
+
+// 解码后的音效: 已重采样到混音器采样率的交错立体声浮点样本, 注册后只读, 音频线程直接引用
+struct AudioClip
+{
+    std::vector<float> samples;
+    std::size_t frameCount = 0;
+    unsigned int sampleRate = 0;
+    SoundClipConfig config;
+};
+
+// 软件混音器: 一个 sf::SoundStream (只占一个 OpenAL 源), 在音频线程上把所有声部混成一路
+// 声部只是 "片段指针 + 播放位置", 数量不受 OpenAL 源上限限制; 池满时按优先级抢占
+// 游戏线程通过无锁队列发命令, 音频线程在每次取数据前处理; 只允许一个线程发命令
+class AudioMixer : public sf::SoundStream
+{
+public:
+    AudioMixer();
+    ~AudioMixer() override;
+
+    AudioMixer(const AudioMixer &) = delete;
+    AudioMixer &operator=(const AudioMixer &) = delete;
+
+    // 把 16 位交错样本转换成混音器格式 (立体声浮点, AUDIO_MIXER_SAMPLE_RATE), 原速播放时走不插值的快速路径
+    // 不访问混音器状态, 可在解码线程上调用
+    static std::unique_ptr<AudioClip> createClip(const sf::Int16 *samples, std::size_t frameCount,
+                                                 unsigned int channelCount, unsigned int sampleRate,
+                                                 const SoundClipConfig &config);
+
+    // clip 必须比混音器活得久 (或在 stopAll 且混音器停止之后才释放)
+    // 命令队列满时丢弃并返回 false
+    bool playClip(const AudioClip &clip, float gain, float pitch, bool loop);
+    bool stopAll();
+    bool setCategoryGain(SoundCategory category, float gain);
+    bool setMasterGain(float gain);
+
+    std::size_t getActiveVoiceCount() const { return m_activeVoiceCount.load(std::memory_order_relaxed); }
+    std::uint64_t getStolenVoiceCount() const { return m_stolenVoices.load(std::memory_order_relaxed); }
+    std::uint64_t getRejectedPlayCount() const { return m_rejectedPlays.load(std::memory_order_relaxed); }
+
+private:
+    struct Command
+    {
+        enum class Type : std::uint8_t
+        {
+            PLAY,
+            STOP_ALL,
+            SET_CATEGORY_GAIN,
+            SET_MASTER_GAIN
+        };
+        Type type = Type::PLAY;
+        const AudioClip *clip = nullptr;
+        float gain = 1.f;
+        float pitch = 1.f;
+        bool loop = false;
+        SoundCategory category = SoundCategory::SFX;
+    };
+
+    struct Voice
+    {
+        const AudioClip *clip = nullptr; // nullptr 表示空闲
+        std::size_t frame = 0;
+        float fraction = 0.f;
+        float step = 1.f; // 每个输出帧前进的源帧数 (音高 × 采样率比)
+        float gain = 1.f;
+        bool loop = false;
+        std::uint64_t startOrder = 0;
+    };
+
+    bool onGetData(Chunk &data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+    // 以下只在音频线程上调用
+    void processCommands();
+    void startVoice(const Command &command);
+    Voice *allocateVoice(const AudioClip &clip);
+    // 返回 false 表示声部已播完
+    bool mixVoice(Voice &voice, float gain, std::size_t frames);
+
+    SpscQueue<Command, AUDIO_MIXER_COMMAND_QUEUE_CAPACITY> m_commands;
+
+    // 音频线程独占
+    std::vector<Voice> m_voices;
+    std::vector<float> m_mixBuffer;
+    std::vector<sf::Int16> m_outputBuffer;
+    std::array<float, static_cast<std::size_t>(SoundCategory::COUNT)> m_categoryGains;
+    float m_masterGain;
+    std::uint64_t m_nextStartOrder;
+
+    std::atomic<std::size_t> m_activeVoiceCount;
+    std::atomic<std::uint64_t> m_stolenVoices;
+    std::atomic<std::uint64_t> m_rejectedPlays;
+};
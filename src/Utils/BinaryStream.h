@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+#include "Fixed.h"
+
+// 紧凑二进制写入: 按本机字节序直接拷贝定长字段, 只用于本机存档/快照
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::vector<std::uint8_t> &buffer) : m_buffer(buffer) {}
+
+    template <typename T>
+    void write(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::write needs a trivially copyable type");
+        size_t offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(T));
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(T));
+    }
+
+    void writeBool(bool value) { write<std::uint8_t>(value ? 1 : 0); }
+    void writeVector(const sf::Vector2f &value)
+    {
+        write(value.x);
+        write(value.y);
+    }
+    // 定点数按原始整数保存
+    void writeFixed(Fixed value) { write<std::int32_t>(value.raw()); }
+    void writeFixedVector(const FixedVector2 &value)
+    {
+        writeFixed(value.x);
+        writeFixed(value.y);
+    }
+    // LEB128 变长无符号整数, 小数值只占 1 字节 (回溯缓冲的增量编码用)
+    void writeVarint(std::uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            m_buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        m_buffer.push_back(static_cast<std::uint8_t>(value));
+    }
+    void writeBytes(const std::uint8_t *data, size_t size)
+    {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+    size_t getSize() const { return m_buffer.size(); }
+
+private:
+    std::vector<std::uint8_t> &m_buffer;
+};
+
+// 对应的读取端, 越界时置失败标记并返回零值, 调用方最后检查 isOk()
+class BinaryReader
+{
+public:
+    BinaryReader(const std::uint8_t *data, size_t size) : m_data(data), m_size(size), m_offset(0), m_ok(true) {}
+    explicit BinaryReader(const std::vector<std::uint8_t> &buffer) : BinaryReader(buffer.data(), buffer.size()) {}
+
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::read needs a trivially copyable type");
+        T value{};
+        if (!m_ok || m_offset + sizeof(T) > m_size)
+        {
+            m_ok = false;
+            return value;
+        }
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+
+    bool readBool() { return read<std::uint8_t>() != 0; }
+    sf::Vector2f readVector()
+    {
+        float x = read<float>();
+        float y = read<float>();
+        return sf::Vector2f(x, y);
+    }
+    Fixed readFixed() { return Fixed::fromRaw(read<std::int32_t>()); }
+    FixedVector2 readFixedVector()
+    {
+        Fixed x = readFixed();
+        Fixed y = readFixed();
+        return FixedVector2(x, y);
+    }
+    std::uint32_t readVarint()
+    {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            std::uint8_t byte = read<std::uint8_t>();
+            if (!m_ok)
+                return 0;
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        m_ok = false;
+        return 0;
+    }
+    // 返回指向内部数据的指针, 越界时返回 nullptr
+    const std::uint8_t *readBytes(size_t size)
+    {
+        if (!m_ok || m_offset + size > m_size)
+        {
+            m_ok = false;
+            return nullptr;
+        }
+        const std::uint8_t *ptr = m_data + m_offset;
+        m_offset += size;
+        return ptr;
+    }
+
+    bool isOk() const { return m_ok; }
+    void fail() { m_ok = false; }
+    bool isAtEnd() const { return m_offset == m_size; }
+
+private:
+    const std::uint8_t *m_data;
+    size_t m_size;
+    size_t m_offset;
+    bool m_ok;
+};
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <SFML/System/Time.hpp> // For sf::Time
+#include "Fixed.h"
+#include "ResourceId.h"
 
 // --- Window & Game ---
 #define WINDOW_TITLE "JOSEPH'S OOP PROJECT"
@@ -9,7 +11,18 @@ const int WINDOW_WIDTH = 1200;
 const int WINDOW_HEIGHT = 700;
 const float TARGET_FPS = 60.0f;
 const sf::Time TIME_PER_FRAME = sf::seconds(1.f / TARGET_FPS);
+const Fixed SIM_TICK_DT = Fixed::fromRatio(1, static_cast<int>(TARGET_FPS)); // 模拟固定步长 (定点秒)
 const int TOTAL_WAVES_TO_WIN = 1;
+const sf::Time IDLE_WAIT_TIMEOUT = sf::milliseconds(250); // 空闲模式下单次等待事件的最长时间
+const sf::Time IDLE_POLL_SLICE = sf::milliseconds(10);    // 空闲模式下两次轮询之间的休眠
+const sf::Time LOOP_STATS_INTERVAL = sf::seconds(5.f);    // 主循环负载统计的输出周期
+
+// --- Frame pacing ---
+const int FRAME_PACING_SPIN_THRESHOLD_US = 2000;     // PRECISE 模式最后自旋等待的时长(微秒)
+const float FRAME_TIME_HISTOGRAM_BUCKET_MS = 0.25f;  // 帧间隔直方图桶宽
+const size_t FRAME_TIME_HISTOGRAM_BUCKETS = 200;     // 覆盖 0~50ms
+const float JITTER_HISTOGRAM_BUCKET_MS = 0.05f;      // 抖动直方图桶宽
+const size_t JITTER_HISTOGRAM_BUCKETS = 200;         // 覆盖 0~10ms
 
 // --- Grid ---
 const int GRID_ROWS = 5;
@@ -22,6 +35,14 @@ const int GRID_LINE_COLOR_R = 100;
 const int GRID_LINE_COLOR_G = 100;
 const int GRID_LINE_COLOR_B = 100;
 const int GRID_LINE_COLOR_A = 128;
+// 棋盘右侧/下方留白 (默认 5x9 棋盘时世界大小正好等于窗口)
+const float BOARD_RIGHT_MARGIN = WINDOW_WIDTH - (GRID_START_X + GRID_COLS * GRID_CELL_WIDTH);
+const float BOARD_BOTTOM_MARGIN = WINDOW_HEIGHT - (GRID_START_Y + GRID_ROWS * GRID_CELL_HEIGHT);
+
+// --- Camera ---
+const float CAMERA_PAN_SPEED = 600.f;     // 方向键平移速度 (像素/秒, 随缩放变化)
+const float CAMERA_MIN_ZOOM = 0.5f;       // 最大放大倍数对应的缩放系数
+const float CAMERA_ZOOM_STEP = 1.1f;      // 每格滚轮的缩放倍率
 
 // --- Sun ---
 const int INITIAL_SUN_AMOUNT = 150;
@@ -30,43 +51,110 @@ const float SKY_SUN_FALL_SPEED = 70.f;
 const float SKY_SUN_LIFESPAN_ON_GROUND = 8.0f;
 const float PLANT_SUN_LIFESPAN = 7.0f;
 const float SUN_COLLECT_RADIUS = 30.f; // 稍微增大点击半径
-const std::string SUN_TEXTURE_KEY = "sun_texture";
+constexpr ResourceId SUN_TEXTURE_KEY{"sun_texture"};
 const float PLANT_SUN_SPAWN_VELOCITY_Y = -90.f;
 const float PLANT_SUN_SPAWN_VELOCITY_X_MAX_OFFSET = 25.f;
 const float PLANT_SUN_GRAVITY = 280.f;
 const float PLANT_SUN_TARGET_Y_OFFSET = 25.f;
+const float SUN_PICK_CELL_SIZE = 64.f;    // 阳光点击拾取空间哈希的格子边长(像素)
+
+// --- Snapshot ---
+const unsigned int SNAPSHOT_MAGIC = 0x535A5650; // "PVZS"
+const unsigned short SNAPSHOT_VERSION = 3; // 2: 增加第二位玩家的阳光数; 3: 模拟状态改为定点数
+constexpr const char *QUICKSAVE_FILE_PATH = "quicksave.pvzs";
+
+// --- Rewind ---
+const int REWIND_CAPTURE_INTERVAL_TICKS = 6;             // 每隔几个模拟 tick 记录一次
+const int REWIND_KEYFRAME_INTERVAL = 30;                 // 每隔几次记录存一个完整关键帧, 其余为增量
+const float REWIND_MAX_SECONDS = 20.f;                   // 回溯窗口长度
+const size_t REWIND_MEMORY_BUDGET_BYTES = 4 * 1024 * 1024; // 回溯缓冲内存上限
+const int REWIND_SCRUB_TICKS_PER_UPDATE = 2;             // 按住回溯键时每帧倒退的 tick 数 (2 倍速)
+const float REWIND_PAUSE_MENU_SECONDS = 5.f;             // 暂停菜单 "Rewind" 按钮一次倒退的秒数
+
+// --- Co-op lockstep ---
+const int COOP_MAX_PLAYERS = 2;
+const unsigned int COOP_PROTOCOL_MAGIC = 0x50565A43; // "PVZC"
+const unsigned short COOP_PROTOCOL_VERSION = 2;
+const int COOP_DEFAULT_INPUT_DELAY_TICKS = 4;    // 本地操作延后几个 tick 生效, 留出网络传输时间
+const int COOP_MAX_TICKS_PER_PACKET = 64;        // 每个包最多重发多少个未确认的输入帧
+const int COOP_CHECKSUM_INTERVAL_TICKS = 30;     // 每隔几个 tick 交换一次状态校验和
+const float COOP_HELLO_RESEND_SECONDS = 0.25f;   // 客户端握手重发间隔
+const unsigned int COOP_START_CHUNK_BYTES = 1024; // 起始快照按块发送, 每块不超过一个不分片的 UDP 包
+const float COOP_TIMEOUT_SECONDS = 10.f;         // 超过该时间收不到对方的包视为断线
+
+// --- Spectator ---
+const float SPECTATOR_DEFAULT_RATE_HZ = 20.f;             // 默认每秒广播帧数
+const float SPECTATOR_POSITION_SCALE = 4.f;               // 坐标量化精度: 1/4 像素
+const size_t SPECTATOR_MAX_VIEWER_BACKLOG = 256 * 1024;   // 单个观众积压超过该字节数时丢弃积压并用完整帧重新同步
+const int SPECTATOR_THREAD_WAIT_MS = 5;                   // 网络线程每轮等待套接字的最长时间
+const float SPECTATOR_SNAP_DISTANCE = 200.f;              // 观众端插值: 两帧间位移超过该距离直接跳到新位置
+
+// --- Metrics ---
+const int METRICS_THREAD_WAIT_MS = 100;          // 指标服务线程每轮等待连接的最长时间
+const int METRICS_REQUEST_TIMEOUT_MS = 1000;     // 读取单个请求的超时
+const size_t METRICS_MAX_REQUEST_BYTES = 4096;   // 请求头长度上限
+
+// --- Simulation thread ---
+const int SIMULATION_MAX_CATCH_UP_STEPS = 5;          // 模拟线程落后时一次最多补的步数
+const size_t SIMULATION_INPUT_QUEUE_CAPACITY = 256;   // 主线程 -> 模拟线程的输入队列容量 (2 的幂)
+const size_t PARTICLE_REQUEST_QUEUE_CAPACITY = 1024;  // 模拟线程 -> 渲染线程的粒子请求队列容量 (2 的幂)
+const size_t SOUND_REQUEST_QUEUE_CAPACITY = 64;       // 模拟线程 -> 主线程的音效请求队列容量 (2 的幂)
+
+// --- Audio mixer ---
+const unsigned int AUDIO_MIXER_SAMPLE_RATE = 44100;
+const size_t AUDIO_MIXER_CHUNK_FRAMES = 512;          // 每次 onGetData 混出的帧数 (约 11.6ms)
+const size_t AUDIO_MIXER_MAX_VOICES = 256;            // 声部池大小, 满了按优先级抢占
+const size_t AUDIO_MIXER_COMMAND_QUEUE_CAPACITY = 256; // 游戏线程 -> 音频线程的命令队列容量 (2 的幂)
+const unsigned int SOUND_DECODE_WORKER_COUNT = 2;      // 音效后台解码线程数
+
+// --- ECS ---
+const size_t ECS_CHUNK_CAPACITY = 64; // 每个原型块容纳的实体数, 块内各组件按列连续存放
+
+// --- Arenas ---
+const size_t LEVEL_ARENA_BYTES = 1024 * 1024;     // 关卡内存区: 实体组件块, exit/重开时整体归还
+const size_t SIMULATION_TICK_ARENA_BYTES = 16 * 1024; // 模拟线程每 tick 的临时内存 (统计文本等)
+const size_t FRAME_ARENA_BYTES = 16 * 1024;       // 主线程每帧的临时内存 (调试文本等)
+const sf::Time DEBUG_TEXT_REFRESH_INTERVAL = sf::seconds(0.25f); // 调试文本刷新周期, setString 会重建顶点
+
+// --- Memory accounting ---
+const size_t MEMORY_BASELINE_TOLERANCE_BYTES = 256 * 1024; // 浸泡测试: 每个标签允许高出开局基线的字节数 (容器保留的容量)
+const int MEMORY_CHECK_FAILED_EXIT_CODE = 2;
+
+// --- Particles ---
+const int PARTICLE_POOL_CAPACITY = 32768;  // 每个纹理批次的粒子池容量 (固定, 不扩容)
+const int PARTICLE_STRESS_BURST = 20000;   // F3 压力测试一次发射的粒子数
 
 // --- Plants ---
 // Sunflower
 const int SUNFLOWER_HEALTH = 80;
 const int SUNFLOWER_COST = 50;
-const float SUNFLOWER_COOLDOWN_TIME = 7.5f;
-const float SUNFLOWER_SUN_PRODUCTION_INTERVAL = 10.0f; // 向日葵生产阳光间隔
-const std::string SUNFLOWER_TEXTURE_KEY = "sunflower";
-const std::string SUNFLOWER_ICON_TEXTURE_KEY = "sunflower_icon";
+constexpr float SUNFLOWER_COOLDOWN_TIME = 7.5f;
+constexpr float SUNFLOWER_SUN_PRODUCTION_INTERVAL = 10.0f; // 向日葵生产阳光间隔
+constexpr ResourceId SUNFLOWER_TEXTURE_KEY{"sunflower"};
+constexpr ResourceId SUNFLOWER_ICON_TEXTURE_KEY{"sunflower_icon"};
 
 // Peashooter
 const int PEASHOOTER_HEALTH = 100;
 const int PEASHOOTER_COST = 100;
-const float PEASHOOTER_COOLDOWN_TIME = 7.5f;
-const std::string PEASHOOTER_TEXTURE_KEY = "peashooter";
-const std::string PEASHOOTER_ICON_TEXTURE_KEY = "peashooter_icon";
-const float PEASHOOTER_SHOOT_INTERVAL = 1.4f; // 豌豆射手两次射击之间的间隔时间 (秒)
+constexpr float PEASHOOTER_COOLDOWN_TIME = 7.5f;
+constexpr ResourceId PEASHOOTER_TEXTURE_KEY{"peashooter"};
+constexpr ResourceId PEASHOOTER_ICON_TEXTURE_KEY{"peashooter_icon"};
+constexpr float PEASHOOTER_SHOOT_INTERVAL = 1.4f; // 豌豆射手两次射击之间的间隔时间 (秒)
 
 // Wall-nut
 const int WALLNUT_HEALTH = 2000;
 const int WALLNUT_COST = 75;
-const float WALLNUT_COOLDOWN_TIME = 20.0f;                 // 坚果墙冷却时间通常较长
-const std::string WALLNUT_TEXTURE_KEY = "wallnut_texture"; // 确保与加载时一致
-const std::string WALLNUT_ICON_TEXTURE_KEY = "wallnut_icon";
+constexpr float WALLNUT_COOLDOWN_TIME = 20.0f;                 // 坚果墙冷却时间通常较长
+constexpr ResourceId WALLNUT_TEXTURE_KEY{"wallnut_texture"}; // 确保与加载时一致
+constexpr ResourceId WALLNUT_ICON_TEXTURE_KEY{"wallnut_icon"};
 
 // Ice Peashooter
 const int ICE_PEASHOOTER_HEALTH = 100;
 const int ICE_PEASHOOTER_COST = 175;
-const float ICE_PEASHOOTER_COOLDOWN_TIME = 7.5f;
-const std::string ICE_PEASHOOTER_TEXTURE_KEY = "ice_peashooter_texture";
-const std::string ICE_PEASHOOTER_ICON_TEXTURE_KEY = "ice_peashooter_icon";
-const float ICE_PEASHOOTER_SHOOT_INTERVAL = 2.0f;
+constexpr float ICE_PEASHOOTER_COOLDOWN_TIME = 7.5f;
+constexpr ResourceId ICE_PEASHOOTER_TEXTURE_KEY{"ice_peashooter_texture"};
+constexpr ResourceId ICE_PEASHOOTER_ICON_TEXTURE_KEY{"ice_peashooter_icon"};
+constexpr float ICE_PEASHOOTER_SHOOT_INTERVAL = 2.0f;
 
 // --- UI: SeedManager (Seed Packet Bar) & SeedPackets ---
 const float SEED_PACKET_UI_START_X = 20.f;
@@ -74,8 +162,8 @@ const float SEED_PACKET_UI_START_Y = 10.f;
 const float SEED_PACKET_WIDTH = 65.f;
 const float SEED_PACKET_HEIGHT = 90.f;
 const float SEED_PACKET_SPACING = 8.f;
-const unsigned int SEED_PACKET_COST_FONT_SIZE = 16;
-const unsigned int SEED_PACKET_COOLDOWN_FONT_SIZE = 14;
+constexpr unsigned int SEED_PACKET_COST_FONT_SIZE = 16;
+constexpr unsigned int SEED_PACKET_COOLDOWN_FONT_SIZE = 14;
 const float SEED_PACKET_ICON_SCALE_FACTOR = 0.75f; // 图标缩放比例
 const float SEED_PACKET_COOLDOWN_OVERLAY_ALPHA = 170.f;
 
@@ -84,35 +172,72 @@ const float SEED_PACKET_COOLDOWN_OVERLAY_ALPHA = 170.f;
 const int APPROX_NUM_SEED_PACKETS_DISPLAYED = 7; // 大约会显示多少个种子包
 const float SUN_DISPLAY_X = SEED_PACKET_UI_START_X + (APPROX_NUM_SEED_PACKETS_DISPLAYED * (SEED_PACKET_WIDTH + SEED_PACKET_SPACING)) + 30.f;
 const float SUN_DISPLAY_Y = SEED_PACKET_UI_START_Y + 15.f;
-const unsigned int SUN_DISPLAY_FONT_SIZE = 24;
-const std::string SUN_ICON_HUD_TEXTURE_KEY = "sun_icon_hud"; // HUD上阳光图标的键名
+constexpr unsigned int SUN_DISPLAY_FONT_SIZE = 24;
+constexpr ResourceId SUN_ICON_HUD_TEXTURE_KEY{"sun_icon_hud"}; // HUD上阳光图标的键名
 
-const std::string SHOVEL_TEXTURE_KEY = "shovel_icon";
-const std::string SHOVEL_CURSOR_TEXTURE_KEY = "shovel_cursor";
+constexpr ResourceId SHOVEL_TEXTURE_KEY{"shovel_icon"};
+constexpr ResourceId SHOVEL_CURSOR_TEXTURE_KEY{"shovel_cursor"};
 
 // --- Fonts ---
-const std::string FONT_PATH_ARIAL = "C:/Windows/Fonts/arial.ttf";     // Windows默认
-const std::string FONT_PATH_VERDANA = "C:/Windows/Fonts/verdana.ttf"; // 另一个Windows默认
+constexpr const char *FONT_PATH_ARIAL = "C:/Windows/Fonts/arial.ttf";     // Windows默认
+constexpr const char *FONT_PATH_VERDANA = "C:/Windows/Fonts/verdana.ttf"; // 另一个Windows默认
 // 推荐：将字体文件放在 assets/fonts/ 目录下，并使用相对路径
-const std::string FONT_PATH_MAIN = "";
-const std::string FONT_PATH_PRIMARY_ASSET = "../../assets/fonts/BAUHS93.ttf";
-const std::string FONT_PATH_SECONDARY_ASSET = "../../assets/fonts/testtype.ttf";
+constexpr const char *FONT_PATH_MAIN = "";
+constexpr const char *FONT_PATH_PRIMARY_ASSET = "../../assets/fonts/BAUHS93.ttf";
+constexpr const char *FONT_PATH_SECONDARY_ASSET = "../../assets/fonts/testtype.ttf";
+
+constexpr ResourceId FONT_ID_PRIMARY{"font_primary"};
+constexpr ResourceId FONT_ID_SECONDARY{"font_secondary"};
+
+// --- UI 字号与描边 ---
+constexpr unsigned int BUTTON_FONT_SIZE = 24;
+constexpr unsigned int WAVE_PROGRESS_FONT_SIZE = 12;
+constexpr unsigned int TOTAL_WAVES_FONT_SIZE = 14;
+constexpr unsigned int DEBUG_TEXT_FONT_SIZE = 14;
+constexpr unsigned int TITLE_FONT_SIZE = 60; // 主菜单与暂停标题
+constexpr unsigned int GAME_OVER_TITLE_FONT_SIZE = 72;
+constexpr unsigned int VICTORY_TITLE_FONT_SIZE = 80;
+constexpr unsigned int VICTORY_SUBTITLE_FONT_SIZE = 36;
+constexpr float SUN_DISPLAY_OUTLINE_THICKNESS = 1.f;
+constexpr float PAUSE_TITLE_OUTLINE_THICKNESS = 2.f;
+constexpr float GAME_OVER_TITLE_OUTLINE_THICKNESS = 2.f;
+constexpr float VICTORY_TITLE_OUTLINE_THICKNESS = 3.f;
+
+// 字形预热: 加载时按这些 (字号, 描边) 光栅化全部可打印 ASCII, 避免文字首次出现时卡顿
+// 带描边的文本会同时用到描边字形和填充字形, 两种都要列出; 新增文本样式时在这里补一行
+struct GlyphStyle
+{
+    unsigned int characterSize;
+    float outlineThickness;
+};
 
-const std::string FONT_ID_PRIMARY = "font_primary";
-const std::string FONT_ID_SECONDARY = "font_secondary";
+constexpr GlyphStyle UI_GLYPH_STYLES[] = {
+    {WAVE_PROGRESS_FONT_SIZE, 0.f},
+    {SEED_PACKET_COOLDOWN_FONT_SIZE, 0.f}, // 与总波数, 调试文本同字号
+    {SEED_PACKET_COST_FONT_SIZE, 0.f},
+    {SUN_DISPLAY_FONT_SIZE, 0.f}, // 与按钮同字号
+    {SUN_DISPLAY_FONT_SIZE, SUN_DISPLAY_OUTLINE_THICKNESS},
+    {VICTORY_SUBTITLE_FONT_SIZE, 0.f},
+    {TITLE_FONT_SIZE, 0.f},
+    {TITLE_FONT_SIZE, PAUSE_TITLE_OUTLINE_THICKNESS},
+    {GAME_OVER_TITLE_FONT_SIZE, 0.f},
+    {GAME_OVER_TITLE_FONT_SIZE, GAME_OVER_TITLE_OUTLINE_THICKNESS},
+    {VICTORY_TITLE_FONT_SIZE, 0.f},
+    {VICTORY_TITLE_FONT_SIZE, VICTORY_TITLE_OUTLINE_THICKNESS},
+};
 
 // --- 子弹 (Projectiles) ---
 // **豌豆 (Pea)**
 const float PEA_SPEED = 350.f;
 const int PEA_DAMAGE = 25;
-const std::string PEA_TEXTURE_KEY = "pea_projectile";
+constexpr ResourceId PEA_TEXTURE_KEY{"pea_projectile"};
 const float PEA_VISUAL_WIDTH = 13.f;
 const float PEA_VISUAL_HEIGHT = 13.f;
 const float PEA_LIFESPAN_SECONDS = 3.0f;
 // **寒冰豌豆 (Ice Pea)** - 新增
 const float ICE_PEA_SPEED = 300.f;
 const int ICE_PEA_DAMAGE = 25;
-const std::string ICE_PEA_TEXTURE_KEY = "ice_pea_projectile";
+constexpr ResourceId ICE_PEA_TEXTURE_KEY{"ice_pea_projectile"};
 const float ICE_PEA_VISUAL_WIDTH = 15.f;
 const float ICE_PEA_VISUAL_HEIGHT = 15.f;
 const float ICE_PEA_LIFESPAN_SECONDS = 3.0f;
@@ -123,36 +248,38 @@ const float ZOMBIE_SLOW_FACTOR = 0.5f;
 const float ZOMBIE_ATTACK_RANGE = 5.f;
 // 普通僵尸 (Basic Zombie)
 const int BASIC_ZOMBIE_HEALTH = 150;
-const float BASIC_ZOMBIE_SPEED = 30.f;
+constexpr float BASIC_ZOMBIE_SPEED = 30.f;
 const int BASIC_ZOMBIE_DAMAGE_PER_ATTACK = 30;
-const float BASIC_ZOMBIE_ATTACK_INTERVAL = 1.0f;
-const std::string BASIC_ZOMBIE_TEXTURE_KEY = "basic_zombie";
+constexpr float BASIC_ZOMBIE_ATTACK_INTERVAL = 1.0f;
+constexpr ResourceId BASIC_ZOMBIE_TEXTURE_KEY{"basic_zombie"};
 
 // 大僵尸 (Big Zombie)
 const int BIG_ZOMBIE_HEALTH = 300;
-const float BIG_ZOMBIE_SPEED = 20.f;
+constexpr float BIG_ZOMBIE_SPEED = 20.f;
 const int BIG_ZOMBIE_DAMAGE_PER_ATTACK = 20;
-const float BIG_ZOMBIE_ATTACK_INTERVAL = 1.0f;
-const std::string BIG_ZOMBIE_TEXTURE_KEY = "big_zombie";
+constexpr float BIG_ZOMBIE_ATTACK_INTERVAL = 1.0f;
+constexpr ResourceId BIG_ZOMBIE_TEXTURE_KEY{"big_zombie"};
 
 // 巨人僵尸 (Boss Zombie)
 const int BOSS_ZOMBIE_HEALTH = 400;
-const float BOSS_ZOMBIE_SPEED = 30.f;
+constexpr float BOSS_ZOMBIE_SPEED = 30.f;
 const int BOSS_ZOMBIE_DAMAGE_PER_ATTACK = 100;
-const float BOSS_ZOMBIE_ATTACK_INTERVAL = 1.0f;
-const std::string BOSS_ZOMBIE_TEXTURE_KEY = "boss_zombie";
+constexpr float BOSS_ZOMBIE_ATTACK_INTERVAL = 1.0f;
+constexpr ResourceId BOSS_ZOMBIE_TEXTURE_KEY{"boss_zombie"};
 
 // 小僵尸 (quick Zombie)
 const int QUICK_ZOMBIE_HEALTH = 100;
-const float QUICK_ZOMBIE_SPEED = 50.f;
+constexpr float QUICK_ZOMBIE_SPEED = 50.f;
 const int QUICK_ZOMBIE_DAMAGE_PER_ATTACK = 15;
-const float QUICK_ZOMBIE_ATTACK_INTERVAL = 0.9f;
-const std::string QUICK_ZOMBIE_TEXTURE_KEY = "quick_zombie";
+constexpr float QUICK_ZOMBIE_ATTACK_INTERVAL = 0.9f;
+constexpr ResourceId QUICK_ZOMBIE_TEXTURE_KEY{"quick_zombie"};
 
 // 僵尸生成相关
 const float ZOMBIE_SPAWN_START_X_OFFSET = 50.f;
 const float ZOMBIE_REACHED_HOUSE_X = 180.f;
 
 // 背景音乐
-const std::string BGM_GAMEPLAY = "bgm_gameplay_main";
-const std::string SFX_PEASHOOT = "sfx_peashoot";
\ No newline at end of file
+constexpr ResourceId BGM_GAMEPLAY{"bgm_gameplay_main"};
+constexpr ResourceId SFX_PEASHOOT{"sfx_peashoot"};
+constexpr ResourceId SFX_ZOMBIE_DIE{"sfx_zombie_die"};
+constexpr ResourceId SFX_SUN_PICKUP{"sfx_sun_pickup"};
\ No newline at end of file
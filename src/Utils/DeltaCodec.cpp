@@ -0,0 +1,88 @@
+#include "DeltaCodec.h"
+#include "BinaryStream.h"
+
+namespace
+{
+    // 字面段里连续出现这么多个相同字节才切回零段, 避免小段来回切换的 varint 开销
+    const size_t MIN_ZERO_RUN_TO_SPLIT = 4;
+
+    inline std::uint8_t baseByte(const std::vector<std::uint8_t> &base, size_t index)
+    {
+        return index < base.size() ? base[index] : 0;
+    }
+}
+
+void DeltaCodec::encode(const std::vector<std::uint8_t> &base, const std::vector<std::uint8_t> &current,
+                        std::vector<std::uint8_t> &out)
+{
+    BinaryWriter writer(out);
+    const size_t size = current.size();
+    writer.writeVarint(static_cast<std::uint32_t>(size));
+
+    size_t i = 0;
+    while (i < size)
+    {
+        // 零段: 与 base 相同的字节
+        size_t zeroStart = i;
+        while (i < size && current[i] == baseByte(base, i))
+            i++;
+        size_t zeroRun = i - zeroStart;
+
+        // 字面段: 直到遇到足够长 (或延伸到末尾) 的相同段为止, 短的相同段并入字面段
+        size_t literalStart = i;
+        size_t literalEnd = i;
+        while (i < size)
+        {
+            if (current[i] != baseByte(base, i))
+            {
+                literalEnd = ++i;
+                continue;
+            }
+            size_t runEnd = i;
+            while (runEnd < size && runEnd - i < MIN_ZERO_RUN_TO_SPLIT && current[runEnd] == baseByte(base, runEnd))
+                runEnd++;
+            if (runEnd - i >= MIN_ZERO_RUN_TO_SPLIT || runEnd == size)
+                break;
+            literalEnd = i = runEnd;
+        }
+        i = literalEnd;
+
+        writer.writeVarint(static_cast<std::uint32_t>(zeroRun));
+        writer.writeVarint(static_cast<std::uint32_t>(literalEnd - literalStart));
+        for (size_t j = literalStart; j < literalEnd; ++j)
+        {
+            out.push_back(static_cast<std::uint8_t>(current[j] ^ baseByte(base, j)));
+        }
+    }
+}
+
+bool DeltaCodec::decode(const std::vector<std::uint8_t> &base, const std::vector<std::uint8_t> &delta,
+                        std::vector<std::uint8_t> &out)
+{
+    BinaryReader reader(delta);
+    const size_t size = reader.readVarint();
+    if (!reader.isOk())
+        return false;
+    out.resize(size);
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t zeroRun = reader.readVarint();
+        size_t literalRun = reader.readVarint();
+        if (!reader.isOk() || pos + zeroRun + literalRun > size || zeroRun + literalRun == 0)
+            return false;
+        for (size_t j = 0; j < zeroRun; ++j, ++pos)
+        {
+            out[pos] = baseByte(base, pos);
+        }
+        const std::uint8_t *literal = reader.readBytes(literalRun);
+        if (!literal)
+            return false;
+        for (size_t j = 0; j < literalRun; ++j, ++pos)
+        {
+            out[pos] = static_cast<std::uint8_t>(literal[j] ^ baseByte(base, pos));
+        }
+    }
+    return reader.isAtEnd();
+}
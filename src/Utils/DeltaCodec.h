@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// 字节级差分编码: current 与 base 逐字节 XOR, 输出为 varint 长度的 "零段/字面段" 序列
+// 两份数据大部分相同时 (相邻快照、相邻广播帧) 结果很小; base 比 current 短时按 0 补齐
+class DeltaCodec
+{
+public:
+    // 结果追加到 out 末尾
+    static void encode(const std::vector<std::uint8_t> &base, const std::vector<std::uint8_t> &current,
+                       std::vector<std::uint8_t> &out);
+    static bool decode(const std::vector<std::uint8_t> &base, const std::vector<std::uint8_t> &delta,
+                       std::vector<std::uint8_t> &out);
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <compare>
+#include <cstdint>
+
+// Q16.16 定点数: 模拟状态 (位置、速度、计时器) 统一使用, 运算只有整数加减乘除和移位,
+// 结果不受编译器和优化选项 (-ffast-math、FMA 合并、x87 扩展精度) 影响, 回放和联机锁步逐位一致
+// float 只出现在两个方向: 常量/配置进入模拟时 fromFloat (乘 2^16 后四舍五入, 精确且确定), 绘制时 toFloat
+// 取值范围约 ±32767, 精度 1/65536
+class Fixed
+{
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr std::int32_t ONE_RAW = 1 << FRACTION_BITS;
+
+    constexpr Fixed() : m_raw(0) {}
+    constexpr Fixed(int value) : m_raw(value * ONE_RAW) {}
+    // 禁止隐式从浮点构造 (会被截断成整数), 必须显式写 fromFloat
+    Fixed(float) = delete;
+    Fixed(double) = delete;
+
+    static constexpr Fixed fromRaw(std::int32_t raw)
+    {
+        Fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+    // 先转 double 再放大: 乘 2 的幂和 +0.5 在 double 中都是精确的, 不依赖 libm 的舍入模式
+    static constexpr Fixed fromFloat(float value)
+    {
+        double scaled = static_cast<double>(value) * ONE_RAW;
+        return fromRaw(static_cast<std::int32_t>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5));
+    }
+    // 分数 numerator / denominator, 用于 1/60 秒这类无法由 float 常量精确给出的值
+    static constexpr Fixed fromRatio(std::int32_t numerator, std::int32_t denominator)
+    {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(numerator) << FRACTION_BITS) / denominator));
+    }
+
+    constexpr std::int32_t raw() const { return m_raw; }
+    constexpr float toFloat() const { return static_cast<float>(m_raw) / ONE_RAW; }
+    // 向下取整 / 向零取整 (与 static_cast<int> 一致)
+    constexpr int floorToInt() const { return m_raw >> FRACTION_BITS; }
+    constexpr int truncToInt() const { return m_raw / ONE_RAW; }
+
+    constexpr Fixed operator-() const { return fromRaw(-m_raw); }
+    constexpr Fixed operator+(Fixed other) const { return fromRaw(m_raw + other.m_raw); }
+    constexpr Fixed operator-(Fixed other) const { return fromRaw(m_raw - other.m_raw); }
+    // 乘除用 64 位中间值, 结果向负无穷截断
+    constexpr Fixed operator*(Fixed other) const
+    {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(m_raw) * other.m_raw) >> FRACTION_BITS));
+    }
+    constexpr Fixed operator/(Fixed other) const
+    {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(m_raw) << FRACTION_BITS) / other.m_raw));
+    }
+    constexpr Fixed operator*(int factor) const { return fromRaw(m_raw * factor); }
+    constexpr Fixed operator/(int divisor) const { return fromRaw(m_raw / divisor); }
+
+    constexpr Fixed &operator+=(Fixed other) { m_raw += other.m_raw; return *this; }
+    constexpr Fixed &operator-=(Fixed other) { m_raw -= other.m_raw; return *this; }
+    constexpr Fixed &operator*=(Fixed other) { return *this = *this * other; }
+
+    constexpr bool operator==(const Fixed &other) const = default;
+    constexpr auto operator<=>(const Fixed &other) const = default;
+
+    static constexpr Fixed abs(Fixed value) { return value.m_raw < 0 ? -value : value; }
+    static constexpr Fixed min(Fixed a, Fixed b) { return b < a ? b : a; }
+    static constexpr Fixed max(Fixed a, Fixed b) { return a < b ? b : a; }
+    static constexpr Fixed clamp(Fixed value, Fixed low, Fixed high) { return max(low, min(value, high)); }
+
+private:
+    std::int32_t m_raw;
+};
+
+// 模拟坐标/速度
+struct FixedVector2
+{
+    Fixed x;
+    Fixed y;
+
+    constexpr FixedVector2() = default;
+    constexpr FixedVector2(Fixed xValue, Fixed yValue) : x(xValue), y(yValue) {}
+
+    static FixedVector2 fromVector(const sf::Vector2f &value)
+    {
+        return FixedVector2(Fixed::fromFloat(value.x), Fixed::fromFloat(value.y));
+    }
+    sf::Vector2f toVector2f() const { return sf::Vector2f(x.toFloat(), y.toFloat()); }
+
+    constexpr FixedVector2 operator+(const FixedVector2 &other) const { return FixedVector2(x + other.x, y + other.y); }
+    constexpr FixedVector2 operator-(const FixedVector2 &other) const { return FixedVector2(x - other.x, y - other.y); }
+    constexpr FixedVector2 operator*(Fixed factor) const { return FixedVector2(x * factor, y * factor); }
+    constexpr FixedVector2 &operator+=(const FixedVector2 &other)
+    {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
+    constexpr bool operator==(const FixedVector2 &other) const = default;
+};
+
+// 模拟包围盒 (轴对齐)
+struct FixedRect
+{
+    Fixed left;
+    Fixed top;
+    Fixed width;
+    Fixed height;
+
+    constexpr Fixed getRight() const { return left + width; }
+    constexpr Fixed getBottom() const { return top + height; }
+
+    // 与 sf::Rect 一致: 右/下边界开区间
+    constexpr bool contains(const FixedVector2 &point) const
+    {
+        return point.x >= left && point.x < getRight() && point.y >= top && point.y < getBottom();
+    }
+    constexpr bool intersects(const FixedRect &other) const
+    {
+        return left < other.getRight() && other.left < getRight() && top < other.getBottom() && other.top < getBottom();
+    }
+
+    static FixedRect fromRect(const sf::FloatRect &rect)
+    {
+        return FixedRect{Fixed::fromFloat(rect.left), Fixed::fromFloat(rect.top), Fixed::fromFloat(rect.width), Fixed::fromFloat(rect.height)};
+    }
+    sf::FloatRect toFloatRect() const
+    {
+        return sf::FloatRect(left.toFloat(), top.toFloat(), width.toFloat(), height.toFloat());
+    }
+};
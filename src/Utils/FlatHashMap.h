@@ -0,0 +1,137 @@
+#pragma once
+
+#include "ResourceId.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 以 ResourceId 为键的开放寻址哈希表: 线性探测, 容量为 2 的幂, 负载超过一半时翻倍
+// 槽位连续存放, 查找只比较 64 位哈希; 扩容会移动 Value, 需要稳定地址的资源请存 unique_ptr
+template <typename Value>
+class FlatHashMap
+{
+public:
+    Value *find(ResourceId id)
+    {
+        std::size_t slot = findSlot(id);
+        return slot != NOT_FOUND ? &m_slots[slot].value : nullptr;
+    }
+
+    const Value *find(ResourceId id) const
+    {
+        std::size_t slot = findSlot(id);
+        return slot != NOT_FOUND ? &m_slots[slot].value : nullptr;
+    }
+
+    bool contains(ResourceId id) const { return findSlot(id) != NOT_FOUND; }
+
+    // 表中已有哈希相同、名字不同的键时返回 true, 并通过 existing 给出那个键
+    bool collides(ResourceId id, ResourceId *existing = nullptr) const
+    {
+        std::size_t slot = findSlot(id);
+        if (slot == NOT_FOUND || !m_slots[slot].key.collidesWith(id))
+            return false;
+        if (existing)
+            *existing = m_slots[slot].key;
+        return true;
+    }
+
+    // 插入或覆盖同名条目; 键无效或发生哈希冲突时不做修改, 返回 nullptr
+    Value *insertOrAssign(ResourceId id, Value value)
+    {
+        if (!id.isValid() || collides(id))
+            return nullptr;
+        if ((m_size + 1) * 2 > m_slots.size())
+            grow();
+
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t index = static_cast<std::size_t>(id.value()) & mask;
+        while (m_slots[index].key.isValid() && m_slots[index].key != id)
+            index = (index + 1) & mask;
+
+        Slot &slot = m_slots[index];
+        if (!slot.key.isValid())
+        {
+            slot.key = id;
+            ++m_size;
+        }
+        slot.value = std::move(value);
+        return &slot.value;
+    }
+
+    // 删除后把同一探测链上后面的元素前移 (backward shift), 不留墓碑
+    bool erase(ResourceId id)
+    {
+        std::size_t hole = findSlot(id);
+        if (hole == NOT_FOUND)
+            return false;
+
+        std::size_t mask = m_slots.size() - 1;
+        for (std::size_t next = (hole + 1) & mask; m_slots[next].key.isValid(); next = (next + 1) & mask)
+        {
+            std::size_t home = static_cast<std::size_t>(m_slots[next].key.value()) & mask;
+            // hole 落在 [home, next) 之间时, next 上的元素可以前移到 hole
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                m_slots[hole] = std::move(m_slots[next]);
+                hole = next;
+            }
+        }
+        m_slots[hole] = Slot{};
+        --m_size;
+        return true;
+    }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+    }
+
+private:
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+    static constexpr std::size_t INITIAL_CAPACITY = 16;
+
+    struct Slot
+    {
+        ResourceId key; // 无效键表示空槽
+        Value value{};
+    };
+
+    std::size_t findSlot(ResourceId id) const
+    {
+        if (m_slots.empty() || !id.isValid())
+            return NOT_FOUND;
+        std::size_t mask = m_slots.size() - 1;
+        for (std::size_t index = static_cast<std::size_t>(id.value()) & mask;; index = (index + 1) & mask)
+        {
+            const Slot &slot = m_slots[index];
+            if (!slot.key.isValid())
+                return NOT_FOUND;
+            if (slot.key == id)
+                return index;
+        }
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old = std::move(m_slots);
+        m_slots = std::vector<Slot>(old.empty() ? INITIAL_CAPACITY : old.size() * 2);
+        std::size_t mask = m_slots.size() - 1;
+        for (Slot &slot : old)
+        {
+            if (!slot.key.isValid())
+                continue;
+            std::size_t index = static_cast<std::size_t>(slot.key.value()) & mask;
+            while (m_slots[index].key.isValid())
+                index = (index + 1) & mask;
+            m_slots[index] = std::move(slot);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_size = 0;
+};
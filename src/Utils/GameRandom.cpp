@@ -0,0 +1,61 @@
+#include "GameRandom.h"
+#include <utility>
+
+GameRandom::GameRandom(std::uint64_t seed, std::uint64_t stream)
+    : m_state(0), m_increment(0)
+{
+    this->seed(seed, stream);
+}
+
+void GameRandom::seed(std::uint64_t seed, std::uint64_t stream)
+{
+    m_state = 0;
+    m_increment = (stream << 1u) | 1u;
+    next();
+    m_state += seed;
+    next();
+}
+
+std::uint32_t GameRandom::next()
+{
+    std::uint64_t oldState = m_state;
+    m_state = oldState * 6364136223846793005ULL + m_increment;
+    std::uint32_t xorShifted = static_cast<std::uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+    std::uint32_t rot = static_cast<std::uint32_t>(oldState >> 59u);
+    return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+}
+
+int GameRandom::nextInt(int min, int max)
+{
+    if (min > max)
+        std::swap(min, max);
+    if (min == max)
+        return min;
+    std::uint32_t range = static_cast<std::uint32_t>(max - min) + 1u;
+    return min + static_cast<int>(next() % range);
+}
+
+float GameRandom::nextFloat(float min, float max)
+{
+    if (min >= max)
+        return min;
+    // 取高 24 位, 保证结果严格小于 1
+    float unit = static_cast<float>(next() >> 8) / 16777216.f;
+    return min + (max - min) * unit;
+}
+
+Fixed GameRandom::nextFixed(Fixed min, Fixed max)
+{
+    if (min >= max)
+        return min;
+    // 取高 16 位作为 [0, 1) 的定点小数
+    std::int64_t range = static_cast<std::int64_t>(max.raw()) - min.raw();
+    std::int64_t offset = (range * static_cast<std::int64_t>(next() >> 16)) >> Fixed::FRACTION_BITS;
+    return Fixed::fromRaw(min.raw() + static_cast<std::int32_t>(offset));
+}
+
+void GameRandom::setState(std::uint64_t state, std::uint64_t increment)
+{
+    m_state = state;
+    m_increment = increment | 1u;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include "Fixed.h"
+
+// 可序列化的伪随机数发生器 (PCG32)。
+// 模拟逻辑中的随机都走它, 状态只有两个 64 位整数, 存档/回退时可以原样保存恢复。
+class GameRandom
+{
+public:
+    using result_type = std::uint32_t;
+
+    explicit GameRandom(std::uint64_t seed = 0x853c49e6748fea9bULL, std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    void seed(std::uint64_t seed, std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    std::uint32_t next();
+    // [min, max] 闭区间
+    int nextInt(int min, int max);
+    // [min, max) 半开区间
+    float nextFloat(float min, float max);
+    // [min, max) 半开区间, 纯整数运算, 模拟逻辑用它代替 nextFloat
+    Fixed nextFixed(Fixed min, Fixed max);
+
+    std::uint64_t getState() const { return m_state; }
+    std::uint64_t getIncrement() const { return m_increment; }
+    void setState(std::uint64_t state, std::uint64_t increment);
+
+    // 满足 UniformRandomBitGenerator; 但 std::shuffle / std::uniform_*_distribution 的结果随标准库实现而变,
+    // 模拟逻辑不要把它交给标准库算法, 只用上面的 next* 接口
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+    result_type operator()() { return next(); }
+
+private:
+    std::uint64_t m_state;
+    std::uint64_t m_increment;
+};
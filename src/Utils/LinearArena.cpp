@@ -0,0 +1,43 @@
+#include "LinearArena.h"
+#include <algorithm>
+
+LinearArena::LinearArena(std::size_t capacity, std::pmr::memory_resource *upstream)
+    : m_buffer(std::make_unique<std::byte[]>(capacity)),
+      m_capacity(capacity),
+      m_offset(0),
+      m_overflow(upstream),
+      m_overflowBytes(0),
+      m_peakBytes(0),
+      m_overflowCount(0)
+{
+}
+
+void LinearArena::reset()
+{
+    m_peakBytes = std::max(m_peakBytes, getUsedBytes());
+    m_offset = 0;
+    if (m_overflowBytes > 0)
+    {
+        m_overflow.release();
+        m_overflowBytes = 0;
+    }
+}
+
+void *LinearArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    // 按缓冲实际地址对齐, 不依赖缓冲本身的对齐
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    std::size_t end = static_cast<std::size_t>(aligned - base) + bytes;
+    if (end <= m_capacity)
+    {
+        m_offset = end;
+        m_peakBytes = std::max(m_peakBytes, getUsedBytes());
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    ++m_overflowCount;
+    m_overflowBytes += bytes;
+    m_peakBytes = std::max(m_peakBytes, getUsedBytes());
+    return m_overflow.allocate(bytes, alignment);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
+// 线性内存区: 预先分配一块定长缓冲, 分配只移动偏移, 单个释放是空操作, reset() 一次性回收全部
+// 缓冲用完后向上游申请溢出块, reset 时一并归还; 溢出说明容量偏小, 按峰值调整对应常量
+// 通过 std::pmr 接入容器; 不加锁, 同一时刻只能由一个线程使用
+class LinearArena : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(std::size_t capacity, std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+    // 之前分配出去的内存全部作废, 调用前必须确保没有对象还在使用它们
+    void reset();
+
+    std::size_t getCapacity() const { return m_capacity; }
+    // 自上次 reset 以来的用量 (含溢出)
+    std::size_t getUsedBytes() const { return m_offset + m_overflowBytes; }
+    std::size_t getPeakBytes() const { return m_peakBytes; }
+    // 累计溢出到上游的分配次数
+    std::uint64_t getOverflowCount() const { return m_overflowCount; }
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::unique_ptr<std::byte[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_offset;
+    std::pmr::monotonic_buffer_resource m_overflow;
+    std::size_t m_overflowBytes;
+    std::size_t m_peakBytes;
+    std::uint64_t m_overflowCount;
+};
+
+// 缓冲区分配在内存区上的字符串流, 用来拼每帧/每 tick 的临时文本
+// 结果用 view() 取出, 再 assign 到长期持有的字符串里 (容量够时不再分配)
+using ArenaStringStream = std::basic_ostringstream<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>;
@@ -0,0 +1,164 @@
+#include "MetricsRegistry.h"
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+
+MetricHistogram::MetricHistogram(std::vector<double> bounds)
+    : m_bounds(std::move(bounds)),
+      m_buckets(new std::atomic<std::uint64_t>[m_bounds.size() + 1])
+{
+    std::sort(m_bounds.begin(), m_bounds.end());
+    for (size_t i = 0; i <= m_bounds.size(); ++i)
+    {
+        m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value)
+{
+    // 桶数很少 (十来个), 线性查找比二分更快
+    size_t index = 0;
+    while (index < m_bounds.size() && value > m_bounds[index])
+    {
+        ++index;
+    }
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+
+    double sum = m_sum.load(std::memory_order_relaxed);
+    while (!m_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+    {
+    }
+}
+
+MetricsRegistry::Entry *MetricsRegistry::find(MetricKind kind, const std::string &name, const std::string &labels)
+{
+    for (Entry &entry : m_entries)
+    {
+        if (entry.kind == kind && entry.name == name && entry.labels == labels)
+            return &entry;
+    }
+    return nullptr;
+}
+
+MetricsRegistry::Entry &MetricsRegistry::add(MetricKind kind, const std::string &name, const std::string &help, const std::string &labels)
+{
+    m_entries.push_back(Entry{kind, name, help, labels, nullptr, nullptr, nullptr});
+    return m_entries.back();
+}
+
+MetricCounter &MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry *entry = find(MetricKind::COUNTER, name, labels);
+    if (!entry)
+    {
+        entry = &add(MetricKind::COUNTER, name, help, labels);
+        entry->counter = std::make_unique<MetricCounter>();
+    }
+    return *entry->counter;
+}
+
+MetricGauge &MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry *entry = find(MetricKind::GAUGE, name, labels);
+    if (!entry)
+    {
+        entry = &add(MetricKind::GAUGE, name, help, labels);
+        entry->gauge = std::make_unique<MetricGauge>();
+    }
+    return *entry->gauge;
+}
+
+MetricHistogram &MetricsRegistry::histogram(const std::string &name, const std::string &help,
+                                            const std::vector<double> &bounds, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry *entry = find(MetricKind::HISTOGRAM, name, labels);
+    if (!entry)
+    {
+        entry = &add(MetricKind::HISTOGRAM, name, help, labels);
+        entry->histogram = std::make_unique<MetricHistogram>(bounds);
+    }
+    return *entry->histogram;
+}
+
+namespace
+{
+    // name{labels} 或 name{labels,extra}
+    void writeSeries(std::ostringstream &out, const std::string &name, const std::string &labels, const std::string &extra)
+    {
+        out << name;
+        if (!labels.empty() || !extra.empty())
+        {
+            out << '{' << labels;
+            if (!labels.empty() && !extra.empty())
+                out << ',';
+            out << extra << '}';
+        }
+        out << ' ';
+    }
+}
+
+std::string MetricsRegistry::renderText() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ostringstream out;
+    out.precision(9);
+
+    // 同名指标 (不同标签) 共用一组 HELP/TYPE, 按首次注册的顺序输出
+    std::unordered_set<std::string> written;
+    for (const Entry &first : m_entries)
+    {
+        if (!written.insert(first.name).second)
+            continue;
+
+        const char *type = first.kind == MetricKind::COUNTER ? "counter" : (first.kind == MetricKind::GAUGE ? "gauge" : "histogram");
+        out << "# HELP " << first.name << ' ' << first.help << '\n';
+        out << "# TYPE " << first.name << ' ' << type << '\n';
+
+        for (const Entry &entry : m_entries)
+        {
+            if (entry.name != first.name || entry.kind != first.kind)
+                continue;
+            switch (entry.kind)
+            {
+            case MetricKind::COUNTER:
+                writeSeries(out, entry.name, entry.labels, "");
+                out << entry.counter->getValue() << '\n';
+                break;
+            case MetricKind::GAUGE:
+                writeSeries(out, entry.name, entry.labels, "");
+                out << entry.gauge->getValue() << '\n';
+                break;
+            case MetricKind::HISTOGRAM:
+            {
+                // 导出累计计数; 与记录并发时各桶可能差一两个样本, 可以接受
+                const MetricHistogram &histogram = *entry.histogram;
+                const std::vector<double> &bounds = histogram.getBounds();
+                std::uint64_t cumulative = 0;
+                for (size_t i = 0; i <= bounds.size(); ++i)
+                {
+                    cumulative += histogram.getBucketCount(i);
+                    std::ostringstream le;
+                    le.precision(9);
+                    le << "le=\"";
+                    if (i < bounds.size())
+                        le << bounds[i];
+                    else
+                        le << "+Inf";
+                    le << '"';
+                    writeSeries(out, entry.name + "_bucket", entry.labels, le.str());
+                    out << cumulative << '\n';
+                }
+                writeSeries(out, entry.name + "_sum", entry.labels, "");
+                out << histogram.getSum() << '\n';
+                writeSeries(out, entry.name + "_count", entry.labels, "");
+                out << cumulative << '\n';
+                break;
+            }
+            }
+        }
+    }
+    return out.str();
+}
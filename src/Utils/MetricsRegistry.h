@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 进程内指标: 计数器 / 仪表 / 直方图
+// 记录只做 relaxed 原子操作, 不加锁, 可在发布版常开; 注册和导出 (文本格式) 才需要加锁
+class MetricCounter
+{
+public:
+    void increment(std::uint64_t amount = 1) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+    std::uint64_t getValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> m_value{0};
+};
+
+class MetricGauge
+{
+public:
+    void set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    double getValue() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{0.0};
+};
+
+class MetricHistogram
+{
+public:
+    // bounds: 各桶上界, 升序; 最后隐含一个 +Inf 桶
+    explicit MetricHistogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    const std::vector<double> &getBounds() const { return m_bounds; }
+    // 第 i 个桶 (非累计) 的计数, i == bounds.size() 为 +Inf 桶
+    std::uint64_t getBucketCount(size_t index) const { return m_buckets[index].load(std::memory_order_relaxed); }
+    double getSum() const { return m_sum.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<double> m_bounds;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_buckets;
+    std::atomic<double> m_sum{0.0};
+};
+
+// 作用域计时: 析构时把经过的秒数记入直方图
+class ScopedMetricTimer
+{
+public:
+    explicit ScopedMetricTimer(MetricHistogram &histogram)
+        : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~ScopedMetricTimer()
+    {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+        m_histogram.observe(elapsed.count());
+    }
+
+    ScopedMetricTimer(const ScopedMetricTimer &) = delete;
+    ScopedMetricTimer &operator=(const ScopedMetricTimer &) = delete;
+
+private:
+    MetricHistogram &m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+class MetricsRegistry
+{
+public:
+    // 同名同标签重复注册返回同一个对象, 返回的引用在注册表生命周期内有效
+    // labels 为已格式化的标签串, 如 system="plants"
+    MetricCounter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+    MetricGauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+    MetricHistogram &histogram(const std::string &name, const std::string &help,
+                               const std::vector<double> &bounds, const std::string &labels = "");
+
+    // Prometheus 文本导出格式 (0.0.4)
+    std::string renderText() const;
+
+private:
+    enum class MetricKind
+    {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Entry
+    {
+        MetricKind kind;
+        std::string name;
+        std::string help;
+        std::string labels;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+    };
+
+    Entry *find(MetricKind kind, const std::string &name, const std::string &labels);
+    Entry &add(MetricKind kind, const std::string &name, const std::string &help, const std::string &labels);
+
+    mutable std::mutex m_mutex;
+    std::deque<Entry> m_entries;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+// 资源键: 名字在编译期做 FNV-1a 64 位哈希, 运行时查找只比较整数
+// 只能由字符串字面量构造 (consteval), 名字指向静态存储, 仅用于日志和注册时的冲突检查
+class ResourceId
+{
+public:
+    constexpr ResourceId() = default;
+    consteval explicit ResourceId(std::string_view name) : m_hash(hashBytes(name)), m_name(name) {}
+
+    constexpr std::uint64_t value() const { return m_hash; }
+    constexpr std::string_view name() const { return m_name; }
+    // 默认构造的键表示 "无资源"
+    constexpr bool isValid() const { return !m_name.empty(); }
+
+    constexpr bool operator==(const ResourceId &other) const { return m_hash == other.m_hash; }
+    constexpr auto operator<=>(const ResourceId &other) const { return m_hash <=> other.m_hash; }
+    // 哈希相同但名字不同: 两个键在表里会互相覆盖, 注册时必须拒绝
+    constexpr bool collidesWith(const ResourceId &other) const { return m_hash == other.m_hash && m_name != other.m_name; }
+
+    // FNV-1a 64; 资源管理器也用它给文件内容做去重哈希
+    static constexpr std::uint64_t hashBytes(std::string_view bytes)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char c : bytes)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+private:
+    std::uint64_t m_hash = 0;
+    std::string_view m_name;
+};
+
+inline std::ostream &operator<<(std::ostream &os, const ResourceId &id)
+{
+    return os << id.name();
+}
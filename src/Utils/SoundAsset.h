@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include "ResourceId.h"
+
+// 音效类别, 每类有独立的增益
+enum class SoundCategory : std::uint8_t
+{
+    SFX,
+    UI,
+    AMBIENT,
+    COUNT
+};
+
+// 注册音效时指定: 所属类别、同时播放上限、抢占优先级 (大的可以抢占小的)
+struct SoundClipConfig
+{
+    SoundCategory category = SoundCategory::SFX;
+    int maxVoices = 8;
+    int priority = 0;
+};
+
+// 预加载清单的一项: 各 GameState 用 constexpr 数组声明自己要用的音效
+struct SoundAsset
+{
+    ResourceId id;
+    const char *path;
+    SoundClipConfig config;
+};
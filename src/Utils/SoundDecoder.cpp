@@ -0,0 +1,93 @@
+#include "SoundDecoder.h"
+#include "AllocationCounter.h"
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <algorithm>
+#include <iostream>
+
+SoundDecoder::SoundDecoder(unsigned int workerCount) : m_stopping(false)
+{
+    for (unsigned int i = 0; i < std::max(1u, workerCount); ++i)
+    {
+        m_workers.emplace_back(&SoundDecoder::workerLoop, this);
+    }
+}
+
+SoundDecoder::~SoundDecoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void SoundDecoder::request(const SoundAsset &asset)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(asset);
+    }
+    m_condition.notify_one();
+}
+
+std::size_t SoundDecoder::collect(std::vector<Result> &out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t count = m_results.size();
+    for (Result &result : m_results)
+    {
+        out.push_back(std::move(result));
+    }
+    m_results.clear();
+    return count;
+}
+
+void SoundDecoder::workerLoop()
+{
+    // 解码线程上的分配 (文件读取、样本缓冲) 全部计入音频
+    AllocationScope allocationScope(AllocationTag::AUDIO);
+    while (true)
+    {
+        SoundAsset job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]
+                             { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping)
+                return;
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        // 解码不持锁
+        Result result{job.id, decodeFile(job.path, job.config)};
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.push_back(std::move(result));
+    }
+}
+
+std::unique_ptr<AudioClip> SoundDecoder::decodeFile(const std::string &path, const SoundClipConfig &config)
+{
+    sf::InputSoundFile file;
+    if (!file.openFromFile(path))
+    {
+        std::cerr << "SoundDecoder: Failed to open '" << path << "'" << std::endl;
+        return nullptr;
+    }
+    unsigned int channels = file.getChannelCount();
+    std::vector<sf::Int16> samples(static_cast<std::size_t>(file.getSampleCount()));
+    std::size_t read = static_cast<std::size_t>(file.read(samples.data(), samples.size()));
+    if (channels == 0 || read < channels)
+    {
+        std::cerr << "SoundDecoder: '" << path << "' contains no samples" << std::endl;
+        return nullptr;
+    }
+    return AudioMixer::createClip(samples.data(), read / channels, channels, file.getSampleRate(), config);
+}
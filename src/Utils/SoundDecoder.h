@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioMixer.h"
+#include "SoundAsset.h"
+
+// 后台解码音效文件: 工作线程读文件、转换成混音器格式, 结果由主线程取走登记
+// 解码出的片段直接以 unique_ptr 交出, 登记时不再复制样本
+class SoundDecoder
+{
+public:
+    struct Result
+    {
+        ResourceId id;
+        std::unique_ptr<AudioClip> clip; // 解码失败时为空
+    };
+
+    explicit SoundDecoder(unsigned int workerCount);
+    ~SoundDecoder();
+
+    SoundDecoder(const SoundDecoder &) = delete;
+    SoundDecoder &operator=(const SoundDecoder &) = delete;
+
+    void request(const SoundAsset &asset);
+    // 取走所有已完成的结果 (追加到 out), 返回取到的个数
+    std::size_t collect(std::vector<Result> &out);
+
+private:
+    void workerLoop();
+    static std::unique_ptr<AudioClip> decodeFile(const std::string &path, const SoundClipConfig &config);
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<SoundAsset> m_jobs;
+    std::vector<Result> m_results;
+    bool m_stopping;
+    std::vector<std::thread> m_workers;
+};
@@ -1,55 +1,64 @@
 #include "SoundManager.h"
+#include "AllocationCounter.h"
 #include <iostream>
 #include <algorithm>
 
-SoundManager::SoundManager() : m_globalVolume(70.f), m_currentPlayingMusicId("")
+SoundManager::SoundManager() : m_decoder(SOUND_DECODE_WORKER_COUNT), m_globalVolume(70.f)
 {
+    m_mixer.setMasterGain(m_globalVolume / 100.f);
+    m_mixer.play();
     std::cout << "SoundManager constructed." << std::endl;
 }
 
 SoundManager::~SoundManager()
 {
     stopMusic();
-    stopAllSounds();
+    m_mixer.stop();
     m_musicTracks.clear();
-    m_soundBuffers.clear();
-    m_playingSounds.clear();
+    m_soundClips.clear();
     std::cout << "SoundManager destructed." << std::endl;
 }
 
 // 背景音乐
-bool SoundManager::loadMusic(const std::string &id, const std::string &filename)
+bool SoundManager::loadMusic(ResourceId id, const std::string &filename)
 {
+    AllocationScope allocationScope(AllocationTag::AUDIO);
+    ResourceId existing;
+    if (m_musicTracks.collides(id, &existing))
+    {
+        std::cerr << "SoundManager Error: Music ID '" << id << "' collides with '" << existing << "'" << std::endl;
+        return false;
+    }
     auto music = std::make_unique<sf::Music>();
     if (!music->openFromFile(filename))
     {
         std::cerr << "SoundManager Error: Failed to load music '" << filename << "' with ID '" << id << "'" << std::endl;
         return false;
     }
-    m_musicTracks[id] = std::move(music);
-    m_musicBaseVolumes[id] = 50.f;
+    m_musicTracks.insertOrAssign(id, std::move(music));
+    m_musicBaseVolumes.insertOrAssign(id, 50.f);
     std::cout << "SoundManager: Loaded music '" << filename << "' as ID '" << id << "'" << std::endl;
     return true;
 }
 
-void SoundManager::playMusic(const std::string &id, bool loop, float basevolume)
+void SoundManager::playMusic(ResourceId id, bool loop, float basevolume)
 {
-    auto it = m_musicTracks.find(id);
-    if (it != m_musicTracks.end() && it->second)
+    std::unique_ptr<sf::Music> *track = m_musicTracks.find(id);
+    if (track && *track)
     {
         // 如果有其他音乐正在播放，先停止它
-        if (!m_currentPlayingMusicId.empty() && m_currentPlayingMusicId != id)
+        if (m_currentPlayingMusicId.isValid() && m_currentPlayingMusicId != id)
         {
-            auto oldTrackIt = m_musicTracks.find(m_currentPlayingMusicId);
-            if (oldTrackIt != m_musicTracks.end() && oldTrackIt->second)
+            std::unique_ptr<sf::Music> *oldTrack = m_musicTracks.find(m_currentPlayingMusicId);
+            if (oldTrack && *oldTrack)
             {
-                oldTrackIt->second->stop();
+                (*oldTrack)->stop();
             }
         }
-        m_musicBaseVolumes[id] = std::max(0.f, std::min(100.f, basevolume));
-        it->second->setLoop(loop);
-        it->second->setVolume(basevolume * (m_globalVolume / 100.f)); // 应用全局音量
-        it->second->play();
+        m_musicBaseVolumes.insertOrAssign(id, std::max(0.f, std::min(100.f, basevolume)));
+        (*track)->setLoop(loop);
+        (*track)->setVolume(basevolume * (m_globalVolume / 100.f)); // 应用全局音量
+        (*track)->play();
         m_currentPlayingMusicId = id;
         std::cout << "SoundManager: Playing music ID '" << id << "'" << std::endl;
     }
@@ -61,26 +70,26 @@ void SoundManager::playMusic(const std::string &id, bool loop, float basevolume)
 
 void SoundManager::stopMusic()
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it != m_musicTracks.end() && it->second)
+        std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track)
         {
-            it->second->stop();
+            (*track)->stop();
             std::cout << "SoundManager: Stopped music ID '" << m_currentPlayingMusicId << "'" << std::endl;
         }
-        m_currentPlayingMusicId = "";
+        m_currentPlayingMusicId = ResourceId();
     }
 }
 
 void SoundManager::pauseMusic()
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it != m_musicTracks.end() && it->second && it->second->getStatus() == sf::SoundSource::Playing)
+        std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track && (*track)->getStatus() == sf::SoundSource::Playing)
         {
-            it->second->pause();
+            (*track)->pause();
             std::cout << "SoundManager: Paused music ID '" << m_currentPlayingMusicId << "'" << std::endl;
         }
     }
@@ -88,12 +97,12 @@ void SoundManager::pauseMusic()
 
 void SoundManager::resumeMusic()
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it != m_musicTracks.end() && it->second && it->second->getStatus() == sf::SoundSource::Paused)
+        std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track && (*track)->getStatus() == sf::SoundSource::Paused)
         {
-            it->second->play();
+            (*track)->play();
             std::cout << "SoundManager: Resumed music ID '" << m_currentPlayingMusicId << "'" << std::endl;
         }
     }
@@ -101,26 +110,27 @@ void SoundManager::resumeMusic()
 
 void SoundManager::setMusicVolume(float baseVolume)
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it_track = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it_track != m_musicTracks.end() && it_track->second)
+        std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track)
         {
-            m_musicBaseVolumes[m_currentPlayingMusicId] = std::max(0.f, std::min(100.f, baseVolume));
-            it_track->second->setVolume(m_musicBaseVolumes[m_currentPlayingMusicId] * (m_globalVolume / 100.f));
-            std::cout << "SoundManager: Set base volume for '" << m_currentPlayingMusicId << "' to " << m_musicBaseVolumes[m_currentPlayingMusicId] << "%" << std::endl;
+            float clamped = std::max(0.f, std::min(100.f, baseVolume));
+            m_musicBaseVolumes.insertOrAssign(m_currentPlayingMusicId, clamped);
+            (*track)->setVolume(clamped * (m_globalVolume / 100.f));
+            std::cout << "SoundManager: Set base volume for '" << m_currentPlayingMusicId << "' to " << clamped << "%" << std::endl;
         }
     }
 }
 
 bool SoundManager::isMusicPlaying() const
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it != m_musicTracks.end() && it->second)
+        const std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track)
         {
-            return it->second->getStatus() == sf::SoundSource::Playing;
+            return (*track)->getStatus() == sf::SoundSource::Playing;
         }
     }
     return false;
@@ -128,81 +138,106 @@ bool SoundManager::isMusicPlaying() const
 
 sf::SoundSource::Status SoundManager::getMusicStatus() const
 {
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it = m_musicTracks.find(m_currentPlayingMusicId);
-        if (it != m_musicTracks.end() && it->second)
+        const std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        if (track && *track)
         {
-            return it->second->getStatus();
+            return (*track)->getStatus();
         }
     }
     return sf::SoundSource::Stopped;
 }
 
 // 音效
-bool SoundManager::loadSoundBuffer(const std::string &id, const std::string &filename)
+void SoundManager::preloadSounds(std::span<const SoundAsset> manifest)
 {
-    sf::SoundBuffer buffer;
-    if (!buffer.loadFromFile(filename))
+    AllocationScope allocationScope(AllocationTag::AUDIO);
+    for (const SoundAsset &asset : manifest)
     {
-        std::cerr << "SoundManager Error: Failed to load sound buffer '" << filename << "' with ID '" << id << "'" << std::endl;
-        return false;
+        ResourceId existing;
+        if (m_soundClips.collides(asset.id, &existing) || m_pendingSounds.collides(asset.id, &existing))
+        {
+            std::cerr << "SoundManager Error: Sound ID '" << asset.id << "' collides with '" << existing << "'" << std::endl;
+            continue;
+        }
+        // 已登记的片段可能正被声部引用, 不能替换
+        if (m_soundClips.contains(asset.id) || m_pendingSounds.contains(asset.id) || m_failedSounds.contains(asset.id))
+            continue;
+        m_pendingSounds.insertOrAssign(asset.id, true);
+        m_decoder.request(asset);
     }
-    m_soundBuffers[id] = buffer;
-    std::cout << "SoundManager: Loaded sound buffer '" << filename << "' as ID '" << id << "'" << std::endl;
-    return true;
 }
 
-void SoundManager::playSound(const std::string &id, float volume, float pitch, bool loop)
+void SoundManager::update()
+{
+    if (m_pendingSounds.empty())
+        return;
+    m_decodedSounds.clear();
+    AllocationScope allocationScope(AllocationTag::AUDIO);
+    if (m_decoder.collect(m_decodedSounds) == 0)
+        return;
+    for (SoundDecoder::Result &result : m_decodedSounds)
+    {
+        m_pendingSounds.erase(result.id);
+        if (!result.clip)
+        {
+            std::cerr << "SoundManager Error: Failed to decode sound '" << result.id << "', it will be skipped." << std::endl;
+            m_failedSounds.insertOrAssign(result.id, true);
+            continue;
+        }
+        std::cout << "SoundManager: Sound '" << result.id << "' ready (" << result.clip->frameCount << " frames)" << std::endl;
+        m_soundClips.insertOrAssign(result.id, std::move(result.clip));
+    }
+    m_decodedSounds.clear();
+}
+
+bool SoundManager::isSoundReady(ResourceId id) const
 {
-    // 清理已停止播放的音效
-    m_playingSounds.erase(
-        std::remove_if(m_playingSounds.begin(), m_playingSounds.end(),
-                       [](const sf::Sound &s)
-                       { return s.getStatus() == sf::SoundSource::Stopped; }),
-        m_playingSounds.end());
+    return m_soundClips.contains(id);
+}
 
-    auto it = m_soundBuffers.find(id);
-    if (it != m_soundBuffers.end())
+void SoundManager::playSound(ResourceId id, float volume, float pitch, bool loop)
+{
+    const std::unique_ptr<AudioClip> *clip = m_soundClips.find(id);
+    if (clip && *clip)
     {
-        m_playingSounds.emplace_back(it->second);
-        sf::Sound &sound = m_playingSounds.back();
-        sound.setVolume(volume * (m_globalVolume / 100.f));
-        sound.setPitch(pitch);
-        sound.setLoop(loop);
-        sound.play();
+        // 全局音量作为混音器的总增益, 这里只传本次的音量
+        m_mixer.playClip(**clip, volume / 100.f, pitch, loop);
     }
-    else
+    else if (!m_pendingSounds.contains(id) && !m_failedSounds.contains(id))
     {
-        std::cerr << "SoundManager Error: SoundBuffer ID '" << id << "' not found or not loaded." << std::endl;
+        std::cerr << "SoundManager Error: Sound ID '" << id << "' was never preloaded." << std::endl;
     }
 }
 
 void SoundManager::stopAllSounds()
 {
-    for (sf::Sound &sound : m_playingSounds)
-    {
-        sound.stop();
-    }
-    m_playingSounds.clear();
+    m_mixer.stopAll();
     std::cout << "SoundManager: All sounds stopped." << std::endl;
 }
 
+void SoundManager::setCategoryVolume(SoundCategory category, float volume)
+{
+    float clamped = std::max(0.f, std::min(100.f, volume));
+    m_mixer.setCategoryGain(category, clamped / 100.f);
+}
+
 void SoundManager::setGlobalVolume(float volume)
 {
     m_globalVolume = std::max(0.f, std::min(100.f, volume));
+    m_mixer.setMasterGain(m_globalVolume / 100.f);
     std::cout << "SoundManager: Global volume set to " << m_globalVolume << "%" << std::endl;
 
     // 更新当前正在播放的音乐的实际音量
-    if (!m_currentPlayingMusicId.empty())
+    if (m_currentPlayingMusicId.isValid())
     {
-        auto it_track = m_musicTracks.find(m_currentPlayingMusicId);
-        auto it_base_vol = m_musicBaseVolumes.find(m_currentPlayingMusicId);
+        std::unique_ptr<sf::Music> *track = m_musicTracks.find(m_currentPlayingMusicId);
+        const float *baseVolume = m_musicBaseVolumes.find(m_currentPlayingMusicId);
 
-        if (it_track != m_musicTracks.end() && it_track->second &&
-            it_base_vol != m_musicBaseVolumes.end())
+        if (track && *track && baseVolume)
         {
-            it_track->second->setVolume(it_base_vol->second * (m_globalVolume / 100.f));
+            (*track)->setVolume(*baseVolume * (m_globalVolume / 100.f));
             std::cout << "SoundManager: Updated currently playing music '" << m_currentPlayingMusicId
                       << "' volume based on new global volume." << std::endl;
         }
@@ -213,7 +248,7 @@ float SoundManager::getGlobalVolume() const
     return m_globalVolume;
 }
 
-const std::string &SoundManager::getCurrentPlayingMusicId() const
+ResourceId SoundManager::getCurrentPlayingMusicId() const
 {
     return m_currentPlayingMusicId;
 }
\ No newline at end of file
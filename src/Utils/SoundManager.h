@@ -1,8 +1,13 @@
 #pragma once
 #include <SFML/Audio.hpp>
 #include <string>
-#include <map>
 #include <memory>
+#include <vector>
+#include "FlatHashMap.h"
+#include "ResourceId.h"
+#include "AudioMixer.h"
+#include "SoundDecoder.h"
+#include <span>
 
 class SoundManager
 {
@@ -11,8 +16,8 @@ public:
     ~SoundManager();
 
     // 背景音乐
-    bool loadMusic(const std::string &id, const std::string &filename);
-    void playMusic(const std::string &id, bool loop = true, float volume = 50.f);
+    bool loadMusic(ResourceId id, const std::string &filename);
+    void playMusic(ResourceId id, bool loop = true, float volume = 50.f);
     void stopMusic();
     void pauseMusic();
     void resumeMusic();
@@ -20,24 +25,40 @@ public:
     bool isMusicPlaying() const;
     sf::SoundSource::Status getMusicStatus() const;
 
-    // 音效
-    bool loadSoundBuffer(const std::string &id, const std::string &filename);
-    void playSound(const std::string &id, float volume = 100.f, float pitch = 1.f, bool loop = false);
+    // 音效: 后台解码成混音器格式的片段, 由软件混音器播放; 以下都只能在主线程调用
+    // 预加载清单里未加载过的音效, 立即返回; 已登记或正在解码的跳过
+    void preloadSounds(std::span<const SoundAsset> manifest);
+    // 每帧调用一次: 登记后台解码完成的片段
+    void update();
+    bool isSoundReady(ResourceId id) const;
+    std::size_t getPendingSoundCount() const { return m_pendingSounds.size(); }
+    // 尚未解码完成的音效这次不播放, 不会阻塞等待
+    void playSound(ResourceId id, float volume = 100.f, float pitch = 1.f, bool loop = false);
     void stopAllSounds();
+    void setCategoryVolume(SoundCategory category, float volume);
+    const AudioMixer &getMixer() const { return m_mixer; }
 
     // 全局音量控制
     void setGlobalVolume(float volume);
     float getGlobalVolume() const;
 
-    const std::string &getCurrentPlayingMusicId() const;
+    // 没有音乐在播放时返回无效键
+    ResourceId getCurrentPlayingMusicId() const;
 
 private:
-    std::map<std::string, std::unique_ptr<sf::Music>> m_musicTracks;
-    std::map<std::string, float> m_musicBaseVolumes;
-    std::string m_currentPlayingMusicId;
+    FlatHashMap<std::unique_ptr<sf::Music>> m_musicTracks;
+    FlatHashMap<float> m_musicBaseVolumes;
+    ResourceId m_currentPlayingMusicId;
 
-    std::map<std::string, sf::SoundBuffer> m_soundBuffers;
-    std::vector<sf::Sound> m_playingSounds;
+    // 混音器的声部直接引用片段, 片段存 unique_ptr, 表扩容时地址不变
+    // m_mixer 声明在后, 先析构 (先停音频线程再释放片段)
+    SoundDecoder m_decoder;
+    FlatHashMap<bool> m_pendingSounds;
+    // 解码失败的音效 (文件缺失或格式不支持): 不再重复请求解码, 播放时静默跳过
+    FlatHashMap<bool> m_failedSounds;
+    std::vector<SoundDecoder::Result> m_decodedSounds; // update 的暂存区, 复用容量
+    FlatHashMap<std::unique_ptr<AudioClip>> m_soundClips;
+    AudioMixer m_mixer;
 
     float m_globalVolume;
 };
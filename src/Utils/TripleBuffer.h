@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// 无锁三缓冲: 写方在自己的缓冲里填好一份完整数据后 publish, 读方 fetch 取到最新发布的那份
+// 写方和读方各独占一个缓冲, 第三个缓冲用于交换; 两边都不会等待对方, 读方跟不上时中间的版本直接被覆盖
+template <typename T>
+class TripleBuffer
+{
+public:
+    // 写方: 当前可写的缓冲 (内容是之前某一版的旧数据, 需整体重写)
+    T &getWriteBuffer() { return m_buffers[m_writeIndex]; }
+
+    void publish()
+    {
+        std::uint8_t previous = m_middle.exchange(static_cast<std::uint8_t>(m_writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    // 读方: 有新发布的数据时换到它, 返回是否换了
+    bool fetch()
+    {
+        if (!(m_middle.load(std::memory_order_acquire) & FRESH_BIT))
+            return false;
+        std::uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T &getReadBuffer() const { return m_buffers[m_readIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+    T m_buffers[3];
+    std::uint8_t m_writeIndex = 0;
+    std::uint8_t m_readIndex = 1;
+    // 交换位的缓冲下标, FRESH_BIT 表示写方发布后读方还没取走
+    std::atomic<std::uint8_t> m_middle{2};
+};
@@ -1,12 +1,129 @@
 #include "Core/Game.h"
+#include "Network/SpectatorClient.h"
 #include <iostream>
+#include <string>
+#include <cstdlib>
 
-int main()
+int main(int argc, char *argv[])
 {
+    // --board 20x60 : 使用自定义棋盘尺寸 (大棋盘压力测试)
+    // --host PORT / --join ADDRESS:PORT : 双人合作锁步联机
+    // --net-delay TICKS --net-loss PERCENT --net-latency MS --net-jitter MS : 输入延迟和出站链路模拟
+    // --spectate-serve PORT [--spectate-rate HZ] : 广播观战流; --spectate ADDRESS:PORT : 观众模式
+    // --spectate-swarm ADDRESS:PORT COUNT : 无界面观众压力测试
+    // --metrics-port PORT : 在本机端口导出运行指标 (Prometheus 文本格式)
+    // --sim-seed N --tick-hash-log PATH [--sim-exit-tick N] [--sim-command-script PATH] : 固定种子并写出每隔若干 tick 的状态校验和, 用于比对不同构建的确定性
+    // --soak-waves N : 浸泡测试, 直接开局反复重开, 打满 N 波后检查内存是否回到开局基线 (不通过时退出码 2)
+    BoardConfig boardConfig = BoardConfig::standard();
+    LockstepConfig lockstepConfig;
+    SpectatorConfig spectatorConfig;
+    unsigned short metricsPort = 0;
+    SimulationConfig simulationConfig;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--board" && i + 1 < argc)
+        {
+            if (!BoardConfig::parse(argv[++i], boardConfig))
+            {
+                std::cerr << "Invalid --board value '" << argv[i] << "', expected ROWSxCOLS (cols <= 64). Using default board." << std::endl;
+                boardConfig = BoardConfig::standard();
+            }
+        }
+        else if (arg == "--host" && i + 1 < argc)
+        {
+            lockstepConfig.role = LockstepRole::HOST;
+            lockstepConfig.localPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--join" && i + 1 < argc)
+        {
+            std::string target = argv[++i];
+            std::string::size_type colon = target.rfind(':');
+            if (colon == std::string::npos)
+            {
+                std::cerr << "Invalid --join value '" << target << "', expected ADDRESS:PORT." << std::endl;
+                continue;
+            }
+            lockstepConfig.role = LockstepRole::CLIENT;
+            lockstepConfig.remoteAddress = sf::IpAddress(target.substr(0, colon));
+            lockstepConfig.remotePort = static_cast<unsigned short>(std::atoi(target.c_str() + colon + 1));
+        }
+        else if (arg == "--net-delay" && i + 1 < argc)
+        {
+            lockstepConfig.inputDelayTicks = std::atoi(argv[++i]);
+        }
+        else if (arg == "--net-loss" && i + 1 < argc)
+        {
+            lockstepConfig.simulatedLossPercent = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--net-latency" && i + 1 < argc)
+        {
+            lockstepConfig.simulatedLatencyMs = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--net-jitter" && i + 1 < argc)
+        {
+            lockstepConfig.simulatedJitterMs = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (arg == "--spectate-serve" && i + 1 < argc)
+        {
+            spectatorConfig.serverPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--metrics-port" && i + 1 < argc)
+        {
+            metricsPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (arg == "--sim-seed" && i + 1 < argc)
+        {
+            simulationConfig.hasFixedSeed = true;
+            simulationConfig.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--tick-hash-log" && i + 1 < argc)
+        {
+            simulationConfig.tickHashLogPath = argv[++i];
+        }
+        else if (arg == "--sim-exit-tick" && i + 1 < argc)
+        {
+            simulationConfig.exitTick = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--sim-command-script" && i + 1 < argc)
+        {
+            simulationConfig.commandScriptPath = argv[++i];
+        }
+        else if (arg == "--soak-waves" && i + 1 < argc)
+        {
+            simulationConfig.soakWaves = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--spectate-rate" && i + 1 < argc)
+        {
+            spectatorConfig.broadcastRateHz = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if ((arg == "--spectate" || arg == "--spectate-swarm") && i + 1 < argc)
+        {
+            std::string target = argv[++i];
+            std::string::size_type colon = target.rfind(':');
+            if (colon == std::string::npos)
+            {
+                std::cerr << "Invalid " << arg << " value '" << target << "', expected ADDRESS:PORT." << std::endl;
+                continue;
+            }
+            sf::IpAddress address(target.substr(0, colon));
+            unsigned short port = static_cast<unsigned short>(std::atoi(target.c_str() + colon + 1));
+            if (arg == "--spectate-swarm")
+            {
+                int viewers = (i + 1 < argc) ? std::atoi(argv[++i]) : 0;
+                return SpectatorClient::runHeadlessSwarm(address, port, viewers > 0 ? viewers : 1);
+            }
+            spectatorConfig.viewAddress = address;
+            spectatorConfig.viewPort = port;
+        }
+    }
+
+    int exitCode = 0;
     try
     {
-        Game game;
+        Game game(boardConfig, lockstepConfig, spectatorConfig, metricsPort, simulationConfig);
         game.run();
+        exitCode = game.getExitCode();
     }
     catch (const std::exception &e)
     {
@@ -18,5 +135,5 @@ int main()
         std::cerr << "Unknown exception caught in main." << std::endl;
         return 1;
     }
-    return 0;
+    return exitCode;
 }